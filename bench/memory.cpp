@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Reports the memory used to hold many parsed
+// urls, and the time taken to parse them. Build
+// with different values of BOOST_URL_OFFSET_BITS
+// to compare the layouts.
+
+#include <boost/url.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace urls = boost::urls;
+
+namespace {
+
+std::vector<std::string>
+make_corpus(std::size_t n)
+{
+    static char const* const hosts[] = {
+        "www.example.com",
+        "api.example.org:8080",
+        "user:pass@cdn.example.net",
+        "192.168.0.1",
+        "[2001:db8::1]:443" };
+    std::vector<std::string> v;
+    v.reserve(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        std::string s = "https://";
+        s += hosts[i % 5];
+        s += "/path/to/resource/";
+        s += std::to_string(i);
+        if(i % 2)
+        {
+            s += "?id=";
+            s += std::to_string(i);
+            s += "&page=2&sort=asc";
+        }
+        if(i % 3 == 0)
+            s += "#section";
+        v.push_back(std::move(s));
+    }
+    return v;
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    std::size_t n = 1000000;
+    if(argc > 1)
+        n = std::strtoul(argv[1], nullptr, 10);
+
+    auto const corpus = make_corpus(n);
+    std::size_t chars = 0;
+    for(auto const& s : corpus)
+        chars += s.size();
+
+    using clock_type =
+        std::chrono::steady_clock;
+
+    // views
+    std::vector<urls::url_view> views;
+    views.reserve(n);
+    auto t0 = clock_type::now();
+    for(auto const& s : corpus)
+        views.push_back(
+            urls::parse_uri(s).value());
+    auto t1 = clock_type::now();
+
+    // owning urls
+    std::vector<urls::url> owned;
+    owned.reserve(n);
+    auto t2 = clock_type::now();
+    for(auto const& v : views)
+        owned.emplace_back(v);
+    auto t3 = clock_type::now();
+
+    auto const ms = [](
+        clock_type::duration d)
+    {
+        return std::chrono::duration_cast<
+            std::chrono::milliseconds>(
+                d).count();
+    };
+
+    std::cout <<
+        "offset type:       " <<
+            sizeof(pos_t) * 8 << " bits\n"
+        "max_size():        " <<
+            urls::url_view::max_size() << "\n"
+        "sizeof(url_view):  " <<
+            sizeof(urls::url_view) << "\n"
+        "sizeof(url):       " <<
+            sizeof(urls::url) << "\n"
+        "urls:              " << n << "\n"
+        "chars:             " << chars << "\n"
+        "url_view storage:  " <<
+            n * sizeof(urls::url_view) << " bytes\n"
+        "url storage:       " <<
+            n * sizeof(urls::url) + chars + n <<
+            " bytes (excluding allocator overhead)\n"
+        "parse url_view:    " <<
+            ms(t1 - t0) << " ms\n"
+        "copy to url:       " <<
+            ms(t3 - t2) << " ms\n";
+    return 0;
+}
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Reports the time taken to parse a corpus of
+// newline-delimited urls with 1 to N threads.
+
+#include <boost/url.hpp>
+#include <boost/url/parallel_parse.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace urls = boost::urls;
+
+namespace {
+
+std::string
+make_corpus(std::size_t n)
+{
+    static char const* const hosts[] = {
+        "www.example.com",
+        "api.example.org:8080",
+        "user:pass@cdn.example.net",
+        "192.168.0.1",
+        "[2001:db8::1]:443" };
+    std::string s;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        s += "https://";
+        s += hosts[i % 5];
+        s += "/path/to/resource/";
+        s += std::to_string(i);
+        if(i % 2)
+        {
+            s += "?id=";
+            s += std::to_string(i);
+            s += "&page=2&sort=asc";
+        }
+        if(i % 3 == 0)
+            s += "#section";
+        s += "\n";
+    }
+    return s;
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    std::size_t n = 4000000;
+    if(argc > 1)
+        n = std::strtoul(argv[1], nullptr, 10);
+    std::size_t max_threads =
+        std::thread::hardware_concurrency();
+    if(argc > 2)
+        max_threads = std::strtoul(
+            argv[2], nullptr, 10);
+    if(max_threads == 0)
+        max_threads = 1;
+
+    auto const corpus = make_corpus(n);
+    std::cout <<
+        "urls:  " << n << "\n"
+        "bytes: " << corpus.size() << "\n";
+
+    using clock_type =
+        std::chrono::steady_clock;
+    // powers of two, then the maximum
+    std::vector<std::size_t> counts;
+    for(std::size_t t = 1; t < max_threads; t *= 2)
+        counts.push_back(t);
+    counts.push_back(max_threads);
+
+    double base = 0;
+    for(auto const t : counts)
+    {
+        auto const t0 = clock_type::now();
+        auto const v = urls::
+            parallel_parse_uri_reference_lines(
+                corpus, t);
+        auto const t1 = clock_type::now();
+        double const ms =
+            std::chrono::duration<double,
+                std::milli>(t1 - t0).count();
+        if(t == 1)
+            base = ms;
+        std::cout <<
+            "threads: " << t <<
+            "\ttime: " << ms << " ms" <<
+            "\tMB/s: " << corpus.size() / ms / 1000 <<
+            "\tspeedup: " << base / ms << "\n";
+        if(v.size() != n)
+            return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
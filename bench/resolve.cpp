@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Reports the throughput of resolving the
+// links of one page against its base, with
+// a call to resolve for each link, and with
+// a resolver writing to containers or views.
+
+#include <boost/url.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace urls = boost::urls;
+
+namespace {
+
+std::vector<std::string>
+make_corpus(std::size_t n)
+{
+    static char const* const prefixes[] = {
+        "../images/photo",
+        "/static/css/site.css?v=",
+        "page",
+        "./docs/../guide/chapter",
+        "?page=",
+        "#section-",
+        "//cdn.example.net/assets/app.js?v=",
+        "https://other.example.org/path/",
+        };
+    std::vector<std::string> v;
+    v.reserve(n);
+    for(std::size_t i = 0; i < n; ++i)
+        v.push_back(
+            prefixes[i % 8] +
+            std::to_string(i));
+    return v;
+}
+
+template<class F>
+double
+run(
+    char const* name,
+    std::size_t n,
+    F const& f)
+{
+    using clock_type =
+        std::chrono::steady_clock;
+    auto const t0 = clock_type::now();
+    std::size_t const total = f();
+    auto const t1 = clock_type::now();
+    double const ms =
+        std::chrono::duration<double,
+            std::milli>(t1 - t0).count();
+    std::cout << name <<
+        "\ttime: " << ms << " ms" <<
+        "\tns/url: " << ms * 1e6 / n <<
+        "\tMB/s: " << total / ms / 1000 << "\n";
+    return ms;
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    std::size_t n = 1000000;
+    if(argc > 1)
+        n = std::strtoul(argv[1], nullptr, 10);
+
+    // links are resolved in batches,
+    // as a crawler would for each page
+    std::size_t const batch = 256;
+
+    auto const corpus = make_corpus(n);
+    std::vector<urls::url_view> refs;
+    refs.reserve(n);
+    for(auto const& s : corpus)
+        refs.push_back(urls::parse_uri_reference(
+            s).value());
+    urls::url_view const base(
+        "https://www.example.com/articles/2022/index.htm?lang=en");
+    urls::resolver r(base);
+
+    std::cout << "urls: " << n << "\n";
+    for(int i = 0; i < 3; ++i)
+    {
+        std::vector<urls::url> dest(batch);
+        auto const ms0 = run("resolve  ", n,
+            [&]
+            {
+                std::size_t total = 0;
+                urls::error_code ec;
+                for(std::size_t j = 0; j < n; ++j)
+                {
+                    auto& u = dest[j % batch];
+                    urls::resolve(base, refs[j], u, ec);
+                    if(ec.failed())
+                        std::exit(EXIT_FAILURE);
+                    total += u.size();
+                }
+                return total;
+            });
+        auto const ms1 = run("resolver ", n,
+            [&]
+            {
+                std::size_t total = 0;
+                for(std::size_t j = 0; j < n; j += batch)
+                {
+                    auto const m = (std::min)(batch, n - j);
+                    r.resolve(&refs[j], dest.data(), m);
+                    for(std::size_t k = 0; k < m; ++k)
+                        total += dest[k].size();
+                }
+                return total;
+            });
+        std::vector<urls::url_view> views(batch);
+        auto const ms2 = run("views    ", n,
+            [&]
+            {
+                std::size_t total = 0;
+                for(std::size_t j = 0; j < n; j += batch)
+                {
+                    auto const m = (std::min)(batch, n - j);
+                    r.resolve(&refs[j], views.data(), m);
+                    for(std::size_t k = 0; k < m; ++k)
+                        total += views[k].size();
+                }
+                return total;
+            });
+        std::cout <<
+            "speedup: " << ms0 / ms1 <<
+            " (containers), " << ms0 / ms2 <<
+            " (views)\n";
+    }
+    return EXIT_SUCCESS;
+}
@@ -21,20 +21,25 @@
 #include <boost/url/params.hpp>
 #include <boost/url/params_encoded.hpp>
 #include <boost/url/params_encoded_view.hpp>
+#include <boost/url/params_index.hpp>
 #include <boost/url/params_view.hpp>
 #include <boost/url/pct_encoding.hpp>
 #include <boost/url/pct_encoded_view.hpp>
 #include <boost/url/query_param.hpp>
 #include <boost/url/recycled_ptr.hpp>
+#include <boost/url/resolver.hpp>
+#include <boost/url/router.hpp>
 #include <boost/url/scheme.hpp>
 #include <boost/url/segments.hpp>
 #include <boost/url/segments_encoded.hpp>
 #include <boost/url/segments_encoded_view.hpp>
 #include <boost/url/segments_view.hpp>
 #include <boost/url/static_url.hpp>
+#include <boost/url/stream_parser.hpp>
 #include <boost/url/string_view.hpp>
 #include <boost/url/url.hpp>
 #include <boost/url/url_base.hpp>
+#include <boost/url/url_builder.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/url/url_view_base.hpp>
 #include <boost/url/urls.hpp>
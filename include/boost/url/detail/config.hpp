@@ -51,6 +51,38 @@
 # endif
 #endif
 
+#if ! defined(BOOST_URL_NO_SSSE3) && \
+    ! defined(BOOST_URL_USE_SSSE3)
+# if defined(BOOST_URL_USE_SSE2) && ( \
+      defined(__SSSE3__) || defined(__AVX__))
+#  define BOOST_URL_USE_SSSE3
+# endif
+#endif
+
+#if ! defined(BOOST_URL_NO_AVX2) && \
+    ! defined(BOOST_URL_USE_AVX2)
+# if defined(BOOST_URL_USE_SSSE3) && \
+      defined(__AVX2__)
+#  define BOOST_URL_USE_AVX2
+# endif
+#endif
+
+// Unless the target has AVX2, the SSSE3 and
+// AVX2 kernels are also compiled on their
+// own, and chosen at run time from what
+// the CPU supports
+#if ! defined(BOOST_URL_NO_SIMD_DISPATCH) && \
+    ! defined(BOOST_URL_USE_SIMD_DISPATCH)
+# if defined(BOOST_URL_USE_SSE2) && \
+    ! defined(BOOST_URL_USE_AVX2) && \
+    ! defined(BOOST_URL_NO_SSSE3) && ( \
+      defined(__clang__) || \
+      BOOST_GCC_VERSION >= 40900 || \
+      defined(_MSC_VER))
+#  define BOOST_URL_USE_SIMD_DISPATCH
+# endif
+#endif
+
 #if BOOST_WORKAROUND( BOOST_GCC_VERSION, <= 72000 ) || \
     BOOST_WORKAROUND( BOOST_CLANG_VERSION, <= 35000 )
 # define BOOST_URL_CONSTEXPR
@@ -83,7 +115,23 @@
 #define BOOST_URL_RETURN(x) return (x)
 #endif
 
+// Offsets and sizes of the parts of a url
+// are stored as pos_t. Defining
+// BOOST_URL_OFFSET_BITS to 32 or 16 selects
+// a smaller type, which makes every url and
+// url_view smaller in exchange for a lower
+// max_size(). It must be defined the same way
+// for the library and for every program
+// which uses it, see detail/link_check.hpp.
+#if ! defined(BOOST_URL_OFFSET_BITS)
 using pos_t = size_t;
+#elif BOOST_URL_OFFSET_BITS == 32
+using pos_t = uint32_t;
+#elif BOOST_URL_OFFSET_BITS == 16
+using pos_t = uint16_t;
+#else
+# error BOOST_URL_OFFSET_BITS must be 16 or 32
+#endif
 
 #ifndef BOOST_URL_MAX_SIZE
 // we leave room for a null,
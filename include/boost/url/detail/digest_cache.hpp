@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_DIGEST_CACHE_HPP
+#define BOOST_URL_DETAIL_DIGEST_CACHE_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <atomic>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// The digest of a url for one salt,
+// computed on first use.
+//
+// The digest is taken over the normalized
+// url, so normalizing does not change it.
+// Anything else which changes the url
+// must invalidate the cache.
+//
+// The cache is filled from const members,
+// which may be called from several threads
+// at once. The first thread to claim the
+// cache writes it, and it is only read once
+// it is marked valid. Invalidating happens
+// in non-const members, which are never
+// concurrent with anything.
+class digest_cache
+{
+    enum : unsigned char
+    {
+        empty = 0,
+        busy,
+        valid
+    };
+
+    std::atomic<unsigned char> state_{empty};
+    std::size_t salt_ = 0;
+    std::size_t value_ = 0;
+
+    bool
+    ready() const noexcept
+    {
+        return state_.load(
+            std::memory_order_acquire) == valid;
+    }
+
+public:
+    digest_cache() = default;
+
+    digest_cache(
+        digest_cache const& other) noexcept
+    {
+        *this = other;
+    }
+
+    digest_cache&
+    operator=(
+        digest_cache const& other) noexcept
+    {
+        if(! other.ready())
+        {
+            invalidate();
+            return *this;
+        }
+        salt_ = other.salt_;
+        value_ = other.value_;
+        state_.store(valid,
+            std::memory_order_release);
+        return *this;
+    }
+
+    void
+    invalidate() noexcept
+    {
+        state_.store(empty,
+            std::memory_order_relaxed);
+    }
+
+    // return true and set v if the
+    // digest for salt is known
+    bool
+    get(
+        std::size_t salt,
+        std::size_t& v) const noexcept
+    {
+        if( ! ready() ||
+            salt_ != salt)
+            return false;
+        v = value_;
+        return true;
+    }
+
+    // does nothing if the cache was
+    // already claimed, which keeps the
+    // digest for the first salt used
+    void
+    set(
+        std::size_t salt,
+        std::size_t v) noexcept
+    {
+        unsigned char expected = empty;
+        if(! state_.compare_exchange_strong(
+                expected, busy,
+                std::memory_order_acquire,
+                std::memory_order_relaxed))
+            return;
+        salt_ = salt;
+        value_ = v;
+        state_.store(valid,
+            std::memory_order_release);
+    }
+
+    // return true if both digests are
+    // known for the same salt and differ,
+    // in which case the urls are not equal
+    bool
+    mismatch(
+        digest_cache const& other) const noexcept
+    {
+        return
+            ready() &&
+            other.ready() &&
+            salt_ == other.salt_ &&
+            value_ != other.value_;
+    }
+};
+
+} // detail
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,29 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_IMPL_LINK_CHECK_IPP
+#define BOOST_URL_DETAIL_IMPL_LINK_CHECK_IPP
+
+#include <boost/url/detail/link_check.hpp>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// Instantiated only for the values this
+// translation unit refers to, which are
+// those the library is built with
+template<class Setting, std::size_t Value>
+int const link_check<Setting, Value>::value = 0;
+
+} // detail
+} // urls
+} // boost
+
+#endif
@@ -12,7 +12,11 @@
 #define BOOST_URL_DETAIL_IMPL_NORMALIZE_IPP
 
 #include <boost/url/detail/normalize.hpp>
+#include <boost/url/detail/pct_scan.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/detail/ci_string.hpp>
 #include <boost/assert.hpp>
+#include <algorithm>
 #include <cstring>
 
 namespace boost {
@@ -73,14 +77,22 @@ compare_encoded(
 void
 digest_encoded(
     string_view s,
-    fnv_1a& hasher) noexcept
+    block_hasher& hasher) noexcept
 {
-    char c = 0;
-    std::size_t n = 0;
-    while(!s.empty())
+    // runs without escapes are
+    // hashed as they are
+    auto it = s.data();
+    auto const end = it + s.size();
+    for(;;)
     {
-        pop_encoded_front(s, c, n);
-        hasher.put(c);
+        auto const p = find_pct(it, end);
+        hasher.put(string_view(it, p - it));
+        if(p == end)
+            return;
+        if(end - p < 3)
+            return;
+        hasher.put(decode_hex_unchecked(p + 1));
+        it = p + 3;
     }
 }
 
@@ -115,18 +127,44 @@ ci_compare_encoded(
     return 1;
 }
 
+// hash the lowercase chars of s
+static
+void
+ci_digest_run(
+    string_view s,
+    block_hasher& hasher) noexcept
+{
+    char buf[64];
+    while(! s.empty())
+    {
+        auto const n = (std::min)(
+            s.size(), sizeof(buf));
+        grammar::detail::ci_fold(
+            buf, s.data(), n);
+        hasher.put(string_view(buf, n));
+        s.remove_prefix(n);
+    }
+}
+
 void
 ci_digest_encoded(
     string_view s,
-    fnv_1a& hasher) noexcept
+    block_hasher& hasher) noexcept
 {
-    char c = 0;
-    std::size_t n = 0;
-    while(!s.empty())
+    auto it = s.data();
+    auto const end = it + s.size();
+    for(;;)
     {
-        pop_encoded_front(s, c, n);
-        c = grammar::to_lower(c);
-        hasher.put(c);
+        auto const p = find_pct(it, end);
+        ci_digest_run(
+            string_view(it, p - it), hasher);
+        if(p == end)
+            return;
+        if(end - p < 3)
+            return;
+        hasher.put(grammar::to_lower(
+            decode_hex_unchecked(p + 1)));
+        it = p + 3;
     }
 }
 
@@ -157,33 +195,15 @@ ci_compare(
     string_view lhs,
     string_view rhs) noexcept
 {
-    auto rlen = (std::min)(lhs.size(), rhs.size());
-    for (std::size_t i = 0; i < rlen; ++i)
-    {
-        char c0 = grammar::to_lower(lhs[i]);
-        char c1 = grammar::to_lower(rhs[i]);
-        if (c0 < c1)
-            return -1;
-        if (c1 < c0)
-            return 1;
-    }
-    if ( lhs.size() == rhs.size() )
-        return 0;
-    if ( lhs.size() < rhs.size() )
-        return -1;
-    return 1;
+    return grammar::ci_compare(lhs, rhs);
 }
 
 void
 ci_digest(
     string_view s,
-    fnv_1a& hasher) noexcept
+    block_hasher& hasher) noexcept
 {
-    for (char c: s)
-    {
-        c = grammar::to_lower(c);
-        hasher.put(c);
-    }
+    ci_digest_run(s, hasher);
 }
 
 std::size_t
@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2022 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_IMPL_OFFSET_TABLE_IPP
+#define BOOST_URL_DETAIL_IMPL_OFFSET_TABLE_IPP
+
+#include <boost/url/detail/offset_table.hpp>
+#include <cstring>
+#include <new>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+offset_table::
+~offset_table()
+{
+    delete[] v_;
+}
+
+bool
+offset_table::
+reserve(std::size_t n) noexcept
+{
+    if(n <= cap_)
+        return true;
+    if(! enabled_)
+        return false;
+    // 50% growth policy
+    auto new_cap = cap_ + cap_ / 2;
+    if(new_cap < n)
+        new_cap = n;
+    auto v = new(std::nothrow)
+        pos_t[new_cap];
+    if(! v)
+        return false;
+    if(n_ > 0)
+        std::memcpy(v, v_,
+            n_ * sizeof(pos_t));
+    delete[] v_;
+    v_ = v;
+    cap_ = new_cap;
+    return true;
+}
+
+void
+offset_table::
+build(
+    std::size_t n,
+    string_view s,
+    std::size_t pos,
+    char sep) noexcept
+{
+    valid_ = false;
+    n_ = 0;
+    if(! reserve(n + 1))
+        return;
+    n_ = n + 1;
+    v_[0] = 0;
+    for(std::size_t i = 1;
+        i < n; ++i)
+    {
+        pos = s.find(sep, pos);
+        BOOST_ASSERT(
+            pos != string_view::npos);
+        v_[i] = pos;
+        ++pos;
+    }
+    v_[n] = s.size();
+    validate(s.size());
+}
+
+void
+offset_table::
+update(
+    std::size_t i0,
+    std::size_t i1,
+    std::size_t n,
+    string_view s,
+    std::size_t pos,
+    char sep) noexcept
+{
+    BOOST_ASSERT(valid_);
+    BOOST_ASSERT(i0 > 0);
+    BOOST_ASSERT(i0 <= i1);
+    BOOST_ASSERT(i1 <= n_);
+    valid_ = false;
+    auto const n1 =
+        n_ - (i1 - i0) + n;
+    if(! reserve(n1))
+        return;
+    if(i1 < n_)
+        std::memmove(
+            v_ + i0 + n,
+            v_ + i1,
+            (n_ - i1) * sizeof(pos_t));
+    n_ = n1;
+    auto const i2 = i0 + n;
+    for(auto i = i0; i < i2; ++i)
+    {
+        if(i == n_ - 1)
+        {
+            v_[i] = s.size();
+            break;
+        }
+        pos = s.find(sep, pos);
+        BOOST_ASSERT(
+            pos != string_view::npos);
+        v_[i] = pos;
+        ++pos;
+    }
+    auto const d = s.size() - len_;
+    for(auto i = i2; i < n_; ++i)
+        v_[i] += d;
+    validate(s.size());
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
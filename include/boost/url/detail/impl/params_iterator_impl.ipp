@@ -82,6 +82,21 @@ params_iterator_impl(
 {
 }
 
+params_iterator_impl::
+params_iterator_impl(
+    string_view s,
+    std::size_t i,
+    std::size_t pos) noexcept
+    : begin_(s.data())
+    , end_(s.data() + s.size())
+    , pos_(s.data() + pos)
+    , i_(i)
+{
+    BOOST_ASSERT(i > 0);
+    BOOST_ASSERT(*pos_ == '&');
+    scan();
+}
+
 params_view::reference
 params_iterator_impl::
 dereference() const noexcept
@@ -129,10 +144,12 @@ encoded_key() const noexcept
 {
     BOOST_ASSERT(begin_ != nullptr);
     BOOST_ASSERT(end_ != nullptr);
-    BOOST_ASSERT(pos_ != end_);
+    // an empty query has one empty param
+    BOOST_ASSERT(
+        pos_ != end_ || i_ == 0);
     BOOST_ASSERT(pos_ != nullptr);
 
-    if(pos_ != begin_)
+    if(pos_ != begin_ || i_ != 0)
         return string_view(
             pos_ + 1, nk_ - 1);
     return string_view{ pos_, nk_ };
@@ -10,6 +10,8 @@
 #ifndef BOOST_URL_DETAIL_IMPL_RECYCLER_IPP
 #define BOOST_URL_DETAIL_IMPL_RECYCLER_IPP
 
+#include <boost/url/detail/recycler.hpp>
+#include <atomic>
 #include <mutex>
 #include <utility>
 
@@ -42,6 +44,20 @@ struct all_reports
     // largest single allocation
     std::size_t alloc_max = 0;
 
+    // acquisitions from a thread's cache
+    std::atomic<std::size_t> local_hits{0};
+
+    // acquisitions from the shared list
+    std::atomic<std::size_t> shared_hits{0};
+
+    // acquisitions with nothing to recycle,
+    // the hit rate is hits / (hits + misses)
+    std::atomic<std::size_t> misses{0};
+
+    // failed compare-and-swaps on the
+    // shared list, a measure of contention
+    std::atomic<std::size_t> retries{0};
+
     ~all_reports()
     {
         // breakpoint here to view report
@@ -88,6 +104,32 @@ recycler_remove_impl(
     all_reports_.bytes-=n;
 }
 
+void
+recycler_hit_impl(
+    bool shared) noexcept
+{
+    if(shared)
+        all_reports_.shared_hits.fetch_add(
+            1, std::memory_order_relaxed);
+    else
+        all_reports_.local_hits.fetch_add(
+            1, std::memory_order_relaxed);
+}
+
+void
+recycler_miss_impl() noexcept
+{
+    all_reports_.misses.fetch_add(
+        1, std::memory_order_relaxed);
+}
+
+void
+recycler_retry_impl() noexcept
+{
+    all_reports_.retries.fetch_add(
+        1, std::memory_order_relaxed);
+}
+
 } // detail
 } // urls
 } // boost
@@ -29,13 +29,16 @@ remove_dot_segments(
     // the now-appended path components and the
     // output buffer is initialized to the empty
     // string.
+    //
+    // The output may be written over the
+    // input, which it never overtakes.
     char* dest = dest0;
     auto append =
         [&dest, &end]
         (string_view in)
     {
         BOOST_ASSERT(in.size() <= std::size_t(end - dest));
-        std::memcpy(dest, in.data(), in.size());
+        std::memmove(dest, in.data(), in.size());
         dest += in.size();
         (void)end;
     };
@@ -54,6 +57,19 @@ remove_dot_segments(
         return string_view::npos;
     };
 
+    // ".." segments which were kept because
+    // they had nothing to remove are never
+    // removed by a later ".."
+    auto ends_in_dotdot =
+        [&dest0, &dest](std::size_t p)
+    {
+        return
+            dest - dest0 == static_cast<
+                std::ptrdiff_t>(p + 3) &&
+            dest[-1] == '.' &&
+            dest[-2] == '.';
+    };
+
     // Step 2 is a loop through 5 production rules
     // There are no transitions between all rules,
     // which enables some optimizations.
@@ -74,7 +90,11 @@ remove_dot_segments(
             s.remove_prefix(3);
             continue;
         }
-        if (!s.starts_with("./"))
+        // "./" is kept before an empty
+        // segment, or the path would
+        // become absolute
+        if (!s.starts_with("./") ||
+            s.starts_with(".//"))
             break;
         s.remove_prefix(2);
     }
@@ -129,7 +149,8 @@ remove_dot_segments(
         if (s.starts_with("/../"))
         {
             std::size_t p = find_last_slash();
-            if (p != string_view::npos)
+            if (p != string_view::npos &&
+                    ! ends_in_dotdot(p))
                 // "erase" [p, end]
                 dest = dest0 + p;
             else if (!remove_unmatched)
@@ -140,7 +161,8 @@ remove_dot_segments(
         if (s == "/..")
         {
             std::size_t p = find_last_slash();
-            if (p != string_view::npos)
+            if (p != string_view::npos &&
+                    ! ends_in_dotdot(p))
             {
                 // erase [p, end]
                 dest = dest0 + p;
@@ -184,400 +206,293 @@ remove_dot_segments(
     return dest - dest0;
 }
 
-char
-path_pop_back( string_view& s )
+// Reads the normalized form of a path
+// one char at a time, from last to first.
+//
+// The normalized form has the dot segments
+// removed, with unmatched ".." segments
+// kept at the front unless remove_unmatched
+// is set. A path ending in "." or ".." ends
+// in "/" instead. Escapes are decoded,
+// except "%2F" which stays escaped.
+//
+// Comparing and hashing both read paths
+// through this, so paths which compare
+// equal always have the same digest.
+class normalized_path_reader
 {
-    if (s.size() < 3 ||
-        *std::prev(s.end(), 3) != '%')
+    // segments not yet visited
+    string_view s_;
+
+    // rest of the segment being read
+    string_view seg_;
+
+    // chars of an escaped '/'
+    char buf_[2];
+    std::size_t nbuf_ = 0;
+
+    // ".." segments not yet matched
+    std::size_t level_ = 0;
+
+    bool r_;
+    bool abs_;
+    bool more_ = true;
+    bool trail_ = false;
+    bool emitted_ = false;
+
+    static
+    bool
+    is_dot(string_view s) noexcept
     {
-        char c = s.back();
-        s.remove_suffix(1);
-        return c;
+        return
+            s.size() <= 3 &&
+            compare_encoded(s, ".") == 0;
     }
-    char c = 0;
-    pct_decode_unchecked(
-        &c, &c + 1, s.substr(s.size() - 3));
-    if (c != '/')
+
+    static
+    bool
+    is_dotdot(string_view s) noexcept
     {
-        s.remove_suffix(3);
-        return c;
+        return
+            s.size() >= 2 &&
+            s.size() <= 6 &&
+            compare_encoded(s, "..") == 0;
     }
-    c = s.back();
-    s.remove_suffix(1);
-    return c;
-};
 
-void
-pop_last_segment(
-    string_view& s,
-    string_view& c,
-    std::size_t& level,
-    bool r) noexcept
-{
-    c = {};
-    std::size_t n = 0;
-    while (!s.empty())
+    string_view
+    pop_segment() noexcept
     {
-        // B.  if the input buffer begins with a
-        // prefix of "/./" or "/.", where "." is
-        // a complete path segment, then replace
-        // that prefix with "/" in the input
-        // buffer; otherwise,
-        n = detail::path_ends_with(s, "/./");
-        if (n)
-        {
-            c = s.substr(s.size() - n);
-            s.remove_suffix(n);
-            continue;
-        }
-        n = detail::path_ends_with(s, "/.");
-        if (n)
-        {
-            c = s.substr(s.size() - n, 1);
-            s.remove_suffix(n);
-            continue;
-        }
-
-        // C. if the input buffer begins with a
-        // prefix of "/../" or "/..", where ".."
-        // is a complete path segment, then
-        // replace that prefix with "/" in the
-        // input buffer and remove the last
-        // segment and its preceding "/"
-        // (if any) from the output buffer
-        // otherwise,
-        n = detail::path_ends_with(s, "/../");
-        if (n)
-        {
-            c = s.substr(s.size() - n);
-            s.remove_suffix(n);
-            ++level;
-            continue;
-        }
-        n = detail::path_ends_with(s, "/..");
-        if (n)
-        {
-            c = s.substr(s.size() - n);
-            s.remove_suffix(n);
-            ++level;
-            continue;
-        }
-
-        // E.  move the first path segment in the
-        // input buffer to the end of the output
-        // buffer, including the initial "/"
-        // character (if any) and any subsequent
-        // characters up to, but not including,
-        // the next "/" character or the end of
-        // the input buffer.
-        std::size_t p = s.size() > 1
-            ? s.find_last_of('/', s.size() - 2)
-            : string_view::npos;
-        if (p != string_view::npos)
+        auto const p = s_.rfind('/');
+        if(p == string_view::npos)
         {
-            c = s.substr(p + 1);
-            s.remove_suffix(c.size());
+            more_ = false;
+            return s_;
         }
-        else
-        {
-            c = s;
-            s = {};
-        }
-
-        if (level == 0)
-            return;
-        if (!s.empty())
-            --level;
+        auto const seg = s_.substr(p + 1);
+        s_ = s_.substr(0, p);
+        return seg;
     }
-    // we still need to skip n_skip + 1
-    // but the string is empty
-    if (r && level)
+
+public:
+    normalized_path_reader(
+        string_view s,
+        bool remove_unmatched) noexcept
+        : s_(s)
+        , r_(remove_unmatched)
+        , abs_(
+            ! s.empty() &&
+            s.front() == '/')
     {
-        c = "/";
-        level = 0;
-        return;
+        if(abs_)
+            s_.remove_prefix(1);
+        auto const p = s_.rfind('/');
+        auto const last =
+            p == string_view::npos ?
+                s_ : s_.substr(p + 1);
+        // read as if followed by
+        // an empty segment
+        trail_ =
+            is_dot(last) ||
+            is_dotdot(last);
     }
-    else if (level)
-    {
-        if (c.empty())
-            c = "/..";
-        else
-            c = "/../";
-        --level;
-        return;
-    }
-    c = {};
-}
-
-
-int
-normalized_path_compare(
-    string_view s0_init,
-    string_view s1_init,
-    bool r0,
-    bool r1) noexcept
-{
-    // Pseudocode:
-    // Execute remove_dot_segments iterations in reverse:
-    // - keep track of number of elements
-    // - keep track of normalized size
-    // Iterate the both path segments in reverse again:
-    // - use normalized size to identify the
-    //   positions we are comparing
-
-    // 1. The input buffer is initialized with
-    // the now-appended path components and the
-    // output buffer is initialized to the empty
-    // string.
-    // - These memory allocations are logically removed.
 
-    // Step 2 is a loop through 5 production rules
-    // There are no transitions between all rules,
-    // which enables some optimizations, such as
-    // ignoring the prefix rules before applying
-    // other rules.
-    auto remove_prefix =
-        []( string_view& s )
+    // return false when there
+    // are no more chars
+    bool
+    next(char& c) noexcept
     {
-        // A.  If the input buffer begins with a
-        // prefix of "../" or "./", then remove
-        // that prefix from the input buffer,
-        // otherwise,
-        // Rule A can only happen at the beginning:
-        // - B and C write "/" to the output
-        // - D can only happen at the end
-        // - E leaves "/" or happens at the end
-        std::size_t out = 0;
-        std::size_t n = 0;
-        while (!s.empty())
+        for(;;)
         {
-            n = detail::path_starts_with(s, "../");
-            if (n)
+            if(nbuf_ > 0)
             {
-                out += 3;
-                s.remove_prefix(n);
-                continue;
+                c = buf_[--nbuf_];
+                return true;
             }
-            n = detail::path_starts_with(s, "./");
-            if (n)
+            if(! seg_.empty())
             {
-                s.remove_prefix(n);
-                continue;
+                auto const n = seg_.size();
+                if( n < 3 ||
+                    seg_[n - 3] != '%')
+                {
+                    c = seg_[n - 1];
+                    seg_.remove_suffix(1);
+                    return true;
+                }
+                pct_decode_unchecked(
+                    &c, &c + 1,
+                    seg_.substr(n - 3));
+                seg_.remove_suffix(3);
+                if(c == '/')
+                {
+                    buf_[0] = '%';
+                    buf_[1] = '2';
+                    nbuf_ = 2;
+                    c = 'F';
+                }
+                return true;
             }
-            break;
-        }
-
-        // D.  if the input buffer consists only
-        // of "." or "..", then remove that from
-        // the input buffer; otherwise, ...
-        // Rule D can only happen after A is consumed:
-        // - B and C write "/" to the output
-        // - D can only happen at the end
-        // - E leaves "/" or happens at the end
-        if (detail::compare_encoded(s, ".") == 0)
-            s = {};
-        else if (detail::compare_encoded(s, "..") == 0)
-        {
-            out += 2;
-            s = {};
-        }
-        return out;
-    };
-    string_view s0 = s0_init;
-    string_view s1 = s1_init;
-    std::size_t s0_prefix_n = remove_prefix(s0);
-    std::size_t s1_prefix_n = remove_prefix(s1);
 
-    // number of decoded bytes in a path segment
-    auto path_decoded_bytes =
-        []( string_view s )
-    {
-        auto it = s.data();
-        auto const end =
-            it + s.size();
-        std::size_t n = 0;
-        while(it < end)
-        {
-            if(*it != '%')
+            // find the next segment
+            string_view seg;
+            if(trail_)
+            {
+                trail_ = false;
+            }
+            else if(more_)
             {
-                // unescaped
-                ++it;
-                ++n;
-                continue;
+                seg = pop_segment();
+                if(is_dot(seg))
+                    continue;
+                if(is_dotdot(seg))
+                {
+                    ++level_;
+                    continue;
+                }
+                if(level_ > 0)
+                {
+                    --level_;
+                    continue;
+                }
+            }
+            else if(
+                ! r_ &&
+                level_ > 0)
+            {
+                --level_;
+                seg = "..";
+            }
+            else if(abs_)
+            {
+                abs_ = false;
+                c = '/';
+                return true;
             }
-            if(end - it < 3)
-                return n;
-            char c = 0;
-            pct_decode_unchecked(
-                &c,
-                &c + 1,
-                string_view(it, 3));
-            if (c != '/')
-                it += 3;
             else
-                ++it;
-            ++n;
-        }
-        return n;
-    };
-
-    // Calculate the normalized size
-    auto norm_bytes =
-        [&path_decoded_bytes]
-        ( string_view p,
-          bool r)
-    {
-        string_view c;
-        std::size_t s{0};
-        std::size_t n{0};
-        do
-        {
-            pop_last_segment(p, c, s, r);
-            n += path_decoded_bytes(c);
-        }
-        while (!c.empty());
-        return n;
-    };
-    std::size_t s0n = norm_bytes(
-        s0,
-        r0);
-    if (!r0)
-        s0n += s0_prefix_n;
-
-    std::size_t s1n = norm_bytes(
-        s1,
-        r1);
-    if (!r1)
-        s1n += s1_prefix_n;
-
-    // Remove child segments until last intersection
-    s0 = s0_init;
-    s1 = s1_init;
-    string_view s0c;
-    string_view s1c;
-    std::size_t s0l = 0;
-    std::size_t s1l = 0;
-    std::size_t s0i = s0n;
-    std::size_t s1i = s1n;
-    pop_last_segment(
-        s0, s0c, s0l,
-        r0);
-    pop_last_segment(
-        s1, s1c, s1l,
-        r1);
-
-    // Consume incomparable segments
-    auto pop_decoded_back =
-        []( string_view& s )
-    {
-        if (s.size() < 3 ||
-            *std::prev(s.end(), 3) != '%')
-        {
-            char c = s.back();
-            s.remove_suffix(1);
-            return c;
-        }
-        char c = 0;
-        pct_decode_unchecked(
-            &c, &c + 1, s.substr(s.size() - 3));
-        if (c != '/')
-        {
-            s.remove_suffix(3);
-            return c;
-        }
-        c = s.back();
-        s.remove_suffix(1);
-        return c;
-    };
-
-    while (s0i != s1i)
-    {
-        // Consume more child segments
-        if (s0c.empty())
-            pop_last_segment(
-                s0, s0c, s0l, r0);
-        if (s1c.empty())
-            pop_last_segment(
-                s1, s1c, s1l, r1);
-
-        // Remove incomparable suffix
-        while (
-            !s0c.empty() &&
-            !s1c.empty())
-        {
-            if (s1i > s0i)
             {
-                pop_decoded_back(s1c);
-                --s1i;
-                continue;
+                return false;
             }
-            else if (s0i > s1i)
+            seg_ = seg;
+            if(emitted_)
             {
-                pop_decoded_back(s0c);
-                --s0i;
-                continue;
+                c = '/';
+                return true;
             }
-            break;
+            emitted_ = true;
         }
     }
 
-    int cmp = 0;
-    BOOST_ASSERT(s0i == s1i);
-    while (s0i > 0)
+    // return the number of chars
+    static
+    std::size_t
+    size(
+        string_view s,
+        bool remove_unmatched) noexcept
     {
-        // Consume more child segments
-        if (s0c.empty())
-            pop_last_segment(
-                s0, s0c, s0l, r0);
-        if (s1c.empty())
-            pop_last_segment(
-                s1, s1c, s1l, r1);
-
-        // Compare intersection
-        while (
-            !s0c.empty() &&
-            !s1c.empty())
-        {
-            BOOST_ASSERT(s0i == s1i);
-            char c0 = pop_decoded_back(s0c);
-            char c1 = pop_decoded_back(s1c);
-            if (c0 < c1)
-                cmp = -1;
-            else if (c1 < c0)
-                cmp = 1;
-            --s0i;
-            --s1i;
-        }
+        normalized_path_reader r(
+            s, remove_unmatched);
+        std::size_t n = 0;
+        char c;
+        while(r.next(c))
+            ++n;
+        return n;
     }
+};
 
-    if (cmp != 0)
+int
+normalized_path_compare(
+    string_view s0,
+    string_view s1,
+    bool r0,
+    bool r1) noexcept
+{
+    // The normalized paths are read from
+    // the back, so chars past the length
+    // of the shorter one are skipped first.
+    // The last difference found is the
+    // first one in the normalized paths.
+    std::size_t const n0 =
+        normalized_path_reader::size(s0, r0);
+    std::size_t const n1 =
+        normalized_path_reader::size(s1, r1);
+    normalized_path_reader p0(s0, r0);
+    normalized_path_reader p1(s1, r1);
+    char c0;
+    char c1;
+    for(auto n = n0; n > n1; --n)
+        p0.next(c0);
+    for(auto n = n1; n > n0; --n)
+        p1.next(c1);
+    int cmp = 0;
+    while(
+        p0.next(c0) &&
+        p1.next(c1))
+    {
+        if(c0 < c1)
+            cmp = -1;
+        else if(c1 < c0)
+            cmp = 1;
+    }
+    if(cmp != 0)
         return cmp;
-    if (s0n == s1n )
+    if(n0 == n1)
         return 0;
-    if (s0n < s1n )
+    if(n0 < n1)
         return -1;
     return 1;
 }
 
+// return true if s has a "." or ".." segment
+static
+bool
+has_dot_segment(
+    string_view s) noexcept
+{
+    auto const first = s.data();
+    auto const last = first + s.size();
+    auto it = first;
+    for(;;)
+    {
+        auto const p = static_cast<
+            char const*>(std::memchr(
+                it, '.', last - it));
+        if(! p)
+            return false;
+        if( p == first ||
+            p[-1] == '/')
+        {
+            auto q = p + 1;
+            if( q != last &&
+                *q == '.')
+                ++q;
+            if( q == last ||
+                *q == '/')
+                return true;
+        }
+        it = p + 1;
+    }
+}
+
+// The digest is of the normalized path
+// with its chars in reverse order, which
+// is the order they are read in.
 void
 normalized_path_digest(
     string_view s,
     bool remove_unmatched,
-    fnv_1a& hasher) noexcept
+    block_hasher& hasher) noexcept
 {
-    string_view child;
-    std::size_t level = 0;
-    do
+    if( ! has_dot_segment(s) &&
+        ! std::memchr(s.data(), '%', s.size()))
     {
-        pop_last_segment(
-            s, child, level, remove_unmatched);
-        while (!child.empty())
-        {
-            char c = path_pop_back(child);
-            hasher.put(c);
-        }
+        // already normalized
+        hasher.put_reversed(s);
+        return;
     }
-    while (!s.empty());
+    normalized_path_reader r(
+        s, remove_unmatched);
+    char c;
+    while(r.next(c))
+        hasher.put(c);
 }
 
 } // detail
@@ -0,0 +1,296 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_IMPL_RESOLVE_IPP
+#define BOOST_URL_DETAIL_IMPL_RESOLVE_IPP
+
+#include <boost/url/detail/resolve.hpp>
+#include <boost/url/detail/path.hpp>
+#include <boost/url/detail/remove_dot_segments.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// A path which does not start with '/'
+// gets one while removing dot-segments,
+// so that a ".." in the first segment
+// is handled like any other.
+static
+bool
+resolve_rootless(
+    resolve_plan const& p) noexcept
+{
+    return
+        ! (p.p0.empty() ? p.p1 : p.p0
+            ).starts_with('/') &&
+        p.p0.size() + p.p1.size() > 0;
+}
+
+std::size_t
+resolve_plan::
+size() const noexcept
+{
+    // The path is built after two spare
+    // bytes, which hold the "/." needed in
+    // front of a path starting with "//"
+    // when there is no authority.
+    return
+        scheme->len(url_impl::id_scheme) +
+        (auth ? auth->len(
+            url_impl::id_user,
+            url_impl::id_path) : 0) +
+        2 + resolve_rootless(*this) +
+        p0.size() + p1.size() +
+        (query ? query->len(
+            url_impl::id_query) : 0) +
+        frag->len(url_impl::id_frag);
+}
+
+string_view
+resolve_merge_prefix(
+    url_impl const& base) noexcept
+{
+    auto const s =
+        base.get(url_impl::id_path);
+    if( base.len(url_impl::id_user) > 0 &&
+        s.empty())
+        return "/";
+    auto const n = s.find_last_of('/');
+    if(n == string_view::npos)
+        return {};
+    return s.substr(0, n + 1);
+}
+
+//
+// 5.2.2. Transform References
+// https://datatracker.ietf.org/doc/html/rfc3986#section-5.2.2
+//
+void
+resolve_plan_init(
+    resolve_plan& p,
+    url_impl const& b,
+    string_view merge,
+    url_impl const& r) noexcept
+{
+    BOOST_ASSERT(
+        b.len(url_impl::id_scheme) > 0);
+    bool const r_auth =
+        r.len(url_impl::id_user) > 0;
+    bool const r_query =
+        r.len(url_impl::id_query) > 0;
+    p.scheme = &b;
+    p.auth = nullptr;
+    p.query = nullptr;
+    p.frag = &r;
+    p.p0 = {};
+    p.p1 = r.get(url_impl::id_path);
+    if(r.len(url_impl::id_scheme) > 0)
+    {
+        p.scheme = &r;
+        if(r_auth)
+            p.auth = &r;
+        if(r_query)
+            p.query = &r;
+    }
+    else if(r_auth)
+    {
+        p.auth = &r;
+        if(r_query)
+            p.query = &r;
+    }
+    else
+    {
+        if(b.len(url_impl::id_user) > 0)
+            p.auth = &b;
+        if(p.p1.empty())
+        {
+            p.p1 = b.get(url_impl::id_path);
+            if(r_query)
+                p.query = &r;
+            else if(b.len(
+                    url_impl::id_query) > 0)
+                p.query = &b;
+        }
+        else
+        {
+            if(p.p1.front() != '/')
+                p.p0 = merge;
+            if(r_query)
+                p.query = &r;
+        }
+    }
+}
+
+url_impl
+resolve_write(
+    char* dest,
+    resolve_plan const& pl) noexcept
+{
+    auto const start = dest;
+    bool const rootless =
+        resolve_rootless(pl);
+    auto const ns = pl.scheme->len(
+        url_impl::id_scheme);
+    auto const na = pl.auth ?
+        pl.auth->len(
+            url_impl::id_user,
+            url_impl::id_path) : 0;
+    auto const nq = pl.query ?
+        pl.query->len(
+            url_impl::id_query) : 0;
+    auto const nf = pl.frag->len(
+        url_impl::id_frag);
+
+    // scheme, authority
+    std::memcpy(dest, pl.scheme->get(
+        url_impl::id_scheme).data(), ns);
+    dest += ns;
+    if(pl.auth)
+        std::memcpy(dest, pl.auth->get(
+            url_impl::id_user,
+            url_impl::id_path).data(), na);
+    dest += na;
+
+    // path
+    //
+    // remove_dot_segments writes its
+    // output over its input
+    char* p = dest + 2;
+    {
+        char* it = p;
+        if(rootless)
+            *it++ = '/';
+        it += pl.p0.copy(it, pl.p0.size());
+        it += pl.p1.copy(it, pl.p1.size());
+        std::size_t n =
+            remove_dot_segments(
+                p, it, string_view(
+                    p, it - p), false);
+        if(rootless)
+        {
+            BOOST_ASSERT(
+                n > 0 && *p == '/');
+            ++p;
+            --n;
+        }
+        if( ! pl.auth &&
+            n > 1 &&
+            p[0] == '/' &&
+            p[1] == '/')
+        {
+            p -= 2;
+            p[0] = '/';
+            p[1] = '.';
+            n += 2;
+        }
+        std::memmove(dest, p, n);
+        p = dest;
+        dest += n;
+    }
+
+    // query, fragment
+    if(pl.query)
+        std::memcpy(dest, pl.query->get(
+            url_impl::id_query).data(), nq);
+    dest += nq;
+    std::memcpy(dest, pl.frag->get(
+        url_impl::id_frag).data(), nf);
+    dest += nf;
+    *dest = '\0';
+
+    // offsets
+    auto const np = dest - p - nq - nf;
+    url_impl u(false);
+    u.cs_ = start;
+    u.scheme_ = pl.scheme->scheme_;
+    u.offset_[url_impl::id_user] =
+        static_cast<pos_t>(ns);
+    if(pl.auth)
+    {
+        auto const& a = *pl.auth;
+        u.offset_[url_impl::id_pass] =
+            static_cast<pos_t>(ns + a.len(
+                url_impl::id_user));
+        u.offset_[url_impl::id_host] =
+            static_cast<pos_t>(ns + a.len(
+                url_impl::id_user,
+                url_impl::id_host));
+        u.offset_[url_impl::id_port] =
+            static_cast<pos_t>(ns + a.len(
+                url_impl::id_user,
+                url_impl::id_port));
+        u.decoded_[url_impl::id_user] =
+            a.decoded_[url_impl::id_user];
+        u.decoded_[url_impl::id_pass] =
+            a.decoded_[url_impl::id_pass];
+        u.decoded_[url_impl::id_host] =
+            a.decoded_[url_impl::id_host];
+        u.host_type_ = a.host_type_;
+        u.port_number_ = a.port_number_;
+        std::memcpy(
+            u.ip_addr_,
+            a.ip_addr_,
+            sizeof(u.ip_addr_));
+    }
+    else
+    {
+        u.offset_[url_impl::id_pass] =
+            static_cast<pos_t>(ns);
+        u.offset_[url_impl::id_host] =
+            static_cast<pos_t>(ns);
+        u.offset_[url_impl::id_port] =
+            static_cast<pos_t>(ns);
+    }
+    u.offset_[url_impl::id_path] =
+        static_cast<pos_t>(ns + na);
+    u.offset_[url_impl::id_query] =
+        static_cast<pos_t>(ns + na + np);
+    u.offset_[url_impl::id_frag] =
+        static_cast<pos_t>(ns + na + np + nq);
+    u.offset_[url_impl::id_end] =
+        static_cast<pos_t>(
+            ns + na + np + nq + nf);
+    {
+        // the path only has valid escapes
+        string_view const s(p, np);
+        std::size_t nseg = 0;
+        std::size_t npct = 0;
+        for(char c : s)
+        {
+            nseg += c == '/';
+            npct += c == '%';
+        }
+        if( ! s.empty() &&
+            s.front() != '/')
+            ++nseg;
+        u.decoded_[url_impl::id_path] =
+            static_cast<pos_t>(
+                np - 2 * npct);
+        u.nseg_ = static_cast<pos_t>(
+            path_segments(s, nseg));
+    }
+    if(pl.query)
+    {
+        u.decoded_[url_impl::id_query] =
+            pl.query->decoded_[
+                url_impl::id_query];
+        u.nparam_ = pl.query->nparam_;
+    }
+    u.decoded_[url_impl::id_frag] =
+        pl.frag->decoded_[url_impl::id_frag];
+    return u;
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
@@ -14,6 +14,7 @@
 #include <boost/url/detail/segments_encoded_iterator_impl.hpp>
 #include <boost/url/rfc/detail/path_rules.hpp>
 #include <boost/assert.hpp>
+#include <cstring>
 
 namespace boost {
 namespace urls {
@@ -62,6 +63,25 @@ segments_encoded_iterator_impl(
     begin_ += n;
 }
 
+segments_encoded_iterator_impl::
+segments_encoded_iterator_impl(
+    string_view s,
+    std::size_t i,
+    std::size_t pos,
+    std::size_t next) noexcept
+    : i_(i)
+    , begin_(s.data())
+    , pos_(s.data() + pos)
+    , next_(s.data() + next)
+    , end_(s.data() + s.size())
+{
+    BOOST_ASSERT(i > 0);
+    BOOST_ASSERT(*pos_ == '/');
+    begin_ += path_prefix(s);
+    s_ = string_view(
+        pos_ + 1, next_ - pos_ - 1);
+}
+
 void
 segments_encoded_iterator_impl::
 increment() noexcept
@@ -69,16 +89,20 @@ increment() noexcept
     BOOST_ASSERT(next_ != nullptr);
     ++i_;
     pos_ = next_;
-    // "/" segment
-    auto rv = grammar::parse(
-        next_, end_,
-            detail::slash_segment_rule);
-    if(rv.has_error())
+    if(next_ == end_)
     {
         next_ = nullptr;
         return;
     }
-    s_ = rv->encoded();
+    // "/" segment. The path is already
+    // valid, so it ends at the next '/'
+    BOOST_ASSERT(*next_ == '/');
+    auto const p = next_ + 1;
+    auto const q = static_cast<
+        char const*>(std::memchr(
+            p, '/', end_ - p));
+    next_ = q ? q : end_;
+    s_ = string_view(p, next_ - p);
 }
 
 void
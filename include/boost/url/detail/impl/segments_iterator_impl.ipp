@@ -56,6 +56,27 @@ segments_iterator_impl(
     begin_ += n;
 }
 
+segments_iterator_impl::
+segments_iterator_impl(
+    string_view s,
+    std::size_t i,
+    std::size_t pos,
+    std::size_t next) noexcept
+    : i_(i)
+    , begin_(s.data())
+    , pos_(s.data() + pos)
+    , next_(s.data() + next)
+    , end_(s.data() + s.size())
+{
+    BOOST_ASSERT(i > 0);
+    BOOST_ASSERT(*pos_ == '/');
+    begin_ += path_prefix(s);
+    char const* it = pos_;
+    t_ = grammar::parse(
+        it, end_,
+        detail::slash_segment_rule).value();
+}
+
 pct_encoded_view
 segments_iterator_impl::
 dereference() const noexcept
@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_IP_SCAN_HPP
+#define BOOST_URL_DETAIL_IP_SCAN_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+/*  Kernels for parsing IP addresses
+
+    These accept exactly what the rules in
+    rfc/ do, without going through the
+    generic grammar machinery. A digit is
+    classified with one unsigned compare.
+    On failure they return false, and the
+    rules parse again to find the error.
+*/
+
+// the value of a DIGIT, or more than 9
+inline
+unsigned
+digit_value(char c) noexcept
+{
+    return static_cast<unsigned char>(
+        c) - static_cast<unsigned>('0');
+}
+
+// dec-octet, without leading zeros
+inline
+bool
+parse_dec_octet(
+    char const*& it,
+    char const* const end,
+    unsigned char& dest) noexcept
+{
+    if(it == end)
+        return false;
+    unsigned v = digit_value(*it);
+    if(v > 9)
+        return false;
+    ++it;
+    unsigned d;
+    if( it == end ||
+        (d = digit_value(*it)) > 9)
+    {
+        dest = static_cast<
+            unsigned char>(v);
+        return true;
+    }
+    if(v == 0)
+        return false;
+    v = 10 * v + d;
+    ++it;
+    if( it == end ||
+        (d = digit_value(*it)) > 9)
+    {
+        dest = static_cast<
+            unsigned char>(v);
+        return true;
+    }
+    v = 10 * v + d;
+    if(v > 255)
+        return false;
+    ++it;
+    dest = static_cast<
+        unsigned char>(v);
+    return true;
+}
+
+// IPv4address into dest[0..3]
+inline
+bool
+parse_ipv4(
+    char const*& it,
+    char const* const end,
+    unsigned char* dest) noexcept
+{
+    auto p = it;
+    if(! parse_dec_octet(p, end, dest[0]))
+        return false;
+    for(int i = 1; i < 4; ++i)
+    {
+        if( p == end ||
+            *p != '.')
+            return false;
+        ++p;
+        if(! parse_dec_octet(
+                p, end, dest[i]))
+            return false;
+    }
+    it = p;
+    return true;
+}
+
+// h16, at least one HEXDIG
+inline
+bool
+parse_h16(
+    char const*& it,
+    char const* const end,
+    unsigned char* dest) noexcept
+{
+    if(it == end)
+        return false;
+    auto d = grammar::hexdig_value(*it);
+    if(d < 0)
+        return false;
+    unsigned v = static_cast<unsigned>(d);
+    auto const last =
+        end - it > 4 ? it + 4 : end;
+    ++it;
+    while(it != last)
+    {
+        d = grammar::hexdig_value(*it);
+        if(d < 0)
+            break;
+        v = 16 * v + static_cast<
+            unsigned>(d);
+        ++it;
+    }
+    dest[0] = static_cast<
+        unsigned char>(v >> 8);
+    dest[1] = static_cast<
+        unsigned char>(v);
+    return true;
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
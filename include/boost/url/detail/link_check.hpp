@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_LINK_CHECK_HPP
+#define BOOST_URL_DETAIL_LINK_CHECK_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+/*  Some macros change the layout of types
+    which are shared between the library
+    and the program, and must be defined
+    the same way for both.
+
+    Every program refers to link_check
+    with the values of those settings it
+    was compiled with, and the library
+    defines it only for the values it was
+    built with. When they differ, the
+    program fails to link, instead of
+    reading the wrong offsets at run time.
+*/
+template<class Setting, std::size_t Value>
+struct BOOST_SYMBOL_VISIBLE link_check
+{
+    static int const value;
+};
+
+// B^n, for the digest below
+constexpr
+std::size_t
+link_check_pow(std::size_t n) noexcept
+{
+    return n == 0 ? 1 :
+        (n % 2 ? 1099511628211u : 1) *
+        link_check_pow(n / 2) *
+        link_check_pow(n / 2);
+}
+
+// A polynomial digest of n chars, for
+// settings which are lists. It splits
+// the chars in halves, so the depth of
+// the recursion is only log(n).
+constexpr
+std::size_t
+link_check_digest(
+    char const* s,
+    std::size_t n) noexcept
+{
+    return
+        n == 0 ? 0 :
+        n == 1 ? static_cast<
+            unsigned char>(*s) + 1u :
+        link_check_digest(s, n / 2) *
+            link_check_pow(n - n / 2) +
+        link_check_digest(
+            s + n / 2, n - n / 2);
+}
+
+} // detail
+} // urls
+} // boost
+
+// The reference must be kept even when the
+// program never uses it. Where this cannot
+// be done reliably there is no check.
+#if defined(__GNUC__) && \
+    ! defined(_WIN32) && \
+    ! defined(BOOST_URL_DOCS)
+# define BOOST_URL_LINK_CHECK(name, n)              \
+    namespace boost {                               \
+    namespace urls {                                \
+    namespace detail {                              \
+    struct BOOST_SYMBOL_VISIBLE name;               \
+    __attribute__((used))                           \
+    static int const* const name##_ref =            \
+        &link_check<name, (n)>::value;              \
+    } } }
+#else
+# define BOOST_URL_LINK_CHECK(name, n)
+#endif
+
+#endif
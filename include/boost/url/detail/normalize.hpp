@@ -12,58 +12,195 @@
 #define BOOST_URL_DETAIL_NORMALIZED_HPP
 
 #include <boost/url/string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 namespace boost {
 namespace urls {
 namespace detail {
 
-class fnv_1a
+// 64x64 to 128 bit multiply, folded
+inline
+std::uint64_t
+hash_mum(
+    std::uint64_t a,
+    std::uint64_t b) noexcept
 {
-public:
-    using digest_type = std::size_t;
-
-#if BOOST_URL_ARCH == 64
-    static constexpr std::size_t const prime =
-        static_cast<std::size_t>(0x100000001B3ULL);
-    static constexpr std::size_t init_hash  =
-        static_cast<std::size_t>(0xcbf29ce484222325ULL);
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef
+        unsigned __int128 u128;
+    u128 const r = static_cast<u128>(a) * b;
+    return
+        static_cast<std::uint64_t>(r) ^
+        static_cast<std::uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    std::uint64_t hi;
+    std::uint64_t const lo =
+        _umul128(a, b, &hi);
+    return lo ^ hi;
 #else
-    static constexpr std::size_t const prime =
-        static_cast<std::size_t>(0x01000193UL);
-    static constexpr std::size_t init_hash  =
-        static_cast<std::size_t>(0x811C9DC5UL);
+    std::uint64_t const a0 = a & 0xffffffff;
+    std::uint64_t const a1 = a >> 32;
+    std::uint64_t const b0 = b & 0xffffffff;
+    std::uint64_t const b1 = b >> 32;
+    std::uint64_t const t = a0 * b0;
+    std::uint64_t const m0 = a1 * b0;
+    std::uint64_t const m1 = a0 * b1;
+    std::uint64_t const c =
+        (t >> 32) +
+        (m0 & 0xffffffff) +
+        (m1 & 0xffffffff);
+    std::uint64_t const lo =
+        (t & 0xffffffff) | (c << 32);
+    std::uint64_t const hi =
+        a1 * b1 + (m0 >> 32) +
+        (m1 >> 32) + (c >> 32);
+    return lo ^ hi;
 #endif
+}
+
+/*  A hash over a stream of chars
+
+    Chars are consumed in blocks of 16,
+    each mixed with a single wide multiply.
+    The digest only depends on the chars
+    and not on how they were split across
+    calls, so runs without escapes can be
+    given straight from the encoded string
+    while escapes are given one at a time.
+*/
+class block_hasher
+{
+    static constexpr std::uint64_t k0 =
+        0xa0761d6478bd642fULL;
+    static constexpr std::uint64_t k1 =
+        0xe7037ed1a0b428dbULL;
+    static constexpr std::uint64_t k2 =
+        0x8ebc6af09c88c6e3ULL;
+    static constexpr std::uint64_t k3 =
+        0x589965cc75374cc3ULL;
+
+    std::uint64_t h_;
+    std::uint64_t len_ = 0;
+    std::size_t n_ = 0;
+    unsigned char buf_[16];
+
+    static
+    std::uint64_t
+    load(void const* p) noexcept
+    {
+        std::uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    // reverse the order of the
+    // bytes in the word
+    static
+    std::uint64_t
+    swap(std::uint64_t v) noexcept
+    {
+        v = ((v & 0x00ff00ff00ff00ffULL) << 8) |
+            ((v >> 8) & 0x00ff00ff00ff00ffULL);
+        v = ((v & 0x0000ffff0000ffffULL) << 16) |
+            ((v >> 16) & 0x0000ffff0000ffffULL);
+        return (v << 32) | (v >> 32);
+    }
+
+    void
+    block(
+        std::uint64_t w0,
+        std::uint64_t w1) noexcept
+    {
+        h_ = hash_mum(w0 ^ k1, w1 ^ h_);
+    }
+
+public:
+    using digest_type = std::size_t;
 
     explicit
-    fnv_1a(std::size_t salt) noexcept
-    : h_(init_hash + salt)
+    block_hasher(std::size_t salt) noexcept
+        : h_(hash_mum(
+            static_cast<std::uint64_t>(
+                salt) ^ k0, k1))
     {
     }
 
     void
     put(char c) noexcept
     {
-        h_ ^= c;
-        h_ *= prime;
+        buf_[n_++] = static_cast<
+            unsigned char>(c);
+        if(n_ < sizeof(buf_))
+            return;
+        block(load(buf_), load(buf_ + 8));
+        len_ += sizeof(buf_);
+        n_ = 0;
     }
 
     void
     put(string_view s) noexcept
     {
-        for (char c: s)
+        auto p = s.data();
+        auto n = s.size();
+        while(n_ != 0 && n != 0)
+        {
+            put(*p++);
+            --n;
+        }
+        while(n >= 16)
+        {
+            block(load(p), load(p + 8));
+            len_ += 16;
+            p += 16;
+            n -= 16;
+        }
+        while(n != 0)
+        {
+            buf_[n_++] = static_cast<
+                unsigned char>(*p++);
+            --n;
+        }
+    }
+
+    // same as calling put for each
+    // char of s, from last to first
+    void
+    put_reversed(string_view s) noexcept
+    {
+        auto const first = s.data();
+        auto p = first + s.size();
+        while(n_ != 0 && p != first)
+            put(*--p);
+        while(p - first >= 16)
         {
-            put(c);
+            block(
+                swap(load(p - 8)),
+                swap(load(p - 16)));
+            len_ += 16;
+            p -= 16;
         }
+        while(p != first)
+            buf_[n_++] = static_cast<
+                unsigned char>(*--p);
     }
 
     digest_type
     digest() const noexcept
     {
-        return h_;
+        unsigned char b[16] = {};
+        std::memcpy(b, buf_, n_);
+        std::uint64_t h = hash_mum(
+            load(b) ^ k1, load(b + 8) ^ h_);
+        h = hash_mum(
+            h ^ k2, (len_ + n_) ^ k3);
+        return static_cast<digest_type>(
+            h ^ (h >> 32));
     }
-
-private:
-    std::size_t h_;
 };
 
 void
@@ -84,12 +221,12 @@ compare_encoded(
 void
 digest_encoded(
     string_view s,
-    fnv_1a& hasher) noexcept;
+    block_hasher& hasher) noexcept;
 
 void
 digest(
     string_view s,
-    fnv_1a& hasher) noexcept;
+    block_hasher& hasher) noexcept;
 
 // check if string_view lhs starts with string_view
 // rhs as if they are both percent-decoded. If
@@ -121,7 +258,7 @@ ci_compare_encoded(
 void
 ci_digest_encoded(
     string_view s,
-    fnv_1a& hasher) noexcept;
+    block_hasher& hasher) noexcept;
 
 // compare two ascii string_views
 int
@@ -140,7 +277,7 @@ ci_compare(
 void
 ci_digest(
     string_view s,
-    fnv_1a& hasher) noexcept;
+    block_hasher& hasher) noexcept;
 
 } // detail
 } // urls
@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2022 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_OFFSET_TABLE_HPP
+#define BOOST_URL_DETAIL_OFFSET_TABLE_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/string_view.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// A table of offsets into one part of a
+// url, used to locate path segments or
+// query params by index in constant time.
+//
+// The table is only a cache. It is built
+// on demand, and when memory is unavailable
+// or the owner does not allow allocation it
+// stays invalid and callers fall back to
+// scanning the string. Besides explicit
+// invalidation, the table is only considered
+// valid for the entry count and part length
+// it was built with.
+class offset_table
+{
+    pos_t* v_ = nullptr;
+    std::size_t cap_ = 0;
+    std::size_t n_ = 0;
+    pos_t len_ = 0;
+    bool valid_ = false;
+    bool enabled_ = true;
+
+public:
+    offset_table() = default;
+
+    BOOST_URL_DECL
+    ~offset_table();
+
+    // copies start out invalid
+    offset_table(
+        offset_table const&) noexcept
+    {
+    }
+
+    offset_table&
+    operator=(
+        offset_table const&) noexcept
+    {
+        invalidate();
+        return *this;
+    }
+
+    // never allocate
+    void
+    disable() noexcept
+    {
+        valid_ = false;
+        enabled_ = false;
+    }
+
+    void
+    invalidate() noexcept
+    {
+        valid_ = false;
+    }
+
+    // return true if the table holds n
+    // entries for a part of length len
+    bool
+    valid(
+        std::size_t n,
+        pos_t len) const noexcept
+    {
+        return
+            valid_ &&
+            n_ == n &&
+            len_ == len;
+    }
+
+    // mark the table valid for a
+    // part of length len
+    void
+    validate(pos_t len) noexcept
+    {
+        valid_ = true;
+        len_ = len;
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+    pos_t&
+    operator[](
+        std::size_t i) noexcept
+    {
+        BOOST_ASSERT(i < n_);
+        return v_[i];
+    }
+
+    pos_t
+    operator[](
+        std::size_t i) const noexcept
+    {
+        BOOST_ASSERT(i < n_);
+        return v_[i];
+    }
+
+    // Build a table of n + 1 entries for
+    // the part s: entry 0 is zero, entries
+    // up to n - 1 are the offsets of the
+    // successive separators found in s
+    // starting at pos, and entry n is the
+    // size of s.
+    BOOST_URL_DECL
+    void
+    build(
+        std::size_t n,
+        string_view s,
+        std::size_t pos,
+        char sep) noexcept;
+
+    // Update a valid table after entries
+    // [i0, i1) were replaced with n new
+    // entries and the part became s. The
+    // new entries are found as in build,
+    // starting at pos, and the entries
+    // after them are shifted by the change
+    // in the length of the part.
+    BOOST_URL_DECL
+    void
+    update(
+        std::size_t i0,
+        std::size_t i1,
+        std::size_t n,
+        string_view s,
+        std::size_t pos,
+        char sep) noexcept;
+
+private:
+    bool
+    reserve(std::size_t n) noexcept;
+};
+
+} // detail
+} // urls
+} // boost
+
+#endif
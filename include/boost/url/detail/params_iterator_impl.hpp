@@ -46,6 +46,15 @@ struct params_iterator_impl
         std::size_t nparam,
         int) noexcept;
 
+    // construct at param i, where
+    // 0 < i < nparam, given the offset
+    // in s of its leading '&'
+    BOOST_URL_DECL
+    params_iterator_impl(
+        string_view s,
+        std::size_t i,
+        std::size_t pos) noexcept;
+
     params_iterator_impl() = default;
 
     params_iterator_impl(
@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_PCT_SCAN_HPP
+#define BOOST_URL_DETAIL_PCT_SCAN_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/grammar/detail/charset.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+/*  Kernels for percent-decoding
+
+    Escapes are usually sparse, so decoding
+    is mostly copying the runs between them.
+    These find the end of a run 16 or 32
+    characters at a time.
+*/
+
+// Return the first '%' in [first, last)
+inline
+char const*
+find_pct(
+    char const* first,
+    char const* last) noexcept
+{
+    if(first == last)
+        return last;
+    auto const p = static_cast<
+        char const*>(std::memchr(
+            first, '%', last - first));
+    return p ? p : last;
+}
+
+// Return the first '%' or c in [first, last)
+inline
+char const*
+find_pct_or(
+    char const* first,
+    char const* last,
+    char c) noexcept
+{
+#ifdef BOOST_URL_USE_SSE2
+#ifdef BOOST_URL_USE_AVX2
+    if(last - first >= 32)
+    {
+        __m256i const v0 =
+            _mm256_set1_epi8('%');
+        __m256i const v1 =
+            _mm256_set1_epi8(c);
+        do
+        {
+            __m256i const v = _mm256_loadu_si256(
+                reinterpret_cast<
+                    __m256i const*>(first));
+            unsigned const m = static_cast<
+                unsigned>(_mm256_movemask_epi8(
+                    _mm256_or_si256(
+                        _mm256_cmpeq_epi8(v, v0),
+                        _mm256_cmpeq_epi8(v, v1))));
+            if(m)
+                return first +
+                    boost::core::countr_zero(m);
+            first += 32;
+        }
+        while(last - first >= 32);
+    }
+#endif
+    if(last - first >= 16)
+    {
+        __m128i const v0 =
+            _mm_set1_epi8('%');
+        __m128i const v1 =
+            _mm_set1_epi8(c);
+        do
+        {
+            __m128i const v = _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(first));
+            unsigned const m = static_cast<
+                unsigned>(_mm_movemask_epi8(
+                    _mm_or_si128(
+                        _mm_cmpeq_epi8(v, v0),
+                        _mm_cmpeq_epi8(v, v1))));
+            if(m)
+                return first +
+                    boost::core::countr_zero(m);
+            first += 16;
+        }
+        while(last - first >= 16);
+    }
+#endif
+    while(
+        first != last &&
+        *first != '%' &&
+        *first != c)
+        ++first;
+    return first;
+}
+
+// Return the octet escaped by the two
+// hex digits at p, which must be valid
+inline
+char
+decode_hex_unchecked(
+    char const* p) noexcept
+{
+    // '0'-'9' are 0x30-0x39, while
+    // 'A'-'F' and 'a'-'f' have bit 6
+    // set and low nibbles 1 to 6
+    auto const hex = [](char c)
+    {
+        auto const u = static_cast<
+            unsigned char>(c);
+        return static_cast<unsigned char>(
+            (u & 0x0f) + 9 * (u >> 6));
+    };
+    return static_cast<char>(
+        (hex(p[0]) << 4) | hex(p[1]));
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
@@ -10,7 +10,9 @@
 #ifndef BOOST_URL_DETAIL_RECYCLER_HPP
 #define BOOST_URL_DETAIL_RECYCLER_HPP
 
-#include <mutex>
+#include <boost/url/detail/config.hpp>
+#include <atomic>
+#include <cstddef>
 #include <utility>
 
 namespace boost {
@@ -27,6 +29,19 @@ void
 recycler_remove_impl(
     std::size_t) noexcept;
 
+BOOST_URL_DECL
+void
+recycler_hit_impl(
+    bool shared) noexcept;
+
+BOOST_URL_DECL
+void
+recycler_miss_impl() noexcept;
+
+BOOST_URL_DECL
+void
+recycler_retry_impl() noexcept;
+
 #ifdef BOOST_URL_REPORT
 
 inline
@@ -45,6 +60,28 @@ recycler_remove(
     recycler_remove_impl(n);
 }
 
+inline
+void
+recycler_hit(
+    bool shared) noexcept
+{
+    recycler_hit_impl(shared);
+}
+
+inline
+void
+recycler_miss() noexcept
+{
+    recycler_miss_impl();
+}
+
+inline
+void
+recycler_retry() noexcept
+{
+    recycler_retry_impl();
+}
+
 #else
 
 inline void recycler_add(
@@ -55,9 +92,34 @@ inline void recycler_remove(
     std::size_t) noexcept
 {
 }
+inline void recycler_hit(
+    bool) noexcept
+{
+}
+inline void recycler_miss() noexcept
+{
+}
+inline void recycler_retry() noexcept
+{
+}
 
 #endif
 
+/*  Each thread keeps a small cache of
+    released objects, so that most acquire
+    and release pairs touch no shared state.
+    A cache which grows past local_max drains
+    half of its objects to a shared list, and
+    an empty cache refills from it.
+
+    The shared list is lock-free. Objects are
+    pushed with a compare-and-swap, but only
+    ever removed all at once with an exchange,
+    so the list is immune to ABA without
+    needing tagged pointers. Objects pushed
+    while the shared list holds more than
+    shared_max are freed instead.
+*/
 template<class T>
 struct recycler
 {
@@ -74,7 +136,8 @@ struct recycler
     ~recycler()
     {
         std::size_t n = 0;
-        auto it = head_;
+        auto it = head_.load(
+            std::memory_order_acquire);
         while(it)
         {
             ++n;
@@ -89,31 +152,180 @@ struct recycler
     void
     release(U* u) noexcept
     {
-        m_.lock();
-        u->next = head_;
-        head_ = u;
-        m_.unlock();
         recycler_add(sizeof(U));
+        auto c = local();
+        if(! c)
+        {
+            u->next = nullptr;
+            push(u, u, 1);
+            return;
+        }
+        u->next = c->head;
+        c->head = u;
+        if(++c->n <= local_max)
+            return;
+
+        // drain half of the cache
+        std::size_t n = 1;
+        auto last = u;
+        while(n < local_max / 2)
+        {
+            last = last->next;
+            ++n;
+        }
+        c->head = last->next;
+        c->n -= n;
+        last->next = nullptr;
+        push(u, last, n);
     }
 
     U*
     try_acquire()
     {
-        std::lock_guard<
-            std::mutex> lock(m_);
-        auto p = head_;
-        if(p)
+        auto c = local();
+        if( c && c->head)
         {
-            // recycle
-            head_ = head_->next;
+            auto p = c->head;
+            c->head = p->next;
+            --c->n;
             recycler_remove(sizeof(U));
+            recycler_hit(false);
+            return p;
+        }
+        auto p = head_.exchange(
+            nullptr, std::memory_order_acquire);
+        if(! p)
+        {
+            recycler_miss();
+            return nullptr;
+        }
+
+        // refill the cache from
+        // the rest of the list
+        std::size_t n = 1;
+        auto it = p->next;
+        if(c && it)
+        {
+            auto last = it;
+            ++n;
+            while(
+                last->next &&
+                n <= local_max)
+            {
+                last = last->next;
+                ++n;
+            }
+            c->head = it;
+            c->n = n - 1;
+            it = last->next;
+            last->next = nullptr;
+        }
+        size_.fetch_sub(
+            n, std::memory_order_relaxed);
+
+        // put back the remainder
+        if(it)
+        {
+            auto last = it;
+            while(last->next)
+                last = last->next;
+            splice(it, last);
         }
+        recycler_remove(sizeof(U));
+        recycler_hit(true);
         return p;
     }
 
 private:
-    U* head_ = nullptr;
-    std::mutex m_;
+    // objects kept by each thread
+    static constexpr std::size_t local_max = 16;
+
+    // objects kept in the shared list
+    static constexpr std::size_t shared_max = 1024;
+
+    struct cache
+    {
+        recycler* r = nullptr;
+        U* head = nullptr;
+        std::size_t n = 0;
+
+        ~cache()
+        {
+            if(! head)
+                return;
+            auto last = head;
+            while(last->next)
+                last = last->next;
+            r->push(head, last, n);
+        }
+    };
+
+    // Returns the cache of the calling thread.
+    // Only the first recycler of each type to
+    // be used on a thread gets a cache; it must
+    // outlive the thread, as the function-local
+    // static in recycled_ptr does.
+    cache*
+    local() noexcept
+    {
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+        static thread_local cache c;
+        if(! c.r)
+            c.r = this;
+        if(c.r == this)
+            return &c;
+#endif
+        return nullptr;
+    }
+
+    // push a list of n objects
+    void
+    push(
+        U* first,
+        U* last,
+        std::size_t n) noexcept
+    {
+        if( size_.fetch_add(n,
+                std::memory_order_relaxed) +
+                    n > shared_max)
+        {
+            // full, free them instead
+            size_.fetch_sub(n,
+                std::memory_order_relaxed);
+            while(first)
+            {
+                auto next = first->next;
+                delete first;
+                first = next;
+            }
+            recycler_remove(sizeof(U) * n);
+            return;
+        }
+        splice(first, last);
+    }
+
+    // link a list to the front
+    void
+    splice(
+        U* first,
+        U* last) noexcept
+    {
+        auto h = head_.load(
+            std::memory_order_relaxed);
+        for(;;)
+        {
+            last->next = h;
+            if(head_.compare_exchange_weak(
+                    h, first,
+                    std::memory_order_release,
+                    std::memory_order_relaxed))
+                return;
+            recycler_retry();
+        }
+    }
+
+    std::atomic<U*> head_{nullptr};
+    std::atomic<std::size_t> size_{0};
 };
 
 } // detail
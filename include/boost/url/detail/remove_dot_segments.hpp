@@ -11,6 +11,7 @@
 #define BOOST_URL_DETAIL_REMOVE_DOT_SEGMENTS_HPP
 
 #include <boost/url/string_view.hpp>
+#include <boost/url/detail/normalize.hpp>
 #include <cstdint>
 
 namespace boost {
@@ -24,16 +25,6 @@ remove_dot_segments(
     string_view s,
     bool remove_unmatched) noexcept;
 
-void
-pop_last_segment(
-    string_view& s,
-    string_view& c,
-    std::size_t& level,
-    bool r) noexcept;
-
-char
-path_pop_back( string_view& s );
-
 int
 normalized_path_compare(
     string_view lhs,
@@ -45,7 +36,7 @@ void
 normalized_path_digest(
     string_view s,
     bool remove_unmatched,
-    fnv_1a& hasher) noexcept;
+    block_hasher& hasher) noexcept;
 
 } // detail
 } // urls
@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_RESOLVE_HPP
+#define BOOST_URL_DETAIL_RESOLVE_HPP
+
+#include <boost/url/detail/url_impl.hpp>
+#include <boost/url/string_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+/*  Reference resolution
+
+    A resolution is split in two steps.
+    resolve_plan picks which of the base
+    and the reference supplies each part
+    of the result, as in rfc3986 5.2.2,
+    and resolve_write copies the parts
+    to the output and removes the
+    dot-segments of the path.
+
+    The part of the base path which a
+    merge keeps only depends on the base,
+    so callers resolving many references
+    against one base compute it once
+    with resolve_merge_prefix.
+*/
+
+struct resolve_plan
+{
+    url_impl const* scheme = nullptr;
+    url_impl const* auth = nullptr;
+    url_impl const* query = nullptr;
+    url_impl const* frag = nullptr;
+
+    // the path, before dot-segments
+    // are removed, is p0 followed by p1
+    string_view p0;
+    string_view p1;
+
+    // the number of characters needed
+    // by resolve_write, not counting
+    // the null terminator
+    std::size_t
+    size() const noexcept;
+};
+
+// 5.2.3. Merge Paths
+string_view
+resolve_merge_prefix(
+    url_impl const& base) noexcept;
+
+// base must have a scheme, and merge
+// is resolve_merge_prefix(base)
+void
+resolve_plan_init(
+    resolve_plan& p,
+    url_impl const& base,
+    string_view merge,
+    url_impl const& ref) noexcept;
+
+// Write the result to dest, which has
+// room for p.size() plus a null, and
+// return its description. The parts in
+// the plan must not overlap dest.
+url_impl
+resolve_write(
+    char* dest,
+    resolve_plan const& p) noexcept;
+
+} // detail
+} // urls
+} // boost
+
+#endif
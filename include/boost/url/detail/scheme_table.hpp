@@ -0,0 +1,398 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_DETAIL_SCHEME_TABLE_HPP
+#define BOOST_URL_DETAIL_SCHEME_TABLE_HPP
+
+#include <boost/url/scheme.hpp>
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/mp11/integer_sequence.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+/*  Perfect hash of scheme strings
+
+    The first eight characters of a scheme
+    are loaded into one word, with letters
+    folded to lower case by setting bit 5.
+    Multiplying that word by a seed and
+    keeping the top bits gives a slot. The
+    seed is searched for at compile time,
+    so that every known scheme has its own
+    slot, and recognizing a string costs one
+    multiply and one comparison.
+
+    These are C++11 constexpr functions,
+    hence the recursion.
+*/
+
+struct scheme_info
+{
+    char const* str;
+    std::size_t len;
+    // first eight chars, letters lowered
+    std::uint64_t key;
+    // 0x20 where key has a letter
+    std::uint64_t mask;
+    scheme id;
+    std::uint16_t port;
+};
+
+constexpr
+bool
+is_scheme_alpha(char c) noexcept
+{
+    return
+        (c >= 'a' && c <= 'z') ||
+        (c >= 'A' && c <= 'Z');
+}
+
+constexpr
+std::uint64_t
+scheme_mask(
+    char const* s,
+    std::size_t n,
+    std::size_t i = 0) noexcept
+{
+    return (i == n || i == 8) ? 0 :
+        ((is_scheme_alpha(s[i]) ?
+            std::uint64_t(0x20) << (8 * i) : 0) |
+        scheme_mask(s, n, i + 1));
+}
+
+constexpr
+std::uint64_t
+scheme_key(
+    char const* s,
+    std::size_t n,
+    std::size_t i = 0) noexcept
+{
+    return (i == n || i == 8) ? 0 :
+        ((std::uint64_t(static_cast<
+            unsigned char>(s[i])) << (8 * i)) |
+        scheme_key(s, n, i + 1));
+}
+
+template<std::size_t N>
+constexpr
+scheme_info
+make_scheme_info(
+    char const(&s)[N],
+    scheme id,
+    std::uint16_t port) noexcept
+{
+    return {
+        s, N - 1,
+        scheme_key(s, N - 1) |
+            scheme_mask(s, N - 1),
+        scheme_mask(s, N - 1),
+        id, port };
+}
+
+// bit 5 set in the first n bytes
+constexpr
+std::uint64_t
+scheme_low_mask(std::size_t n) noexcept
+{
+    return n >= 8 ?
+        0x2020202020202020ull :
+        (std::uint64_t(1) << (8 * n)) / 255 * 0x20;
+}
+
+// little-endian loads, which
+// compilers turn into one mov
+inline
+std::uint32_t
+load_scheme_u32(char const* p) noexcept
+{
+    auto const u = reinterpret_cast<
+        unsigned char const*>(p);
+    return
+        std::uint32_t(u[0]) |
+        (std::uint32_t(u[1]) << 8) |
+        (std::uint32_t(u[2]) << 16) |
+        (std::uint32_t(u[3]) << 24);
+}
+
+// up to eight chars of p, the way
+// scheme_key lays them out
+inline
+std::uint64_t
+load_scheme_word(
+    char const* p,
+    std::size_t n) noexcept
+{
+    if(n >= 8)
+        return load_scheme_u32(p) | (
+            std::uint64_t(
+                load_scheme_u32(p + 4)) << 32);
+    if(n >= 4)
+        // the two loads overlap
+        return load_scheme_u32(p) | (
+            std::uint64_t(load_scheme_u32(
+                p + n - 4)) << (8 * (n - 4)));
+    auto const u = reinterpret_cast<
+        unsigned char const*>(p);
+    return
+        std::uint64_t(u[0]) |
+        (std::uint64_t(u[n / 2]) << (8 * (n / 2))) |
+        (std::uint64_t(u[n - 1]) << (8 * (n - 1)));
+}
+
+// the slot of a loaded word of n chars
+constexpr
+std::size_t
+scheme_slot(
+    std::uint64_t w,
+    std::size_t n,
+    std::uint64_t seed,
+    unsigned bits) noexcept
+{
+    return static_cast<std::size_t>(
+        (((w | scheme_low_mask(n)) + n) *
+            seed) >> (64 - bits));
+}
+
+// at most a quarter full,
+// and at least 16 slots
+constexpr
+unsigned
+scheme_bits(
+    std::size_t n,
+    unsigned b = 4) noexcept
+{
+    return (std::size_t(1) << b) >= 4 * n ?
+        b : scheme_bits(n, b + 1);
+}
+
+/*  A set of schemes
+
+    Schemes must provide
+
+        static constexpr std::size_t size;
+        static constexpr scheme_info value[size];
+*/
+template<class Schemes>
+constexpr
+std::size_t
+scheme_slot_of(
+    std::size_t i,
+    std::uint64_t seed,
+    unsigned bits) noexcept
+{
+    return scheme_slot(
+        Schemes::value[i].key,
+        Schemes::value[i].len,
+        seed, bits);
+}
+
+template<class Schemes>
+constexpr
+bool
+scheme_distinct(
+    std::uint64_t seed,
+    unsigned bits,
+    std::size_t i,
+    std::size_t j) noexcept
+{
+    return j == Schemes::size || (
+        scheme_slot_of<Schemes>(i, seed, bits) !=
+            scheme_slot_of<Schemes>(j, seed, bits) &&
+        scheme_distinct<Schemes>(
+            seed, bits, i, j + 1));
+}
+
+template<class Schemes>
+constexpr
+bool
+scheme_perfect(
+    std::uint64_t seed,
+    unsigned bits,
+    std::size_t i = 0) noexcept
+{
+    return i == Schemes::size || (
+        scheme_distinct<Schemes>(
+            seed, bits, i, i + 1) &&
+        scheme_perfect<Schemes>(
+            seed, bits, i + 1));
+}
+
+// tries odd multipliers spaced
+// by the golden ratio
+template<class Schemes>
+constexpr
+std::uint64_t
+scheme_seed(
+    unsigned bits,
+    std::uint64_t seed = 0x9e3779b97f4a7c15ull,
+    unsigned tries = 256) noexcept
+{
+    return tries == 0 ? 0 :
+        scheme_perfect<Schemes>(seed, bits) ?
+            seed : scheme_seed<Schemes>(bits,
+                seed + 0x9e3779b97f4a7c16ull,
+                tries - 1);
+}
+
+template<class Schemes>
+constexpr
+std::size_t
+scheme_max_len(std::size_t i = 0) noexcept
+{
+    return i == Schemes::size ? 0 :
+        Schemes::value[i].len >
+            scheme_max_len<Schemes>(i + 1) ?
+        Schemes::value[i].len :
+            scheme_max_len<Schemes>(i + 1);
+}
+
+// one plus the index of the
+// scheme in slot k, or zero
+template<class Schemes>
+constexpr
+unsigned char
+scheme_entry(
+    std::size_t k,
+    std::uint64_t seed,
+    unsigned bits,
+    std::size_t i = 0) noexcept
+{
+    return i == Schemes::size ? 0 :
+        scheme_slot_of<Schemes>(i, seed, bits) == k ?
+            static_cast<unsigned char>(i + 1) :
+            scheme_entry<Schemes>(k, seed, bits, i + 1);
+}
+
+template<class Schemes, class Seq>
+struct scheme_slots;
+
+template<class Schemes, std::size_t... Ks>
+struct scheme_slots<Schemes,
+    mp11::index_sequence<Ks...>>
+{
+    static constexpr unsigned bits =
+        scheme_bits(Schemes::size);
+
+    static constexpr std::uint64_t seed =
+        scheme_seed<Schemes>(bits);
+
+    static constexpr std::size_t max_len =
+        scheme_max_len<Schemes>();
+
+    static constexpr unsigned char
+        value[sizeof...(Ks)] = {
+            scheme_entry<Schemes>(
+                Ks, seed, bits)... };
+};
+
+template<class Schemes, std::size_t... Ks>
+constexpr unsigned
+scheme_slots<Schemes,
+    mp11::index_sequence<Ks...>>::bits;
+
+template<class Schemes, std::size_t... Ks>
+constexpr std::uint64_t
+scheme_slots<Schemes,
+    mp11::index_sequence<Ks...>>::seed;
+
+template<class Schemes, std::size_t... Ks>
+constexpr std::size_t
+scheme_slots<Schemes,
+    mp11::index_sequence<Ks...>>::max_len;
+
+template<class Schemes, std::size_t... Ks>
+constexpr unsigned char
+scheme_slots<Schemes,
+    mp11::index_sequence<Ks...>>::value[
+        sizeof...(Ks)];
+
+template<class Schemes>
+struct scheme_table
+{
+    using slots = scheme_slots<Schemes,
+        mp11::make_index_sequence<
+            std::size_t(1) << scheme_bits(
+                Schemes::size)>>;
+
+    static_assert(
+        Schemes::size < 255,
+        "too many schemes");
+
+    static_assert(
+        slots::seed != 0,
+        "no perfect hash for the schemes");
+
+    static
+    scheme
+    find(string_view s) noexcept
+    {
+        auto const n = s.size();
+        if(n == 0)
+            return scheme::none;
+        if(n > slots::max_len)
+            return scheme::unknown;
+        auto const w =
+            load_scheme_word(s.data(), n);
+        auto const i = slots::value[
+            scheme_slot(w, n,
+                slots::seed, slots::bits)];
+        if(i == 0)
+            return scheme::unknown;
+        auto const& e = Schemes::value[i - 1];
+        if( e.len != n ||
+            (w | e.mask) != e.key)
+            return scheme::unknown;
+        if( n > 8 &&
+            ! grammar::ci_is_equal(
+                s.substr(8),
+                string_view(
+                    e.str + 8, n - 8)))
+            return scheme::unknown;
+        return e.id;
+    }
+};
+
+//------------------------------------------------
+
+#define BOOST_URL_SCHEME_COUNT(id, str, port) + 1
+#define BOOST_URL_SCHEME_INFO(id, str, port) , \
+    make_scheme_info(str, scheme::id, port)
+
+// The built-in schemes followed by the
+// ones in BOOST_URL_USER_SCHEMES, in
+// the order of the enumeration
+struct known_schemes
+{
+    static constexpr std::size_t size = 6
+        BOOST_URL_USER_SCHEMES(
+            BOOST_URL_SCHEME_COUNT);
+
+    static constexpr scheme_info value[size] = {
+        make_scheme_info("ftp", scheme::ftp, 21),
+        make_scheme_info("file", scheme::file, 0),
+        make_scheme_info("http", scheme::http, 80),
+        make_scheme_info("https", scheme::https, 443),
+        make_scheme_info("ws", scheme::ws, 80),
+        make_scheme_info("wss", scheme::wss, 443)
+        BOOST_URL_USER_SCHEMES(
+            BOOST_URL_SCHEME_INFO) };
+};
+
+#undef BOOST_URL_SCHEME_INFO
+#undef BOOST_URL_SCHEME_COUNT
+
+} // detail
+} // urls
+} // boost
+
+#endif
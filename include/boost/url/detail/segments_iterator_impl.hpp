@@ -40,6 +40,16 @@ struct segments_iterator_impl
         std::size_t nseg,
         int) noexcept;
 
+    // construct at segment i, where
+    // 0 < i < nseg, given the offsets
+    // in s of segments i and i + 1
+    BOOST_URL_DECL
+    segments_iterator_impl(
+        string_view s,
+        std::size_t i,
+        std::size_t pos,
+        std::size_t next) noexcept;
+
     segments_iterator_impl() = default;
 
     segments_iterator_impl(
@@ -14,10 +14,16 @@
 #include <boost/url/pct_encoded_view.hpp>
 #include <boost/url/scheme.hpp>
 #include <boost/url/string_view.hpp>
+#include <boost/url/detail/link_check.hpp>
 #include <boost/url/detail/parts_base.hpp>
 #include <boost/assert.hpp>
 #include <cstdint>
 
+// the size of pos_t, which is set by
+// BOOST_URL_OFFSET_BITS, must match
+BOOST_URL_LINK_CHECK(
+    offset_bits, sizeof(pos_t))
+
 namespace boost {
 namespace urls {
 
@@ -153,7 +159,7 @@ get(int first,
     int last) const noexcept
 {
     return { cs_ + offset(first),
-        offset(last) - offset(first) };
+        len(first, last) };
 }
 
 //------------------------------------------------
@@ -29,6 +29,7 @@
 #include <boost/url/grammar/tuple_rule.hpp>
 #include <boost/url/grammar/token_rule.hpp>
 #include <boost/url/grammar/type_traits.hpp>
+#include <boost/url/grammar/typed_range_rule.hpp>
 #include <boost/url/grammar/unsigned_rule.hpp>
 #include <boost/url/grammar/variant_rule.hpp>
 
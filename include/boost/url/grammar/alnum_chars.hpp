@@ -68,8 +68,9 @@ struct alnum_chars_t
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_pred(
-            *this, first, last);
+        return detail::find_ranges<true,
+            '0', '9', 'A', 'Z', 'a', 'z'>(
+                *this, first, last);
     }
 
     char const*
@@ -77,8 +78,9 @@ struct alnum_chars_t
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_not_pred(
-            *this, first, last);
+        return detail::find_ranges<false,
+            '0', '9', 'A', 'Z', 'a', 'z'>(
+                *this, first, last);
     }
 #endif
 };
@@ -65,8 +65,9 @@ struct alpha_chars_t
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_pred(
-            *this, first, last);
+        return detail::find_ranges<true,
+            'A', 'Z', 'a', 'z'>(
+                *this, first, last);
     }
 
     char const*
@@ -74,8 +75,9 @@ struct alpha_chars_t
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_not_pred(
-            *this, first, last);
+        return detail::find_ranges<false,
+            'A', 'Z', 'a', 'z'>(
+                *this, first, last);
     }
 #endif
 };
@@ -34,6 +34,12 @@ ci_is_equal(
     string_view s0,
     string_view s1) noexcept;
 
+BOOST_URL_DECL
+bool
+ci_is_equal_lowered(
+    string_view s,
+    string_view lowered) noexcept;
+
 BOOST_URL_DECL
 bool
 ci_is_less(
@@ -193,6 +199,38 @@ ci_is_equal(
     return detail::ci_is_equal(s0, s1);
 }
 
+/** Return true if s equals a lowercase string, ignoring case
+
+    This returns true if converting `s` to
+    lowercase gives `lowered`. It is faster
+    than @ref ci_is_equal when the second
+    string is known to hold no uppercase
+    letters, such as a key which was
+    lowered ahead of time, because only
+    the first string is converted.
+    The function is defined only for strings
+    containing low-ASCII characters.
+
+    @par Example
+    @code
+    assert( ci_is_equal_lowered( "Boost", "boost" ) );
+    @endcode
+
+    @see
+        @ref ci_is_equal.
+*/
+inline
+bool
+ci_is_equal_lowered(
+    string_view s,
+    string_view lowered) noexcept
+{
+    if(s.size() != lowered.size())
+        return false;
+    return detail::ci_is_equal_lowered(
+        s, lowered);
+}
+
 /** Return true if s0 is less than s1 using case-insensitive comparison 
 
     The comparison algorithm implements a
@@ -12,6 +12,8 @@
 
 #include <boost/core/bit.hpp>
 #include <boost/type_traits/make_void.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 #ifdef BOOST_URL_USE_SSE2
@@ -22,6 +24,34 @@
 # endif
 #endif
 
+#if defined(BOOST_URL_USE_SSSE3) || \
+    defined(BOOST_URL_USE_SIMD_DISPATCH)
+# include <tmmintrin.h>
+#endif
+
+#if defined(BOOST_URL_USE_AVX2) || \
+    defined(BOOST_URL_USE_SIMD_DISPATCH)
+# include <immintrin.h>
+#endif
+
+// Kernels for instructions which the
+// target may lack are compiled for them
+// alone, and only called after checking
+// that the CPU has them
+#if defined(BOOST_URL_USE_SIMD_DISPATCH) && \
+    defined(__GNUC__)
+# ifndef BOOST_URL_USE_SSSE3
+#  define BOOST_URL_TARGET_SSSE3 __attribute__((target("ssse3")))
+# endif
+# define BOOST_URL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#ifndef BOOST_URL_TARGET_SSSE3
+# define BOOST_URL_TARGET_SSSE3
+#endif
+#ifndef BOOST_URL_TARGET_AVX2
+# define BOOST_URL_TARGET_AVX2
+#endif
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable: 4127) // conditional expression is constant
@@ -120,56 +150,324 @@ find_if_not(
 
 #ifdef BOOST_URL_USE_SSE2
 
-// by Peter Dimov
-template<class Pred>
+/*  Range classification kernel
+
+    Each pair Lo, Hi is the range of chars
+    from Lo to Hi inclusive. A char c is in
+    it when c - Lo, as an unsigned byte, is
+    no more than Hi - Lo, which SSE2 tests
+    for 16 chars with a subtraction, an
+    unsigned minimum and a comparison.
+*/
+template<char... R>
+struct in_ranges;
+
+template<>
+struct in_ranges<>
+{
+    static
+    __m128i
+    match(__m128i) noexcept
+    {
+        return _mm_setzero_si128();
+    }
+};
+
+template<char Lo, char Hi, char... R>
+struct in_ranges<Lo, Hi, R...>
+{
+    static
+    __m128i
+    match(__m128i v) noexcept
+    {
+        __m128i const d = _mm_sub_epi8(
+            v, _mm_set1_epi8(Lo));
+        __m128i const w = _mm_set1_epi8(
+            static_cast<char>(Hi - Lo));
+        return _mm_or_si128(
+            _mm_cmpeq_epi8(
+                _mm_min_epu8(d, w), d),
+            in_ranges<R...>::match(v));
+    }
+};
+
+template<bool Member, char... R, class Pred>
 char const*
-find_if_pred(
+find_ranges(
     Pred const& pred,
     char const* first,
-    char const* last ) noexcept
+    char const* last) noexcept
 {
-    while( last - first >= 16 )
+    while(last - first >= 16)
     {
-        unsigned char r[ 16 ] = {};
-        for( int i = 0; i < 16; ++i )
-            r[ i ] = pred( first[ i ] )? 0xFF: 0x00;
-        __m128i r2 = _mm_loadu_si128( (__m128i const*)r );
-        unsigned r3 = _mm_movemask_epi8( r2 );
-        if( r3 )
-            return first + boost::core::countr_zero( r3 );
+        unsigned m = static_cast<unsigned>(
+            _mm_movemask_epi8(
+                in_ranges<R...>::match(
+                    _mm_loadu_si128(reinterpret_cast<
+                        __m128i const*>(first)))));
+        if(! Member)
+            m = ~m & 0xffff;
+        if(m)
+            return first +
+                boost::core::countr_zero(m);
         first += 16;
     }
     while(
         first != last &&
-        ! pred(*first))
+        pred(*first) != Member)
     {
         ++first;
     }
     return first;
 }
 
-// by Peter Dimov
-template<class Pred>
+#endif
+
+#if defined(BOOST_URL_USE_SSSE3) || \
+    defined(BOOST_URL_USE_SIMD_DISPATCH)
+
+/*  Nibble-table membership kernels
+
+    These operate on the 32-byte table held
+    by @ref lut_chars. Byte `(c>>7)*16+(c&15)`
+    of the table has bit `(c>>4)&7` set when
+    `c` is in the set, so two PSHUFB lookups
+    on the low nibble select the row and a
+    third lookup on the high nibble selects
+    the bit, for 16 or 32 characters at once.
+
+    The block kernels stop at a match, or
+    at the first char of a partial block,
+    which the caller tests one at a time.
+*/
+
+BOOST_URL_TARGET_SSSE3
+inline
+unsigned
+lut_match_16(
+    __m128i t0,
+    __m128i t1,
+    char const* p) noexcept
+{
+    __m128i const nib = _mm_set1_epi8(0x0f);
+    __m128i const bit = _mm_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128);
+    __m128i const v = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(p));
+    __m128i const lo = _mm_and_si128(v, nib);
+    __m128i const hi = _mm_and_si128(
+        _mm_srli_epi16(v, 4), nib);
+    // 0xff in lanes holding chars >= 0x80
+    __m128i const up = _mm_cmplt_epi8(
+        v, _mm_setzero_si128());
+    __m128i const row = _mm_or_si128(
+        _mm_andnot_si128(up,
+            _mm_shuffle_epi8(t0, lo)),
+        _mm_and_si128(up,
+            _mm_shuffle_epi8(t1, lo)));
+    __m128i const b =
+        _mm_shuffle_epi8(bit, hi);
+    return static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(
+            _mm_and_si128(row, b), b)));
+}
+
+template<bool Member>
+BOOST_URL_TARGET_SSSE3
 char const*
-find_if_not_pred(
-    Pred const& pred,
+find_lut_16(
+    std::uint64_t const* table,
     char const* first,
-    char const* last ) noexcept
+    char const* last) noexcept
 {
-    while( last - first >= 16 )
+    __m128i const t0 = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(table));
+    __m128i const t1 = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(table + 2));
+    while(last - first >= 16)
     {
-        unsigned char r[ 16 ] = {};
-        for( int i = 0; i < 16; ++i )
-            r[ i ] = pred( first[ i ] )? 0x00: 0xFF;
-        __m128i r2 = _mm_loadu_si128( (__m128i const*)r );
-        unsigned r3 = _mm_movemask_epi8( r2 );
-        if( r3 )
-            return first + boost::core::countr_zero( r3 );
+        unsigned m = lut_match_16(
+            t0, t1, first);
+        if(! Member)
+            m = ~m & 0xffff;
+        if(m)
+            return first +
+                boost::core::countr_zero(m);
         first += 16;
     }
+    return first;
+}
+
+#if defined(BOOST_URL_USE_AVX2) || \
+    defined(BOOST_URL_USE_SIMD_DISPATCH)
+
+BOOST_URL_TARGET_AVX2
+inline
+unsigned
+lut_match_32(
+    __m256i t0,
+    __m256i t1,
+    char const* p) noexcept
+{
+    __m256i const nib = _mm256_set1_epi8(0x0f);
+    __m256i const bit = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128);
+    __m256i const v = _mm256_loadu_si256(
+        reinterpret_cast<__m256i const*>(p));
+    __m256i const lo = _mm256_and_si256(v, nib);
+    __m256i const hi = _mm256_and_si256(
+        _mm256_srli_epi16(v, 4), nib);
+    __m256i const up = _mm256_cmpgt_epi8(
+        _mm256_setzero_si256(), v);
+    __m256i const row = _mm256_or_si256(
+        _mm256_andnot_si256(up,
+            _mm256_shuffle_epi8(t0, lo)),
+        _mm256_and_si256(up,
+            _mm256_shuffle_epi8(t1, lo)));
+    __m256i const b =
+        _mm256_shuffle_epi8(bit, hi);
+    return static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_and_si256(row, b), b)));
+}
+
+template<bool Member>
+BOOST_URL_TARGET_AVX2
+char const*
+find_lut_32(
+    std::uint64_t const* table,
+    char const* first,
+    char const* last) noexcept
+{
+    __m128i const t0 = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(table));
+    __m128i const t1 = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(table + 2));
+    __m256i const w0 =
+        _mm256_broadcastsi128_si256(t0);
+    __m256i const w1 =
+        _mm256_broadcastsi128_si256(t1);
+    while(last - first >= 32)
+    {
+        unsigned m = lut_match_32(
+            w0, w1, first);
+        if(! Member)
+            m = ~m;
+        if(m)
+            return first +
+                boost::core::countr_zero(m);
+        first += 32;
+    }
+    return find_lut_16<Member>(
+        table, first, last);
+}
+
+#endif
+
+#ifdef BOOST_URL_USE_SIMD_DISPATCH
+
+using find_lut_fn = char const*(*)(
+    std::uint64_t const*,
+    char const*,
+    char const*);
+
+// 2 for AVX2, 1 for SSSE3, or 0
+inline
+int
+cpu_simd_level() noexcept
+{
+#if defined(_MSC_VER) && ! defined(__clang__)
+    int r[4];
+    __cpuid(r, 0);
+    int const n = r[0];
+    __cpuid(r, 1);
+    bool const ssse3 = (r[2] & (1 << 9)) != 0;
+    // the OS must save the ymm registers
+    bool const ymm =
+        (r[2] & (1 << 27)) != 0 &&
+        (_xgetbv(0) & 6) == 6;
+    bool avx2 = false;
+    if(n >= 7 && ymm)
+    {
+        __cpuidex(r, 7, 0);
+        avx2 = (r[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    bool const ssse3 =
+        __builtin_cpu_supports("ssse3");
+    bool const avx2 =
+        __builtin_cpu_supports("avx2");
+#endif
+#ifndef BOOST_URL_NO_AVX2
+    if(avx2)
+        return 2;
+#else
+    (void)avx2;
+#endif
+    if(ssse3)
+        return 1;
+    return 0;
+}
+
+// The kernel for this CPU, or nullptr,
+// chosen on the first call
+template<bool Member>
+find_lut_fn
+find_lut_kernel() noexcept
+{
+    static find_lut_fn const f = []
+    {
+        switch(cpu_simd_level())
+        {
+        case 2:
+            return static_cast<find_lut_fn>(
+                &find_lut_32<Member>);
+        case 1:
+            return static_cast<find_lut_fn>(
+                &find_lut_16<Member>);
+        default:
+            return static_cast<find_lut_fn>(
+                nullptr);
+        }
+    }();
+    return f;
+}
+
+#endif
+
+// Returns the first char whose membership
+// in the set equals `Member`
+template<bool Member, class Pred>
+char const*
+find_lut(
+    Pred const& pred,
+    std::uint64_t const* table,
+    char const* first,
+    char const* last) noexcept
+{
+    if(last - first >= 16)
+    {
+#if defined(BOOST_URL_USE_AVX2)
+        first = find_lut_32<Member>(
+            table, first, last);
+#elif defined(BOOST_URL_USE_SIMD_DISPATCH)
+        auto const f =
+            find_lut_kernel<Member>();
+        if(f)
+            first = f(table, first, last);
+#else
+        first = find_lut_16<Member>(
+            table, first, last);
+#endif
+    }
     while(
         first != last &&
-        pred(*first))
+        pred(*first) != Member)
     {
         ++first;
     }
@@ -0,0 +1,343 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_GRAMMAR_DETAIL_CI_STRING_HPP
+#define BOOST_URL_GRAMMAR_DETAIL_CI_STRING_HPP
+
+#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/detail/charset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+namespace grammar {
+namespace detail {
+
+/*  Kernels for case-insensitive strings
+
+    Letters are lowered many chars at a
+    time by setting bit 5 of every byte
+    from 'A' to 'Z'. With SSE2 this takes
+    two signed compares per 16 chars, and
+    bytes of 0x80 and above compare less
+    than 'A' so they are left alone. The
+    tails, and targets without SSE2, do
+    the same to eight chars in a word.
+
+    When one side is known to be lowered
+    already, only the other one is folded.
+*/
+
+inline
+std::uint64_t
+ci_load_word(char const* p) noexcept
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline
+std::uint32_t
+ci_load_u32(char const* p) noexcept
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// the chars of w, with letters lowered
+inline
+std::uint64_t
+ci_fold_word(std::uint64_t w) noexcept
+{
+    std::uint64_t const lo7 =
+        0x7f7f7f7f7f7f7f7full;
+    std::uint64_t const hi =
+        0x8080808080808080ull;
+    // no byte can carry into the next
+    std::uint64_t const x = w & lo7;
+    // bit 7 set where x >= 'A'
+    std::uint64_t const ge_a =
+        x + 0x3f3f3f3f3f3f3f3full;
+    // bit 7 set where x > 'Z'
+    std::uint64_t const gt_z =
+        x + 0x2525252525252525ull;
+    return w | ((
+        ge_a & ~gt_z & ~w & hi) >> 2);
+}
+
+template<bool Lowered>
+inline
+bool
+ci_word_equal(
+    std::uint64_t a,
+    std::uint64_t b) noexcept
+{
+    return a == b ||
+        ci_fold_word(a) == (Lowered ?
+            b : ci_fold_word(b));
+}
+
+#ifdef BOOST_URL_USE_SSE2
+
+inline
+__m128i
+ci_fold_16(__m128i v) noexcept
+{
+    __m128i const up = _mm_and_si128(
+        _mm_cmpgt_epi8(v,
+            _mm_set1_epi8('A' - 1)),
+        _mm_cmplt_epi8(v,
+            _mm_set1_epi8('Z' + 1)));
+    return _mm_or_si128(v, _mm_and_si128(
+        up, _mm_set1_epi8(0x20)));
+}
+
+// bit i set where the
+// chars at i differ
+template<bool Lowered>
+inline
+unsigned
+ci_mismatch_16(
+    char const* p0,
+    char const* p1) noexcept
+{
+    __m128i const a = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(p0));
+    __m128i const b = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(p1));
+    if(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(a, b)) == 0xffff)
+        return 0;
+    return ~static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(
+            ci_fold_16(a), Lowered ?
+                b : ci_fold_16(b)))) & 0xffff;
+}
+
+#endif
+
+#ifdef BOOST_URL_USE_AVX2
+
+inline
+__m256i
+ci_fold_32(__m256i v) noexcept
+{
+    __m256i const up = _mm256_and_si256(
+        _mm256_cmpgt_epi8(v,
+            _mm256_set1_epi8('A' - 1)),
+        _mm256_cmpgt_epi8(
+            _mm256_set1_epi8('Z' + 1), v));
+    return _mm256_or_si256(v, _mm256_and_si256(
+        up, _mm256_set1_epi8(0x20)));
+}
+
+template<bool Lowered>
+inline
+unsigned
+ci_mismatch_32(
+    char const* p0,
+    char const* p1) noexcept
+{
+    __m256i const a = _mm256_loadu_si256(
+        reinterpret_cast<__m256i const*>(p0));
+    __m256i const b = _mm256_loadu_si256(
+        reinterpret_cast<__m256i const*>(p1));
+    if(static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            a, b))) == 0xffffffff)
+        return 0;
+    return ~static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            ci_fold_32(a), Lowered ?
+                b : ci_fold_32(b))));
+}
+
+#endif
+
+// copy n chars, lowering letters
+inline
+void
+ci_fold(
+    char* dest,
+    char const* src,
+    std::size_t n) noexcept
+{
+#ifdef BOOST_URL_USE_AVX2
+    while(n >= 32)
+    {
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(dest),
+            ci_fold_32(_mm256_loadu_si256(
+                reinterpret_cast<
+                    __m256i const*>(src))));
+        dest += 32;
+        src += 32;
+        n -= 32;
+    }
+#endif
+#ifdef BOOST_URL_USE_SSE2
+    while(n >= 16)
+    {
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(dest),
+            ci_fold_16(_mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(src))));
+        dest += 16;
+        src += 16;
+        n -= 16;
+    }
+#endif
+    while(n >= 8)
+    {
+        auto const w = ci_fold_word(
+            ci_load_word(src));
+        std::memcpy(dest, &w, sizeof(w));
+        dest += 8;
+        src += 8;
+        n -= 8;
+    }
+    while(n--)
+        *dest++ = to_lower(*src++);
+}
+
+// true if the n chars at p0
+// and p1 are equal, ignoring case
+template<bool Lowered>
+inline
+bool
+ci_equal_n(
+    char const* p0,
+    char const* p1,
+    std::size_t n) noexcept
+{
+#ifdef BOOST_URL_USE_SSE2
+    if(n >= 16)
+    {
+        std::size_t i = 0;
+#ifdef BOOST_URL_USE_AVX2
+        for(; n - i >= 32; i += 32)
+            if(ci_mismatch_32<Lowered>(
+                    p0 + i, p1 + i))
+                return false;
+#endif
+        for(; n - i >= 16; i += 16)
+            if(ci_mismatch_16<Lowered>(
+                    p0 + i, p1 + i))
+                return false;
+        // the last load overlaps
+        return i == n ||
+            ci_mismatch_16<Lowered>(
+                p0 + n - 16,
+                p1 + n - 16) == 0;
+    }
+#else
+    for(; n > 8; n -= 8)
+    {
+        if(! ci_word_equal<Lowered>(
+                ci_load_word(p0),
+                ci_load_word(p1)))
+            return false;
+        p0 += 8;
+        p1 += 8;
+    }
+#endif
+    if(n >= 8)
+        return
+            ci_word_equal<Lowered>(
+                ci_load_word(p0),
+                ci_load_word(p1)) &&
+            ci_word_equal<Lowered>(
+                ci_load_word(p0 + n - 8),
+                ci_load_word(p1 + n - 8));
+    if(n >= 4)
+        return
+            ci_word_equal<Lowered>(
+                ci_load_u32(p0),
+                ci_load_u32(p1)) &&
+            ci_word_equal<Lowered>(
+                ci_load_u32(p0 + n - 4),
+                ci_load_u32(p1 + n - 4));
+    while(n--)
+    {
+        auto const c0 = to_lower(*p0++);
+        auto const c1 = *p1++;
+        if(c0 != (Lowered ?
+                c1 : to_lower(c1)))
+            return false;
+    }
+    return true;
+}
+
+// the index of the first of the
+// n chars at p0 and p1 which
+// differ ignoring case, or n
+inline
+std::size_t
+ci_mismatch(
+    char const* p0,
+    char const* p1,
+    std::size_t n) noexcept
+{
+    std::size_t i = 0;
+#ifdef BOOST_URL_USE_AVX2
+    for(; n - i >= 32; i += 32)
+    {
+        auto const m = ci_mismatch_32<
+            false>(p0 + i, p1 + i);
+        if(m)
+            return i +
+                boost::core::countr_zero(m);
+    }
+#endif
+#ifdef BOOST_URL_USE_SSE2
+    for(; n - i >= 16; i += 16)
+    {
+        auto const m = ci_mismatch_16<
+            false>(p0 + i, p1 + i);
+        if(m)
+            return i +
+                boost::core::countr_zero(m);
+    }
+    if(i != 0 && i != n)
+    {
+        // the last load overlaps
+        // chars known to be equal
+        i = n - 16;
+        auto const m = ci_mismatch_16<
+            false>(p0 + i, p1 + i);
+        if(m)
+            return i +
+                boost::core::countr_zero(m);
+        return n;
+    }
+#endif
+    for(; n - i >= 8; i += 8)
+        if(! ci_word_equal<false>(
+                ci_load_word(p0 + i),
+                ci_load_word(p1 + i)))
+            break;
+    while(
+        i != n &&
+        to_lower(p0[i]) ==
+            to_lower(p1[i]))
+        ++i;
+    return i;
+}
+
+} // detail
+} // grammar
+} // urls
+} // boost
+
+#endif
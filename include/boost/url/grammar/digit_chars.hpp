@@ -60,8 +60,9 @@ struct digit_chars_t
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_pred(
-            *this, first, last);
+        return detail::find_ranges<true,
+            '0', '9'>(
+                *this, first, last);
     }
 
     char const*
@@ -69,8 +70,9 @@ struct digit_chars_t
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_not_pred(
-            *this, first, last);
+        return detail::find_ranges<false,
+            '0', '9'>(
+                *this, first, last);
     }
 #endif
 };
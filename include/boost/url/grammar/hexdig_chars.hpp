@@ -78,8 +78,9 @@ struct hexdig_chars_t
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_pred(
-            *this, first, last);
+        return detail::find_ranges<true,
+            '0', '9', 'A', 'F', 'a', 'f'>(
+                *this, first, last);
     }
 
     char const*
@@ -87,8 +88,9 @@ struct hexdig_chars_t
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_not_pred(
-            *this, first, last);
+        return detail::find_ranges<false,
+            '0', '9', 'A', 'F', 'a', 'f'>(
+                *this, first, last);
     }
 #endif
 };
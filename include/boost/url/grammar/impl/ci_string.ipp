@@ -11,6 +11,8 @@
 #define BOOST_URL_GRAMMAR_IMPL_CI_STRING_IPP
 
 #include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/grammar/detail/ci_string.hpp>
+#include <boost/url/detail/normalize.hpp>
 
 namespace boost {
 namespace urls {
@@ -20,38 +22,22 @@ namespace detail {
 
 //------------------------------------------------
 
-// https://lemire.me/blog/2020/04/30/for-case-insensitive-string-comparisons-avoid-char-by-char-functions/
-// https://github.com/lemire/Code-used-on-Daniel-Lemire-s-blog/blob/master/2020/04/30/tolower.cpp
-
 bool
 ci_is_equal(
     string_view s0,
     string_view s1) noexcept
 {
-    auto n = s0.size();
-    auto p1 = s0.data();
-    auto p2 = s1.data();
-    char a, b;
-    // fast loop
-    while(n--)
-    {
-        a = *p1++;
-        b = *p2++;
-        if(a != b)
-            goto slow;
-    }
-    return true;
-slow:
-    do
-    {
-        if( to_lower(a) !=
-            to_lower(b))
-            return false;
-        a = *p1++;
-        b = *p2++;
-    }
-    while(n--);
-    return true;
+    return ci_equal_n<false>(
+        s0.data(), s1.data(), s0.size());
+}
+
+bool
+ci_is_equal_lowered(
+    string_view s,
+    string_view lowered) noexcept
+{
+    return ci_equal_n<true>(
+        s.data(), lowered.data(), s.size());
 }
 
 //------------------------------------------------
@@ -61,17 +47,14 @@ ci_is_less(
     string_view s0,
     string_view s1) noexcept
 {
-    auto p1 = s0.data();
-    auto p2 = s1.data();
-    for(auto n = s0.size();n--;)
-    {
-        auto c1 = to_lower(*p1++);
-        auto c2 = to_lower(*p2++);
-        if(c1 != c2)
-            return c1 < c2;
-    }
-    // equal
-    return false;
+    auto const n = s0.size();
+    auto const i = ci_mismatch(
+        s0.data(), s1.data(), n);
+    if(i == n)
+        return false;
+    return
+        to_lower(s0[i]) <
+        to_lower(s1[i]);
 }
 
 } // detail
@@ -100,51 +83,72 @@ ci_compare(
             bias = 0;
         n = s1.size();
     }
-    auto it0 = s0.data();
-    auto it1 = s1.data();
-    while(n--)
-    {
-        auto c0 =
-            to_lower(*it0++);
-        auto c1 =
-            to_lower(*it1++);
-        if(c0 == c1)
-            continue;
-        if(c0 < c1)
-            return -1;
-        return 1;
-    }
-    return bias;
+    auto const i = detail::ci_mismatch(
+        s0.data(), s1.data(), n);
+    if(i == n)
+        return bias;
+    if( to_lower(s0[i]) <
+        to_lower(s1[i]))
+        return -1;
+    return 1;
 }
 
 //------------------------------------------------
 
+// Letters are lowered eight at a time and
+// the words are mixed sixteen chars per
+// multiply. The last sixteen or fewer are
+// read with loads which may overlap.
 std::size_t
 ci_digest(
     string_view s) noexcept
 {
-    // Only 4 and 8 byte sizes are supported
-    static_assert(
-        sizeof(std::size_t) == 4 ||
-        sizeof(std::size_t) == 8, "");
-    constexpr std::size_t prime = (
-        sizeof(std::size_t) == 8) ?
-            0x100000001B3ULL :
-            0x01000193UL;
-    constexpr std::size_t hash0 = (
-        sizeof(std::size_t) == 8) ?
-            0xcbf29ce484222325ULL :
-            0x811C9DC5UL;
-    auto hash = hash0;
+    using urls::detail::hash_mum;
+    std::uint64_t const k1 =
+        0xe7037ed1a0b428dbull;
     auto p = s.data();
     auto n = s.size();
-    for(;n--;++p)
+    std::uint64_t h = 0xa0761d6478bd642full;
+    for(; n > 16; n -= 16, p += 16)
+        h = hash_mum(
+            detail::ci_fold_word(
+                detail::ci_load_word(p)) ^ k1,
+            detail::ci_fold_word(
+                detail::ci_load_word(p + 8)) ^ h);
+    std::uint64_t a;
+    std::uint64_t b;
+    if(n >= 8)
+    {
+        a = detail::ci_load_word(p);
+        b = detail::ci_load_word(p + n - 8);
+    }
+    else if(n >= 4)
+    {
+        a = detail::ci_load_u32(p);
+        b = detail::ci_load_u32(p + n - 4);
+    }
+    else if(n > 0)
+    {
+        auto const u = reinterpret_cast<
+            unsigned char const*>(p);
+        a = (std::uint64_t(u[0]) << 16) |
+            (std::uint64_t(u[n / 2]) << 8) |
+            u[n - 1];
+        b = 0;
+    }
+    else
     {
-        // VFALCO NOTE Consider using a lossy
-        // to_lower which works 4 or 8 chars at a time.
-        hash = (to_lower(*p) ^ hash) * prime;
+        a = 0;
+        b = 0;
     }
-    return hash;
+    h = hash_mum(
+        detail::ci_fold_word(a) ^ k1,
+        detail::ci_fold_word(b) ^ h);
+    h = hash_mum(
+        h ^ 0x8ebc6af09c88c6e3ull,
+        s.size() ^ 0x589965cc75374cc3ull);
+    return static_cast<std::size_t>(
+        h ^ (h >> 32));
 }
 
 } // grammar
@@ -0,0 +1,296 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_GRAMMAR_IMPL_TYPED_RANGE_RULE_HPP
+#define BOOST_URL_GRAMMAR_IMPL_TYPED_RANGE_RULE_HPP
+
+#include <boost/url/grammar/error.hpp>
+#include <boost/assert.hpp>
+#include <utility>
+
+namespace boost {
+namespace urls {
+namespace grammar {
+
+namespace detail {
+
+// Match elements with the rules, calling
+// f with each one, and return how many
+// there were. As with range_rule, the
+// input is rewound to the end of the
+// last element unless the rule returned
+// error::end.
+template<
+    class R0, class R1, class F>
+result<std::size_t>
+parse_range(
+    char const*& it,
+    char const* end,
+    range_rules<R0, R1> const& r,
+    std::size_t N,
+    std::size_t M,
+    F const& f)
+{
+    std::size_t n = 0;
+    auto it1 = it;
+    auto rv = (grammar::parse)(
+        it, end, r.first());
+    while(! rv.has_error())
+    {
+        if(n == M)
+        {
+            // too many
+            return error::syntax;
+        }
+        f(std::move(*rv));
+        ++n;
+        it1 = it;
+        rv = (grammar::parse)(
+            it, end, r.next());
+    }
+    if(rv.error() != error::end)
+    {
+        // rewind unless error::end
+        it = it1;
+    }
+    if(n < N)
+    {
+        // too few
+        return error::syntax;
+    }
+    return n;
+}
+
+template<class T>
+struct range_ignore
+{
+    void
+    operator()(T&&) const noexcept
+    {
+    }
+};
+
+template<class T>
+struct range_push_back
+{
+    std::vector<T>& v;
+
+    void
+    operator()(T&& t) const
+    {
+        v.push_back(std::move(t));
+    }
+};
+
+} // detail
+
+//------------------------------------------------
+//
+// iterator
+//
+//------------------------------------------------
+
+template<class R0, class R1>
+class typed_range<R0, R1>::
+    iterator
+{
+public:
+    using value_type =
+        typename R0::value_type;
+    using reference =
+        value_type const&;
+    using pointer = void const*;
+    using difference_type =
+        std::ptrdiff_t;
+    using iterator_category =
+        std::forward_iterator_tag;
+
+    iterator() = default;
+    iterator(
+        iterator const&) = default;
+    iterator& operator=(
+        iterator const&) = default;
+
+    reference
+    operator*() const noexcept
+    {
+        return rv_.value();
+    }
+
+    bool
+    operator==(
+        iterator const& other) const noexcept
+    {
+        // can't compare iterators
+        // from different containers!
+        BOOST_ASSERT(r_ == other.r_);
+
+        return p_ == other.p_;
+    }
+
+    bool
+    operator!=(
+        iterator const& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    iterator&
+    operator++() noexcept
+    {
+        BOOST_ASSERT(
+            p_ != nullptr);
+        rv_ = (grammar::parse)(
+            p_, end_, r_->rules().next());
+        if(rv_.has_error())
+            p_ = nullptr;
+        return *this;
+    }
+
+    iterator
+    operator++(int) noexcept
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+private:
+    friend class typed_range;
+
+    typed_range const* r_ = nullptr;
+    char const* p_ = nullptr;
+    char const* end_ = nullptr;
+    result<value_type> rv_;
+
+    explicit
+    iterator(
+        typed_range const& r) noexcept
+        : r_(&r)
+        , p_(r.s_.data())
+        , end_(r.s_.data() + r.s_.size())
+    {
+        rv_ = (grammar::parse)(
+            p_, end_, r_->rules().first());
+        if(rv_.has_error())
+            p_ = nullptr;
+    }
+
+    iterator(
+        typed_range const& r,
+        int) noexcept
+        : r_(&r)
+    {
+    }
+};
+
+//------------------------------------------------
+
+template<class R0, class R1>
+typed_range<R0, R1>::
+~typed_range()
+{
+    rules().~rules_type();
+}
+
+template<class R0, class R1>
+typed_range<R0, R1>::
+typed_range(
+    typed_range const& other) noexcept
+    : s_(other.s_)
+    , n_(other.n_)
+{
+    ::new(buf_) rules_type(
+        other.rules());
+}
+
+template<class R0, class R1>
+auto
+typed_range<R0, R1>::
+operator=(
+    typed_range const& other) noexcept ->
+        typed_range&
+{
+    if(this == &other)
+        return *this;
+    rules().~rules_type();
+    ::new(buf_) rules_type(
+        other.rules());
+    s_ = other.s_;
+    n_ = other.n_;
+    return *this;
+}
+
+template<class R0, class R1>
+auto
+typed_range<R0, R1>::
+begin() const noexcept ->
+    iterator
+{
+    return iterator(*this);
+}
+
+template<class R0, class R1>
+auto
+typed_range<R0, R1>::
+end() const noexcept ->
+    iterator
+{
+    return iterator(*this, 0);
+}
+
+//------------------------------------------------
+
+template<class R0, class R1>
+auto
+typed_range_rule_t<R0, R1>::
+parse(
+    char const*& it,
+    char const* end) const ->
+        result<value_type>
+{
+    auto const it0 = it;
+    auto rv = detail::parse_range(
+        it, end, r_, N_, M_,
+        detail::range_ignore<
+            typename R0::value_type>{});
+    if(! rv)
+        return rv.error();
+    return value_type(
+        string_view(it0, it - it0),
+            *rv, r_);
+}
+
+//------------------------------------------------
+
+template<class R0, class R1>
+auto
+cached_range_rule_t<R0, R1>::
+parse(
+    char const*& it,
+    char const* end) const ->
+        result<value_type>
+{
+    auto const it0 = it;
+    value_type t;
+    auto rv = detail::parse_range(
+        it, end, r_, N_, M_,
+        detail::range_push_back<
+            typename R0::value_type>{t.v_});
+    if(! rv)
+        return rv.error();
+    t.s_ = string_view(it0, it - it0);
+    return t;
+}
+
+} // grammar
+} // urls
+} // boost
+
+#endif
@@ -64,6 +64,9 @@ struct is_pred<T, boost::void_t<
 */
 class lut_chars
 {
+    // Laid out as the nibble table used by
+    // the SIMD kernels: byte (c>>7)*16+(c&15)
+    // holds bit (c>>4)&7 for each char c.
     std::uint64_t mask_[4] = {};
 
     constexpr
@@ -71,8 +74,11 @@ class lut_chars
     std::uint64_t
     lo(char c) noexcept
     {
-        return static_cast<
-            unsigned char>(c) & 3;
+        return
+            ((static_cast<
+                unsigned char>(c) >> 7) << 1) |
+            ((static_cast<
+                unsigned char>(c) >> 3) & 1);
     }
 
     constexpr
@@ -80,8 +86,11 @@ class lut_chars
     std::uint64_t
     hi(char c) noexcept
     {
-        return 1ULL << (static_cast<
-            unsigned char>(c) >> 2);
+        return 1ULL << (
+            ((static_cast<
+                unsigned char>(c) & 7) << 3) |
+            ((static_cast<
+                unsigned char>(c) >> 4) & 7));
     }
 
     constexpr
@@ -374,14 +383,15 @@ public:
     }
 
 #ifndef BOOST_URL_DOCS
-#ifdef BOOST_URL_USE_SSE2
+#if defined(BOOST_URL_USE_SSSE3) || \
+    defined(BOOST_URL_USE_SIMD_DISPATCH)
     char const*
     find_if(
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_pred(
-            *this, first, last);
+        return detail::find_lut<true>(
+            *this, mask_, first, last);
     }
 
     char const*
@@ -389,8 +399,8 @@ public:
         char const* first,
         char const* last) const noexcept
     {
-        return detail::find_if_not_pred(
-            *this, first, last);
+        return detail::find_lut<false>(
+            *this, mask_, first, last);
     }
 #endif
 #endif
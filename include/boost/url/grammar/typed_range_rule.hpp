@@ -0,0 +1,777 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_GRAMMAR_TYPED_RANGE_RULE_HPP
+#define BOOST_URL_GRAMMAR_TYPED_RANGE_RULE_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/string_view.hpp>
+#include <boost/url/grammar/parse.hpp>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace boost {
+namespace urls {
+namespace grammar {
+
+#ifndef BOOST_URL_DOCS
+namespace detail {
+
+// the rules of a range, where
+// R1 is void if there is only one
+template<class R0, class R1>
+struct range_rules
+{
+    R0 first_;
+    R1 next_;
+
+    constexpr
+    range_rules(
+        R0 const& first,
+        R1 const& next) noexcept
+        : first_(first)
+        , next_(next)
+    {
+    }
+
+    R0 const&
+    first() const noexcept
+    {
+        return first_;
+    }
+
+    R1 const&
+    next() const noexcept
+    {
+        return next_;
+    }
+};
+
+template<class R>
+struct range_rules<R, void>
+{
+    R next_;
+
+    constexpr
+    explicit
+    range_rules(
+        R const& next) noexcept
+        : next_(next)
+    {
+    }
+
+    R const&
+    first() const noexcept
+    {
+        return next_;
+    }
+
+    R const&
+    next() const noexcept
+    {
+        return next_;
+    }
+};
+
+} // detail
+
+template<
+    class R0,
+    class R1 = void>
+struct typed_range_rule_t;
+
+template<
+    class R0,
+    class R1 = void>
+struct cached_range_rule_t;
+#endif
+
+//------------------------------------------------
+
+/** A forward range of parsed elements, holding its rules
+
+    Objects of this type are forward ranges
+    returned when parsing using the
+    @ref typed_range_rule.
+    Like @ref range, iteration is performed
+    by re-parsing the underlying character
+    buffer. Unlike @ref range, the rules are
+    held by value with their types intact, so
+    the element parser is called directly
+    and may be inlined into the loop.
+    Ownership of the buffer is not
+    transferred; the caller is responsible
+    for ensuring that the lifetime of the
+    buffer extends until it is no longer
+    referenced by the range.
+
+    @tparam R0 The rule for the first element
+
+    @tparam R1 The rule for each subsequent
+    element, or `void` if `R0` is used for
+    every element
+
+    @see
+        @ref cached_range,
+        @ref parse,
+        @ref range,
+        @ref typed_range_rule.
+*/
+template<
+    class R0,
+    class R1 = void>
+class typed_range
+{
+    using rules_type =
+        detail::range_rules<R0, R1>;
+
+    // rules are not assignable, so they
+    // are constructed again in place
+    alignas(rules_type) unsigned char
+        buf_[sizeof(rules_type)];
+    string_view s_;
+    std::size_t n_ = 0;
+
+    friend struct typed_range_rule_t<R0, R1>;
+
+    rules_type const&
+    rules() const noexcept
+    {
+        return *reinterpret_cast<
+            rules_type const*>(buf_);
+    }
+
+    typed_range(
+        string_view s,
+        std::size_t n,
+        rules_type const& r) noexcept
+        : s_(s)
+        , n_(n)
+    {
+        ::new(buf_) rules_type(r);
+    }
+
+public:
+    /** The type of each element of the range
+    */
+    using value_type =
+        typename R0::value_type;
+
+    /** The type of each element of the range
+    */
+    using reference = value_type const&;
+
+    /** The type of each element of the range
+    */
+    using const_reference = value_type const&;
+
+    /** Provided for compatibility, unused
+    */
+    using pointer = void const*;
+
+    /** The type used to represent unsigned integers
+    */
+    using size_type = std::size_t;
+
+    /** The type used to represent signed integers
+    */
+    using difference_type = std::ptrdiff_t;
+
+    /** A constant, forward iterator to elements of the range
+    */
+    class iterator;
+
+    /** A constant, forward iterator to elements of the range
+    */
+    using const_iterator = iterator;
+
+    /** Destructor
+    */
+    ~typed_range();
+
+    /** Constructor
+    */
+    typed_range(
+        typed_range const& other) noexcept;
+
+    /** Assignment
+    */
+    typed_range&
+    operator=(
+        typed_range const& other) noexcept;
+
+    /** Return an iterator to the beginning
+    */
+    iterator begin() const noexcept;
+
+    /** Return an iterator to the end
+    */
+    iterator end() const noexcept;
+
+    /** Return the matching part of the string
+    */
+    string_view
+    string() const noexcept
+    {
+        return s_;
+    }
+
+    /** Return the number of elements in the range
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+    /** Return true if the range is empty
+    */
+    bool
+    empty() const noexcept
+    {
+        return n_ == 0;
+    }
+};
+
+//------------------------------------------------
+
+/** A random-access range of parsed elements
+
+    Objects of this type are returned when
+    parsing using the @ref cached_range_rule.
+    Each element is recorded as it is matched,
+    so iterating the range walks an array
+    instead of parsing the string again.
+    The elements may refer to the underlying
+    character buffer. Ownership of the buffer
+    is not transferred; the caller is
+    responsible for ensuring that the
+    lifetime of the buffer extends until it
+    is no longer referenced by the range.
+
+    @tparam T The value type of the range
+
+    @see
+        @ref cached_range_rule,
+        @ref parse,
+        @ref typed_range.
+*/
+template<class T>
+class cached_range
+{
+    std::vector<T> v_;
+    string_view s_;
+
+    template<class, class>
+    friend struct cached_range_rule_t;
+
+public:
+    /** The type of each element of the range
+    */
+    using value_type = T;
+
+    /** The type of each element of the range
+    */
+    using reference = T const&;
+
+    /** The type of each element of the range
+    */
+    using const_reference = T const&;
+
+    /** A pointer to an element
+    */
+    using pointer = T const*;
+
+    /** The type used to represent unsigned integers
+    */
+    using size_type = std::size_t;
+
+    /** The type used to represent signed integers
+    */
+    using difference_type = std::ptrdiff_t;
+
+    /** A constant, random-access iterator to elements of the range
+    */
+    using iterator = T const*;
+
+    /** A constant, random-access iterator to elements of the range
+    */
+    using const_iterator = T const*;
+
+    /** Constructor
+
+        Default-constructed ranges have
+        zero elements.
+    */
+    cached_range() = default;
+
+    /** Return an iterator to the beginning
+    */
+    iterator
+    begin() const noexcept
+    {
+        return v_.data();
+    }
+
+    /** Return an iterator to the end
+    */
+    iterator
+    end() const noexcept
+    {
+        return v_.data() + v_.size();
+    }
+
+    /** Return the element at index i
+
+        @par Preconditions
+        @code
+        i < size()
+        @endcode
+    */
+    T const&
+    operator[](
+        std::size_t i) const noexcept
+    {
+        return v_[i];
+    }
+
+    /** Return the matching part of the string
+    */
+    string_view
+    string() const noexcept
+    {
+        return s_;
+    }
+
+    /** Return the number of elements in the range
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return v_.size();
+    }
+
+    /** Return true if the range is empty
+    */
+    bool
+    empty() const noexcept
+    {
+        return v_.empty();
+    }
+};
+
+//------------------------------------------------
+
+/** Match a repeating number of elements, keeping the rule types
+
+    This matches the same input as
+    @ref range_rule, but the resulting
+    range holds the rules with their types
+    intact instead of erasing them, so that
+    iterating does not go through a virtual
+    call for each element.
+
+    @par Value Type
+    @code
+    using value_type = typed_range< Rule >;
+    @endcode
+
+    @par Example
+    Rules are used with the function @ref parse.
+    @code
+    // range    = 1*( ";" token )
+
+    auto rv = parse( ";alpha;xray;charlie",
+        typed_range_rule(
+            tuple_rule(
+                squelch( delim_rule( ';' ) ),
+                token_rule( alpha_chars ) ),
+            1 ) );
+    @endcode
+
+    @par BNF
+    @code
+    range        = <N>*<M>next
+    @endcode
+
+    @param next The rule to use for matching
+    each element. The range extends until this
+    rule returns an error.
+
+    @param N The minimum number of elements for
+    the range to be valid. If omitted, this
+    defaults to zero.
+
+    @param M The maximum number of elements for
+    the range to be valid. If omitted, this
+    defaults to unlimited.
+
+    @see
+        @ref cached_range_rule,
+        @ref parse,
+        @ref range_rule,
+        @ref typed_range.
+*/
+#ifdef BOOST_URL_DOCS
+template<class Rule>
+constexpr
+__implementation_defined__
+typed_range_rule(
+    Rule next,
+    std::size_t N = 0,
+    std::size_t M =
+        std::size_t(-1)) noexcept;
+
+/** Match a repeating number of elements, keeping the rule types
+
+    This matches the same input as the
+    two-rule @ref range_rule, but the
+    resulting range holds the rules with
+    their types intact.
+
+    @par Value Type
+    @code
+    using value_type = typed_range< Rule1, Rule2 >;
+    @endcode
+
+    @param first The rule to use for matching
+    the first element. If this rule returns
+    an error, the range will be empty.
+
+    @param next The rule to use for matching
+    each subsequent element. The range extends
+    until this rule returns an error.
+
+    @param N The minimum number of elements for
+    the range to be valid. If omitted, this
+    defaults to zero.
+
+    @param M The maximum number of elements for
+    the range to be valid. If omitted, this
+    defaults to unlimited.
+
+    @see
+        @ref cached_range_rule,
+        @ref parse,
+        @ref range_rule,
+        @ref typed_range.
+*/
+template<
+    class Rule1, class Rule2>
+constexpr
+__implementation_defined__
+typed_range_rule(
+    Rule1 first,
+    Rule2 next,
+    std::size_t N = 0,
+    std::size_t M =
+        std::size_t(-1)) noexcept;
+#else
+template<class R0, class R1>
+struct typed_range_rule_t
+{
+    using value_type =
+        typed_range<R0, R1>;
+
+    result<value_type>
+    parse(
+        char const*& it,
+        char const* end) const;
+
+    constexpr
+    typed_range_rule_t(
+        detail::range_rules<
+            R0, R1> const& r,
+        std::size_t N,
+        std::size_t M) noexcept
+        : r_(r)
+        , N_(N)
+        , M_(M)
+    {
+    }
+
+private:
+    detail::range_rules<R0, R1> r_;
+    std::size_t N_;
+    std::size_t M_;
+};
+
+template<class Rule>
+constexpr
+typed_range_rule_t<Rule>
+typed_range_rule(
+    Rule const& next,
+    std::size_t N = 0,
+    std::size_t M =
+        std::size_t(-1)) noexcept
+{
+    // If you get a compile error here it
+    // means that your rule does not meet
+    // the type requirements. Please check
+    // the documentation.
+    static_assert(
+        is_rule<Rule>::value,
+        "Rule requirements not met");
+
+    return typed_range_rule_t<Rule>{
+        detail::range_rules<Rule, void>(
+            next), N, M};
+}
+
+template<
+    class Rule1, class Rule2>
+constexpr
+auto
+typed_range_rule(
+    Rule1 const& first,
+    Rule2 const& next,
+    std::size_t N = 0,
+    std::size_t M =
+        std::size_t(-1)) noexcept ->
+    typename std::enable_if<
+        ! std::is_integral<Rule2>::value,
+        typed_range_rule_t<Rule1, Rule2>>::type
+{
+    // If you get a compile error here it
+    // means that your rule does not meet
+    // the type requirements. Please check
+    // the documentation.
+    static_assert(
+        is_rule<Rule1>::value,
+        "Rule requirements not met");
+    static_assert(
+        is_rule<Rule2>::value,
+        "Rule requirements not met");
+
+    // If you get a compile error here it
+    // means that your rules do not have
+    // the exact same value_type. Please
+    // check the documentation.
+    static_assert(
+        std::is_same<
+            typename Rule1::value_type,
+            typename Rule2::value_type>::value,
+        "Rule requirements not met");
+
+    return typed_range_rule_t<Rule1, Rule2>{
+        detail::range_rules<Rule1, Rule2>(
+            first, next), N, M};
+}
+#endif
+
+//------------------------------------------------
+
+/** Match a repeating number of elements, recording each one
+
+    This matches the same input as
+    @ref range_rule. Each element is stored
+    in the resulting range as it is matched,
+    so later iterations do not parse the
+    string again. This costs one allocation
+    when the range is not empty.
+
+    @par Value Type
+    @code
+    using value_type = cached_range< typename Rule::value_type >;
+    @endcode
+
+    @par Example
+    Rules are used with the function @ref parse.
+    @code
+    // range    = 1*( ";" token )
+
+    result< cached_range< string_view > > rv = parse( ";alpha;xray;charlie",
+        cached_range_rule(
+            tuple_rule(
+                squelch( delim_rule( ';' ) ),
+                token_rule( alpha_chars ) ),
+            1 ) );
+    @endcode
+
+    @par BNF
+    @code
+    range        = <N>*<M>next
+    @endcode
+
+    @param next The rule to use for matching
+    each element. The range extends until this
+    rule returns an error.
+
+    @param N The minimum number of elements for
+    the range to be valid. If omitted, this
+    defaults to zero.
+
+    @param M The maximum number of elements for
+    the range to be valid. If omitted, this
+    defaults to unlimited.
+
+    @see
+        @ref cached_range,
+        @ref parse,
+        @ref range_rule,
+        @ref typed_range_rule.
+*/
+#ifdef BOOST_URL_DOCS
+template<class Rule>
+constexpr
+__implementation_defined__
+cached_range_rule(
+    Rule next,
+    std::size_t N = 0,
+    std::size_t M =
+        std::size_t(-1)) noexcept;
+
+/** Match a repeating number of elements, recording each one
+
+    This matches the same input as the
+    two-rule @ref range_rule. Each element
+    is stored in the resulting range as it
+    is matched.
+
+    @par Value Type
+    @code
+    using value_type = cached_range< typename Rule1::value_type >;
+    @endcode
+
+    @param first The rule to use for matching
+    the first element. If this rule returns
+    an error, the range will be empty.
+
+    @param next The rule to use for matching
+    each subsequent element. The range extends
+    until this rule returns an error.
+
+    @param N The minimum number of elements for
+    the range to be valid. If omitted, this
+    defaults to zero.
+
+    @param M The maximum number of elements for
+    the range to be valid. If omitted, this
+    defaults to unlimited.
+
+    @see
+        @ref cached_range,
+        @ref parse,
+        @ref range_rule,
+        @ref typed_range_rule.
+*/
+template<
+    class Rule1, class Rule2>
+constexpr
+__implementation_defined__
+cached_range_rule(
+    Rule1 first,
+    Rule2 next,
+    std::size_t N = 0,
+    std::size_t M =
+        std::size_t(-1)) noexcept;
+#else
+template<class R0, class R1>
+struct cached_range_rule_t
+{
+    using value_type = cached_range<
+        typename R0::value_type>;
+
+    result<value_type>
+    parse(
+        char const*& it,
+        char const* end) const;
+
+    constexpr
+    cached_range_rule_t(
+        detail::range_rules<
+            R0, R1> const& r,
+        std::size_t N,
+        std::size_t M) noexcept
+        : r_(r)
+        , N_(N)
+        , M_(M)
+    {
+    }
+
+private:
+    detail::range_rules<R0, R1> r_;
+    std::size_t N_;
+    std::size_t M_;
+};
+
+template<class Rule>
+constexpr
+cached_range_rule_t<Rule>
+cached_range_rule(
+    Rule const& next,
+    std::size_t N = 0,
+    std::size_t M =
+        std::size_t(-1)) noexcept
+{
+    // If you get a compile error here it
+    // means that your rule does not meet
+    // the type requirements. Please check
+    // the documentation.
+    static_assert(
+        is_rule<Rule>::value,
+        "Rule requirements not met");
+
+    return cached_range_rule_t<Rule>{
+        detail::range_rules<Rule, void>(
+            next), N, M};
+}
+
+template<
+    class Rule1, class Rule2>
+constexpr
+auto
+cached_range_rule(
+    Rule1 const& first,
+    Rule2 const& next,
+    std::size_t N = 0,
+    std::size_t M =
+        std::size_t(-1)) noexcept ->
+    typename std::enable_if<
+        ! std::is_integral<Rule2>::value,
+        cached_range_rule_t<Rule1, Rule2>>::type
+{
+    // If you get a compile error here it
+    // means that your rule does not meet
+    // the type requirements. Please check
+    // the documentation.
+    static_assert(
+        is_rule<Rule1>::value,
+        "Rule requirements not met");
+    static_assert(
+        is_rule<Rule2>::value,
+        "Rule requirements not met");
+
+    // If you get a compile error here it
+    // means that your rules do not have
+    // the exact same value_type. Please
+    // check the documentation.
+    static_assert(
+        std::is_same<
+            typename Rule1::value_type,
+            typename Rule2::value_type>::value,
+        "Rule requirements not met");
+
+    return cached_range_rule_t<Rule1, Rule2>{
+        detail::range_rules<Rule1, Rule2>(
+            first, next), N, M};
+}
+#endif
+
+} // grammar
+} // urls
+} // boost
+
+#include <boost/url/grammar/impl/typed_range_rule.hpp>
+
+#endif
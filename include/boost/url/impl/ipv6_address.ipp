@@ -14,6 +14,7 @@
 #include <boost/url/rfc/ipv6_address_rule.hpp>
 #include <boost/url/detail/except.hpp>
 #include <boost/url/grammar/parse.hpp>
+#include <boost/core/bit.hpp>
 #include <cstring>
 
 namespace boost {
@@ -100,127 +101,124 @@ loopback() noexcept
     return a;
 }
 
+namespace detail {
+
+// two hex digits for each byte
+static constexpr char hex_byte_chars[] =
+    "000102030405060708090a0b0c0d0e0f"
+    "101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f"
+    "303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f"
+    "505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f"
+    "707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f"
+    "909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+    "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+    "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+    "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+// Write a 16-bit word in hex, without
+// leading zeros. Four chars are always
+// written, the ones past the digits are
+// overwritten by what comes next.
+static
+char*
+print_h16(
+    char* dest,
+    unsigned char hi,
+    unsigned char lo) noexcept
+{
+    char buf[8];
+    std::memcpy(buf,
+        &hex_byte_chars[2 * hi], 2);
+    std::memcpy(buf + 2,
+        &hex_byte_chars[2 * lo], 2);
+    // number of leading zero digits
+    unsigned const v = hi * 256U + lo;
+    unsigned const skip =
+        (v < 0x1000) + (v < 0x100) + (v < 0x10);
+    std::memcpy(dest, buf + skip, 4);
+    return dest + 4 - skip;
+}
+
+} // detail
+
 std::size_t
 ipv6_address::
 print_impl(
     char* dest) const noexcept
 {
-    auto const count_zeroes =
-    []( unsigned char const* first,
-        unsigned char const* const last)
-    {
-        std::size_t n = 0;
-        while(first != last)
-        {
-            if( first[0] != 0 ||
-                first[1] != 0)
-                break;
-            n += 2;
-            first += 2;
-        }
-        return n;
-    };
-    auto const print_hex =
-    []( char* dest,
-        unsigned short v)
-    {
-        char const* const dig =
-            "0123456789abcdef";
-        if(v >= 0x1000)
-        {
-            *dest++ = dig[v>>12];
-            v &= 0x0fff;
-            *dest++ = dig[v>>8];
-            v &= 0x0ff;
-            *dest++ = dig[v>>4];
-            v &= 0x0f;
-            *dest++ = dig[v];
-        }
-        else if(v >= 0x100)
-        {
-            *dest++ = dig[v>>8];
-            v &= 0x0ff;
-            *dest++ = dig[v>>4];
-            v &= 0x0f;
-            *dest++ = dig[v];
-        }
-        else if(v >= 0x10)
-        {
-            *dest++ = dig[v>>4];
-            v &= 0x0f;
-            *dest++ = dig[v];
-        }
-        else
-        {
-            *dest++ = dig[v];
-        }
-        return dest;
-    };
     auto const dest0 = dest;
-    // find longest run of zeroes
-    std::size_t best_len = 0;
-    int best_pos = -1;
-    auto it = addr_.data();
     auto const v4 =
         is_v4_mapped();
-    auto const end = v4 ?
-        (it + addr_.size() - 4)
-        : it + addr_.size();
-    while(it != end)
+    int const nw = v4 ? 6 : 8;
+
+    // find the first longest run of
+    // zero words, using a bit per word
+    unsigned zeros = 0;
+    for(int i = 0; i < nw; ++i)
+        if( addr_[2 * i] == 0 &&
+            addr_[2 * i + 1] == 0)
+            zeros |= 1U << i;
+    int best_pos = -1;
+    int best_len = 0;
+    if(zeros != 0)
     {
-        auto n = count_zeroes(
-            it, end);
-        if(n == 0)
+        // each step keeps the words which
+        // start a run one word longer
+        unsigned runs = zeros;
+        unsigned last;
+        do
         {
-            it += 2;
-            continue;
+            last = runs;
+            runs &= runs >> 1;
+            ++best_len;
         }
-        if(n > best_len)
-        {
-            best_pos = static_cast<
-                int>(it - addr_.data());
-            best_len = n;
-        }
-        it += n;
+        while(runs != 0);
+        best_pos = static_cast<int>(
+            boost::core::countr_zero(last));
     }
-    it = addr_.data();
+
+    int i = 0;
     if(best_pos != 0)
     {
-        unsigned short v =
-            (it[0] * 256U) + it[1];
-        dest = print_hex(dest, v);
-        it += 2;
+        dest = detail::print_h16(dest,
+            addr_[0], addr_[1]);
+        i = 1;
     }
     else
     {
         *dest++ = ':';
-        it += best_len;
-        if(it == end)
+        i = best_len;
+        if(i == nw)
             *dest++ = ':';
     }
-    while(it != end)
+    while(i != nw)
     {
         *dest++ = ':';
-        if(it - addr_.data() ==
-            best_pos)
+        if(i == best_pos)
         {
-            it += best_len;
-            if(it == end)
+            i += best_len;
+            if(i == nw)
                 *dest++ = ':';
             continue;
         }
-        unsigned short v =
-            (it[0] * 256U) + it[1];
-        dest = print_hex(dest, v);
-        it += 2;
+        dest = detail::print_h16(dest,
+            addr_[2 * i], addr_[2 * i + 1]);
+        ++i;
     }
     if(v4)
     {
         ipv4_address::bytes_type bytes;
-        bytes[0] = it[0];
-        bytes[1] = it[1];
-        bytes[2] = it[2];
-        bytes[3] = it[3];
+        bytes[0] = addr_[12];
+        bytes[1] = addr_[13];
+        bytes[2] = addr_[14];
+        bytes[3] = addr_[15];
         ipv4_address a(bytes);
         *dest++ = ':';
         dest += a.print_impl(dest);
@@ -228,6 +226,29 @@ print_impl(
     return dest - dest0;
 }
 
+std::size_t
+print_ipv6_addresses(
+    char* dest,
+    std::size_t dest_size,
+    ipv6_address const* src,
+    std::size_t n,
+    char sep)
+{
+    if(dest_size / (
+        ipv6_address::max_str_len + 1) < n)
+        detail::throw_length_error(
+            "print_ipv6_addresses",
+            BOOST_CURRENT_LOCATION);
+    auto const start = dest;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        dest += src[i].to_buffer(dest,
+            ipv6_address::max_str_len).size();
+        *dest++ = sep;
+    }
+    return dest - start;
+}
+
 //------------------------------------------------
 
 auto
@@ -0,0 +1,271 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_PARALLEL_PARSE_HPP
+#define BOOST_URL_IMPL_PARALLEL_PARSE_HPP
+
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+// Runs f(i) for each i in [0, n) on the
+// calling thread plus up to threads - 1
+// others. The first exception thrown
+// stops the remaining work and is
+// rethrown after every thread joins.
+template<class F>
+void
+run_parallel(
+    std::size_t n,
+    std::size_t threads,
+    F const& f)
+{
+    std::atomic<std::size_t> next(0);
+    std::exception_ptr ep;
+    std::mutex m;
+    auto const work = [&]
+    {
+        for(;;)
+        {
+            auto const i = next.fetch_add(
+                1, std::memory_order_relaxed);
+            if(i >= n)
+                return;
+            try
+            {
+                f(i);
+            }
+            catch(...)
+            {
+                std::lock_guard<
+                    std::mutex> lock(m);
+                if(! ep)
+                    ep = std::current_exception();
+                next.store(n,
+                    std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::vector<std::thread> v;
+    try
+    {
+        if(threads > n)
+            threads = n;
+        if(threads > 1)
+        {
+            v.reserve(threads - 1);
+            while(v.size() < threads - 1)
+                v.emplace_back(work);
+        }
+    }
+    catch(...)
+    {
+        next.store(n,
+            std::memory_order_relaxed);
+        for(auto& t : v)
+            t.join();
+        throw;
+    }
+    work();
+    for(auto& t : v)
+        t.join();
+    if(ep)
+        std::rethrow_exception(ep);
+}
+
+inline
+void
+parallel_parse_lines(
+    string_view s,
+    std::size_t threads,
+    any_lines_handler& h)
+{
+    if(threads == 0)
+        threads = std::thread::
+            hardware_concurrency();
+    if(threads == 0)
+        threads = 1;
+
+    // Several chunks per thread balance the
+    // load, but each is large enough that
+    // the per chunk overhead is small.
+    std::size_t const min_chunk = 64 * 1024;
+    std::size_t nchunk = 1;
+    if(threads > 1)
+        nchunk = (std::min)(
+            threads * 8,
+            s.size() / min_chunk + 1);
+
+    // each chunk ends after a line break,
+    // except the last which ends the input
+    auto const first = s.data();
+    auto const end = first + s.size();
+    std::vector<char const*> bound(nchunk + 1);
+    bound[0] = first;
+    for(std::size_t i = 1; i < nchunk; ++i)
+    {
+        auto p = first + s.size() / nchunk * i;
+        if(p < bound[i - 1])
+            p = bound[i - 1];
+        auto const nl = static_cast<
+            char const*>(std::memchr(
+                p, '\n', end - p));
+        bound[i] = nl ? nl + 1 : end;
+    }
+    bound[nchunk] = end;
+
+    // number the records of each chunk
+    std::vector<std::size_t> index(nchunk + 1);
+    run_parallel(nchunk, threads,
+        [&](std::size_t i)
+        {
+            index[i + 1] = std::count(
+                bound[i], bound[i + 1], '\n');
+        });
+    if( first != end &&
+        end[-1] != '\n')
+        ++index[nchunk];
+    for(std::size_t i = 0; i < nchunk; ++i)
+        index[i + 1] += index[i];
+    h.on_count(index[nchunk]);
+
+    run_parallel(nchunk, threads,
+        [&](std::size_t i)
+        {
+            if(bound[i] != bound[i + 1])
+                h.on_chunk(index[i], string_view(
+                    bound[i], bound[i + 1] - bound[i]));
+        });
+}
+
+//------------------------------------------------
+
+// parses each chunk directly into
+// its range of the results
+class vector_lines_handler
+    : public any_lines_handler
+{
+    std::vector<result<url_view>>& v_;
+
+public:
+    explicit
+    vector_lines_handler(
+        std::vector<result<
+            url_view>>& v) noexcept
+        : v_(v)
+    {
+    }
+
+    void
+    on_count(std::size_t n) override
+    {
+        v_.resize(n);
+    }
+
+    void
+    on_chunk(
+        std::size_t index,
+        string_view chunk) override
+    {
+        auto const n = static_cast<
+            std::size_t>(-1);
+        parse_uri_reference_lines(
+            chunk, v_.data() + index, n);
+        BOOST_ASSERT(chunk.empty());
+    }
+};
+
+} // detail
+
+inline
+std::vector<result<url_view>>
+parallel_parse_uri_reference_lines(
+    string_view s,
+    std::size_t threads)
+{
+    std::vector<result<url_view>> v;
+    detail::vector_lines_handler h(v);
+    detail::parallel_parse_lines(s, threads, h);
+    return v;
+}
+
+//------------------------------------------------
+
+namespace detail {
+
+template<class Handler>
+class lines_handler
+    : public any_lines_handler
+{
+    Handler& h_;
+
+public:
+    explicit
+    lines_handler(
+        Handler& h) noexcept
+        : h_(h)
+    {
+    }
+
+    void
+    on_count(std::size_t) override
+    {
+    }
+
+    void
+    on_chunk(
+        std::size_t index,
+        string_view chunk) override
+    {
+        // results are delivered in batches
+        // from storage on the stack
+        result<url_view> r[64];
+        while(! chunk.empty())
+        {
+            auto const n =
+                parse_uri_reference_lines(
+                    chunk, r, 64);
+            h_(index,
+                static_cast<result<
+                    url_view> const*>(r), n);
+            index += n;
+        }
+    }
+};
+
+} // detail
+
+template<class Handler>
+void
+parallel_parse_uri_reference_lines(
+    string_view s,
+    std::size_t threads,
+    Handler&& h)
+{
+    detail::lines_handler<typename
+        std::remove_reference<Handler>::type> lh(h);
+    detail::parallel_parse_lines(
+        s, threads, lh);
+}
+
+} // urls
+} // boost
+
+#endif
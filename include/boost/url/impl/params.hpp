@@ -42,6 +42,14 @@ class params::iterator
     {
     }
 
+    iterator(
+        string_view s,
+        std::size_t i,
+        std::size_t pos) noexcept
+        : impl_(s, i, pos)
+    {
+    }
+
     string_view
     encoded_key() const noexcept
     {
@@ -184,6 +192,26 @@ end() const noexcept ->
         u_->u_.nparam_, 0 };
 }
 
+// return an iterator to param i
+// without walking the query
+inline
+auto
+params::
+iterator_at(
+    std::size_t i) const noexcept ->
+        iterator
+{
+    if(i == 0)
+        return begin();
+    if(i == u_->u_.nparam_)
+        return end();
+    // skip the '?'
+    return iterator(
+        u_->encoded_query(), i,
+        u_->param(i).pos -
+            u_->u_.offset(id_query) - 1);
+}
+
 //------------------------------------------------
 //
 // Capacity
@@ -285,7 +313,7 @@ insert(
             first, last),
         make_plain_params_iter(
             first, last));
-    return std::next(begin(), before.impl_.i_);
+    return iterator_at(before.impl_.i_);
 }
 
 //------------------------------------------------
@@ -334,7 +362,7 @@ replace(
             first, last),
         make_plain_params_iter(
             first, last));
-    return std::next(begin(), from.impl_.i_);
+    return iterator_at(from.impl_.i_);
 }
 
 inline
@@ -383,7 +411,7 @@ emplace_at(
             &v, &v + 1),
         make_plain_params_iter(
             &v, &v + 1));
-    return std::next(begin(), pos.impl_.i_);
+    return iterator_at(pos.impl_.i_);
 }
 
 inline
@@ -408,7 +436,7 @@ emplace_at(
             &v, &v + 1),
         detail::make_enc_params_iter(
             &v, &v + 1));
-    return std::next(begin(), pos.impl_.i_);
+    return iterator_at(pos.impl_.i_);
 }
 
 inline
@@ -49,7 +49,7 @@ remove_value(
             &v, &v + 1),
         detail::make_enc_params_iter(
             &v, &v + 1));
-    return std::next(begin(), pos.impl_.i_);
+    return iterator_at(pos.impl_.i_);
 }
 
 auto
@@ -82,7 +82,7 @@ replace_value(
             &v, &v + 1),
         make_plain_value_iter(
             &v, &v + 1));
-    return std::next(begin(), pos.impl_.i_);
+    return iterator_at(pos.impl_.i_);
 }
 
 auto
@@ -108,7 +108,7 @@ erase(
         last.impl_.i_,
         detail::enc_query_iter(s),
         detail::enc_query_iter(s));
-    return std::next(begin(), first.impl_.i_);
+    return iterator_at(first.impl_.i_);
 }
 
 std::size_t
@@ -43,6 +43,14 @@ class params_encoded::iterator
     {
     }
 
+    iterator(
+        string_view s,
+        std::size_t i,
+        std::size_t pos) noexcept
+        : impl_(s, i, pos)
+    {
+    }
+
     string_view
     encoded_key() const noexcept
     {
@@ -203,6 +211,26 @@ end() const noexcept ->
         u_->u_.nparam_, 0 };
 }
 
+// return an iterator to param i
+// without walking the query
+inline
+auto
+params_encoded::
+iterator_at(
+    std::size_t i) const noexcept ->
+        iterator
+{
+    if(i == 0)
+        return begin();
+    if(i == u_->u_.nparam_)
+        return end();
+    // skip the '?'
+    return iterator(
+        u_->encoded_query(), i,
+        u_->param(i).pos -
+            u_->u_.offset(id_query) - 1);
+}
+
 //------------------------------------------------
 //
 // Capacity
@@ -304,7 +332,7 @@ insert(
             first, last),
         make_enc_params_iter(
             first, last));
-    return std::next(begin(), before.impl_.i_);
+    return iterator_at(before.impl_.i_);
 }
 
 //------------------------------------------------
@@ -353,7 +381,7 @@ replace(
             first, last),
         make_enc_params_iter(
             first, last));
-    return std::next(begin(), from.impl_.i_);
+    return iterator_at(from.impl_.i_);
 }
 
 inline
@@ -400,7 +428,7 @@ emplace_at(
             &v, &v + 1),
         make_enc_params_iter(
             &v, &v + 1));
-    return std::next(begin(), pos.impl_.i_);
+    return iterator_at(pos.impl_.i_);
 }
 
 inline
@@ -454,7 +482,7 @@ emplace_at(
             &v, &v + 1),
         make_enc_params_iter(
             &v, &v + 1));
-    return std::next(begin(), pos.impl_.i_);
+    return iterator_at(pos.impl_.i_);
 }
 
 inline
@@ -517,7 +545,7 @@ void
 params_encoded::
 pop_back() noexcept
 {
-    erase(std::next(begin(), u_->u_.nparam_ - 1));
+    erase(iterator_at(u_->u_.nparam_ - 1));
 }
 
 //------------------------------------------------
@@ -13,6 +13,7 @@
 
 #include <boost/url/params_encoded.hpp>
 #include <boost/url/url.hpp>
+#include <boost/url/detail/copied_strings.hpp>
 #include <boost/assert.hpp>
 
 namespace boost {
@@ -110,7 +111,7 @@ remove_value(
             &v, &v + 1),
         make_enc_params_iter(
             &v, &v + 1));
-    return std::next(begin(), pos.impl_.i_);
+    return iterator_at(pos.impl_.i_);
 }
 
 auto
@@ -120,10 +121,14 @@ replace_value(
     string_view value) ->
         iterator
 {
+    // the key refers to the url, which
+    // may be reallocated by the edit
+    detail::copied_strings cs(
+        u_->string());
     return emplace_at(
         pos,
-        (*pos).key,
-        value);
+        cs.maybe_copy((*pos).key),
+        cs.maybe_copy(value));
 }
 
 auto
@@ -149,7 +154,7 @@ erase(
         last.impl_.i_,
         detail::enc_query_iter(s),
         detail::enc_query_iter(s));
-    return std::next(begin(), first.impl_.i_);
+    return iterator_at(first.impl_.i_);
 }
 
 std::size_t
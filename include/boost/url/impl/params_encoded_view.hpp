@@ -25,6 +25,7 @@ class params_encoded_view::iterator
     detail::params_encoded_iterator_impl impl_;
 
     friend class params_encoded_view;
+    friend class params_index;
 
     iterator(
         string_view s,
@@ -42,6 +43,14 @@ class params_encoded_view::iterator
     {
     }
 
+    iterator(
+        string_view s,
+        std::size_t i,
+        std::size_t pos) noexcept
+        : impl_(s, i, pos)
+    {
+    }
+
     string_view
     encoded_key() const noexcept
     {
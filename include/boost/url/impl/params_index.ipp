@@ -0,0 +1,259 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_PARAMS_INDEX_IPP
+#define BOOST_URL_IMPL_PARAMS_INDEX_IPP
+
+#include <boost/url/params_index.hpp>
+#include <boost/url/url_view_base.hpp>
+#include <boost/url/detail/normalize.hpp>
+#include <boost/assert.hpp>
+
+namespace boost {
+namespace urls {
+
+/*  Each parameter has an entry. The slots
+    form an open addressed hash table, with
+    linear probing, of the first parameter
+    having each distinct key. The others are
+    chained from it in order through next.
+*/
+struct params_index::entry
+{
+    // the encoded key
+    string_view key;
+
+    // offset of the parameter
+    std::size_t pos;
+
+    // digest of the decoded key
+    std::size_t hash;
+
+    // next parameter with the same
+    // key, or the number of params
+    std::size_t next;
+
+    // last parameter with the same
+    // key, in the first one only
+    std::size_t last;
+};
+
+params_index::
+~params_index()
+{
+    delete[] e_;
+    delete[] slots_;
+}
+
+params_index::
+params_index(
+    params_encoded_view const& v)
+    : v_(v)
+{
+    build();
+}
+
+params_index::
+params_index(
+    url_view_base const& u)
+    : v_(u.encoded_params())
+{
+    build();
+}
+
+params_index::
+params_index(
+    params_index const& other)
+    : v_(other.v_)
+{
+    build();
+}
+
+params_index::
+params_index(
+    params_index&& other) noexcept
+    : v_(other.v_)
+    , e_(other.e_)
+    , slots_(other.slots_)
+    , mask_(other.mask_)
+{
+    other.v_ = {};
+    other.e_ = nullptr;
+    other.slots_ = nullptr;
+    other.mask_ = 0;
+}
+
+params_index&
+params_index::
+operator=(params_index const& other)
+{
+    if(this != &other)
+        *this = params_index(other);
+    return *this;
+}
+
+params_index&
+params_index::
+operator=(params_index&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    delete[] e_;
+    delete[] slots_;
+    v_ = other.v_;
+    e_ = other.e_;
+    slots_ = other.slots_;
+    mask_ = other.mask_;
+    other.v_ = {};
+    other.e_ = nullptr;
+    other.slots_ = nullptr;
+    other.mask_ = 0;
+    return *this;
+}
+
+//------------------------------------------------
+
+void
+params_index::
+build()
+{
+    auto const n = v_.size();
+    if(n == 0)
+        return;
+
+    // at most half full
+    std::size_t cap = 2;
+    while(cap < 2 * n)
+        cap <<= 1;
+    e_ = new entry[n];
+    try
+    {
+        slots_ = new std::size_t[cap];
+    }
+    catch(...)
+    {
+        delete[] e_;
+        e_ = nullptr;
+        throw;
+    }
+    mask_ = cap - 1;
+    for(std::size_t j = 0; j < cap; ++j)
+        slots_[j] = n;
+
+    auto const s =
+        v_.encoded_string();
+    std::size_t i = 0;
+    for(auto const& p : v_)
+    {
+        auto& e = e_[i];
+        e.key = p.key;
+        e.pos = p.key.data() - s.data();
+        if(i > 0)
+            --e.pos; // '&'
+        detail::block_hasher h(0);
+        detail::digest_encoded(e.key, h);
+        e.hash = h.digest();
+        e.next = n;
+        e.last = i;
+
+        auto j = e.hash & mask_;
+        for(;;)
+        {
+            auto const k = slots_[j];
+            if(k == n)
+            {
+                slots_[j] = i;
+                break;
+            }
+            auto& f = e_[k];
+            if( f.hash == e.hash &&
+                detail::compare_encoded(
+                    f.key, e.key) == 0)
+            {
+                e_[f.last].next = i;
+                f.last = i;
+                break;
+            }
+            j = (j + 1) & mask_;
+        }
+        ++i;
+    }
+    BOOST_ASSERT(i == n);
+}
+
+// return the index of the first
+// parameter matching the key, or
+// the number of params
+std::size_t
+params_index::
+lookup(
+    string_view key) const noexcept
+{
+    auto const n = v_.size();
+    if(n == 0)
+        return n;
+    detail::block_hasher h(0);
+    detail::digest_encoded(key, h);
+    auto const hash = h.digest();
+    auto j = hash & mask_;
+    for(;;)
+    {
+        auto const k = slots_[j];
+        if(k == n)
+            return n;
+        auto const& f = e_[k];
+        if( f.hash == hash &&
+            detail::compare_encoded(
+                f.key, key) == 0)
+            return k;
+        j = (j + 1) & mask_;
+    }
+}
+
+params_encoded_view::iterator
+params_index::
+iterator_at(
+    std::size_t i) const noexcept
+{
+    if(i == 0)
+        return v_.begin();
+    if(i == v_.size())
+        return v_.end();
+    return iterator(
+        v_.encoded_string(),
+        i, e_[i].pos);
+}
+
+std::size_t
+params_index::
+count(
+    string_view key) const noexcept
+{
+    auto const n = v_.size();
+    std::size_t c = 0;
+    for(auto i = lookup(key);
+        i != n; i = e_[i].next)
+        ++c;
+    return c;
+}
+
+auto
+params_index::
+find(
+    string_view key) const noexcept ->
+        iterator
+{
+    return iterator_at(lookup(key));
+}
+
+} // urls
+} // boost
+
+#endif
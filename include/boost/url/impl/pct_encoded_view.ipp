@@ -11,6 +11,7 @@
 #define BOOST_URL_IMPL_PCT_ENCODED_VIEW_IPP
 
 #include <boost/url/pct_encoded_view.hpp>
+#include <boost/url/detail/pct_scan.hpp>
 #include <ostream>
 
 namespace boost {
@@ -75,11 +76,24 @@ copy(
         detail::throw_invalid_argument(
             BOOST_CURRENT_LOCATION);
     std::size_t rlen = (std::min)(count, size() - pos);
-    auto first = std::next(begin(), pos);
-    auto last = std::next(first, rlen);
-    while (first != last)
-        *dest++ = *first++;
-    return rlen;
+    auto it = p_;
+    auto const end = it + n_;
+    while(pos != 0)
+    {
+        auto const p = detail::find_pct(
+            it, it + (std::min)(pos,
+                std::size_t(end - it)));
+        pos -= p - it;
+        it = p;
+        if(pos == 0)
+            break;
+        it += 3;
+        --pos;
+    }
+    return pct_decode_unchecked(
+        dest, dest + rlen,
+        string_view(it, end - it),
+        options());
 }
 
 namespace detail
@@ -17,6 +17,7 @@
 #include <boost/url/grammar/type_traits.hpp>
 #include <boost/assert.hpp>
 #include <boost/static_assert.hpp>
+#include <cstring>
 
 namespace boost {
 namespace urls {
@@ -39,79 +40,99 @@ validate_pct_encoding(
     // we can't accept plus to space if '+' is not allowed
     BOOST_ASSERT(! opt.plus_to_space || allowed('+'));
 
-    std::size_t n = 0;
-    char const* it = s.data();
-    char const* end = it + s.size();
-    while(it != end)
+    // Runs of allowed characters are found
+    // with grammar::find_if_not, which is
+    // vectorized for lut_chars. A null in
+    // the set must still be looked for.
+    bool const find_null =
+        ! opt.allow_null &&
+        allowed('\0');
+    char const* const first = s.data();
+    char const* it = first;
+    char const* const end = it + s.size();
+    std::size_t npct = 0;
+    for(;;)
     {
-        if( ! opt.allow_null &&
-            *it == '\0')
-        {
-            // null in input
-            ec = BOOST_URL_ERR(
-                error::illegal_null);
-            return n;
-        }
-        if(allowed(*it))
-        {
-            // unreserved
-            ++n;
-            ++it;
-            continue;
-        }
-        if(*it == '%')
+        auto const run =
+            grammar::find_if_not(
+                it, end, allowed);
+        if( find_null &&
+            run != it)
         {
-            // escaped
-            ++it;
-            if(end - it < 2)
-            {
-                // missing HEXDIG
-                ec = BOOST_URL_ERR(
-                    error::missing_pct_hexdig);
-                return n;
-            }
-            auto d0 = grammar::hexdig_value(it[0]);
-            auto d1 = grammar::hexdig_value(it[1]);
-            if( d0 < 0 || d1 < 0)
+            auto const z = static_cast<
+                char const*>(std::memchr(
+                    it, 0, run - it));
+            if(z)
             {
-                // expected HEXDIG
+                // null in input
                 ec = BOOST_URL_ERR(
-                    error::bad_pct_hexdig);
-                return n;
+                    error::illegal_null);
+                return z - first - 2 * npct;
             }
-            it += 2;
-            char const c = static_cast<char>(
-                ((static_cast<
-                    unsigned char>(d0) << 4) +
-                (static_cast<
-                    unsigned char>(d1))));
+        }
+        it = run;
+        if(it == end)
+            break;
+        if(*it != '%')
+        {
             if( ! opt.allow_null &&
-                c == '\0')
+                *it == '\0')
             {
-                // escaped null
+                // null in input
                 ec = BOOST_URL_ERR(
                     error::illegal_null);
-                return n;
             }
-            if( opt.non_normal_is_error &&
-                allowed(c))
+            else
             {
-                // escaped unreserved char
+                // reserved character in input
                 ec = BOOST_URL_ERR(
-                    error::non_canonical);
-                return n;
+                    error::illegal_reserved_char);
             }
-            ++n;
-            continue;
+            return it - first - 2 * npct;
         }
-        // reserved character in input
-        ec = BOOST_URL_ERR(
-            error::illegal_reserved_char);
-        return n;
+        // escaped
+        if(end - it < 3)
+        {
+            // missing HEXDIG
+            ec = BOOST_URL_ERR(
+                error::missing_pct_hexdig);
+            return it - first - 2 * npct;
+        }
+        auto d0 = grammar::hexdig_value(it[1]);
+        auto d1 = grammar::hexdig_value(it[2]);
+        if( d0 < 0 || d1 < 0)
+        {
+            // expected HEXDIG
+            ec = BOOST_URL_ERR(
+                error::bad_pct_hexdig);
+            return it - first - 2 * npct;
+        }
+        char const c = static_cast<char>(
+            ((static_cast<
+                unsigned char>(d0) << 4) +
+            (static_cast<
+                unsigned char>(d1))));
+        if( ! opt.allow_null &&
+            c == '\0')
+        {
+            // escaped null
+            ec = BOOST_URL_ERR(
+                error::illegal_null);
+            return it - first - 2 * npct;
+        }
+        if( opt.non_normal_is_error &&
+            allowed(c))
+        {
+            // escaped unreserved char
+            ec = BOOST_URL_ERR(
+                error::non_canonical);
+            return it - first - 2 * npct;
+        }
+        it += 3;
+        ++npct;
     }
-    BOOST_ASSERT(it == end);
     ec = {};
-    return n;
+    return s.size() - 2 * npct;
 }
 
 //------------------------------------------------
@@ -192,7 +213,61 @@ pct_encode_bytes_impl(
     }
     return n;
 }
+
+#ifdef BOOST_URL_USE_SSSE3
+// Contiguous input is measured a run
+// of allowed characters at a time,
+// which is vectorized for lut_chars.
+// Without the lookup kernels, testing
+// each character is faster.
+template <class CharSet>
+std::size_t
+pct_encode_bytes_impl(
+    char const* it,
+    char const* const end,
+    CharSet const& allowed,
+    pct_encode_opts const& opt = {}) noexcept
+{
+    // CharSet must satisfy is_charset
+    BOOST_STATIC_ASSERT(
+        grammar::is_charset<CharSet>::value);
+
+    // If you are converting space
+    // to plus, then space should
+    // be in the list of reserved
+    // characters!
+    BOOST_ASSERT(
+        ! opt.space_to_plus ||
+        ! allowed(' '));
+
+    std::size_t n = 0;
+    for(;;)
+    {
+        auto const run =
+            grammar::find_if_not(
+                it, end, allowed);
+        n += run - it;
+        it = run;
+        if(it == end)
+            return n;
+        // escapes are often several in a row
+        do
+        {
+            if( opt.space_to_plus &&
+                *it == ' ')
+                ++n;
+            else
+                n += 3;
+            ++it;
+        }
+        while(
+            it != end &&
+            ! allowed(*it));
+    }
 }
+#endif
+
+} // detail
 
 template<class CharSet>
 std::size_t
@@ -289,6 +364,148 @@ pct_encode_impl(
     return dest - dest0;
 }
 
+#ifdef BOOST_URL_USE_SSSE3
+// Contiguous input is copied a run
+// of allowed characters at a time,
+// which is vectorized for lut_chars
+template<class CharSet>
+std::size_t
+pct_encode_impl(
+    char* dest,
+    char const* const end,
+    char const* p,
+    char const* const last,
+    CharSet const& allowed,
+    pct_encode_opts const& opt = {})
+{
+    // CharSet must satisfy is_charset
+    BOOST_STATIC_ASSERT(
+        grammar::is_charset<CharSet>::value);
+
+    // Can't have % in charset
+    BOOST_ASSERT(! allowed('%'));
+
+    // If you are converting space
+    // to plus, then space should
+    // be in the list of reserved
+    // characters!
+    BOOST_ASSERT(
+        ! opt.space_to_plus ||
+        ! allowed(' '));
+
+    static constexpr char hex[] =
+        "0123456789abcdef";
+    auto const dest0 = dest;
+    for(;;)
+    {
+        auto const run =
+            grammar::find_if_not(
+                p, last, allowed);
+        std::size_t n = run - p;
+        if(n > static_cast<std::size_t>(
+            end - dest))
+        {
+            // dest too small
+            n = end - dest;
+            std::memcpy(dest, p, n);
+            return dest + n - dest0;
+        }
+        if(n != 0)
+            std::memcpy(dest, p, n);
+        dest += n;
+        p = run;
+        if(p == last)
+            return dest - dest0;
+        // escapes are often several in a row
+        do
+        {
+            if( opt.space_to_plus &&
+                *p == ' ')
+            {
+                if(dest == end)
+                    return dest - dest0;
+                *dest++ = '+';
+                ++p;
+                continue;
+            }
+            if(end - dest < 3)
+                return dest - dest0;
+            auto const u = static_cast<
+                unsigned char>(*p);
+            dest[0] = '%';
+            dest[1] = hex[u>>4];
+            dest[2] = hex[u&0xf];
+            dest += 3;
+            ++p;
+        }
+        while(
+            p != last &&
+            ! allowed(*p));
+    }
+}
+#endif
+
+// The caller provides room for the
+// worst case, so nothing is checked
+template<class CharSet>
+std::size_t
+pct_encode_unchecked_impl(
+    char* dest,
+    char const* p,
+    char const* const last,
+    CharSet const& allowed,
+    pct_encode_opts const& opt) noexcept
+{
+    // CharSet must satisfy is_charset
+    BOOST_STATIC_ASSERT(
+        grammar::is_charset<CharSet>::value);
+
+    // Can't have % in charset
+    BOOST_ASSERT(! allowed('%'));
+
+    // If you are converting space
+    // to plus, then space should
+    // be in the list of reserved
+    // characters!
+    BOOST_ASSERT(
+        ! opt.space_to_plus ||
+        ! allowed(' '));
+
+    static constexpr char hex[] =
+        "0123456789abcdef";
+    auto const dest0 = dest;
+    for(;;)
+    {
+        auto const run =
+            grammar::find_if_not(
+                p, last, allowed);
+        if(run != p)
+            std::memcpy(dest, p, run - p);
+        dest += run - p;
+        p = run;
+        if(p == last)
+            return dest - dest0;
+        do
+        {
+            auto const u = static_cast<
+                unsigned char>(*p++);
+            if( opt.space_to_plus &&
+                u == ' ')
+            {
+                *dest++ = '+';
+                continue;
+            }
+            dest[0] = '%';
+            dest[1] = hex[u>>4];
+            dest[2] = hex[u&0xf];
+            dest += 3;
+        }
+        while(
+            p != last &&
+            ! allowed(*p));
+    }
+}
+
 } // detail
 
 template<class CharSet>
@@ -309,6 +526,22 @@ pct_encode(
         opt);
 }
 
+template<class CharSet>
+std::size_t
+pct_encode_unchecked(
+    char* dest,
+    string_view s,
+    CharSet const& allowed,
+    pct_encode_opts const& opt) noexcept
+{
+    return detail::pct_encode_unchecked_impl(
+        dest,
+        s.data(),
+        s.data() + s.size(),
+        allowed,
+        opt);
+}
+
 //------------------------------------------------
 
 template<
@@ -333,6 +566,16 @@ pct_encode_to_string(
         Allocator> r(a);
     if(s.empty())
         return r;
+    if(s.size() <= 32)
+    {
+        // short strings such as search
+        // terms are encoded in one pass,
+        // into at most 96 characters
+        r.resize(3 * s.size());
+        r.resize(pct_encode_unchecked(
+            &r[0], s, allowed, opt));
+        return r;
+    }
     auto const n =
         pct_encode_bytes(s, allowed, opt);
     r.resize(n);
@@ -11,7 +11,9 @@
 #define BOOST_URL_IMPL_PCT_ENCODING_IPP
 
 #include <boost/url/pct_encoding.hpp>
+#include <boost/url/detail/pct_scan.hpp>
 #include <boost/url/grammar/charset.hpp>
+#include <cstring>
 #include <memory>
 
 namespace boost {
@@ -25,21 +27,18 @@ pct_decode_bytes_unchecked(
     auto const end =
         it + s.size();
     std::size_t n = 0;
-    while(it < end)
+    for(;;)
     {
-        if(*it != '%')
-        {
-            // unescaped
-            ++it;
-            ++n;
-            continue;
-        }
-        if(end - it < 3)
+        auto const p =
+            detail::find_pct(it, end);
+        n += p - it;
+        if(p == end)
             return n;
-        it += 3;
+        if(end - p < 3)
+            return n;
+        it = p + 3;
         ++n;
     }
-    return n;
 }
 
 std::size_t
@@ -49,71 +48,46 @@ pct_decode_unchecked(
     string_view s,
     pct_decode_opts const& opt) noexcept
 {
-    auto const decode_hex = [](
-        char const* it)
-    {
-        auto d0 = grammar::hexdig_value(it[0]);
-        auto d1 = grammar::hexdig_value(it[1]);
-        return static_cast<char>(
-            ((static_cast<
-                unsigned char>(d0) << 4) +
-            (static_cast<
-                unsigned char>(d1))));
-    };
     auto it = s.data();
     auto const last = it + s.size();
     auto dest = dest0;
-
-    if(opt.plus_to_space)
+    for(;;)
     {
-        while(it != last)
+        // unescaped
+        auto const p = opt.plus_to_space ?
+            detail::find_pct_or(it, last, '+') :
+            detail::find_pct(it, last);
+        std::size_t n = p - it;
+        if(n > static_cast<std::size_t>(
+            end - dest))
         {
-            if(dest == end)
-            {
-                // dest too small
-                return dest - dest0;
-            }
-            if(*it == '+')
-            {
-                // plus to space
-                *dest++ = ' ';
-                ++it;
-                continue;
-            }
-            if(*it == '%')
-            {
-                // escaped
-                ++it;
-                if(last - it < 2)
-                {
-                    // missing input,
-                    // initialize output
-                    std::memset(dest,
-                        0, end - dest);
-                    return dest - dest0;
-                }
-                *dest++ = decode_hex(it);
-                it += 2;
-                continue;
-            }
-            // unescaped
-            *dest++ = *it++;
+            // dest too small
+            n = end - dest;
+            std::memcpy(dest, it, n);
+            return dest + n - dest0;
         }
-        return dest - dest0;
-    }
-
-    while(it != last)
-    {
+        if(n != 0)
+            std::memcpy(dest, it, n);
+        dest += n;
+        it = p;
+        if(it == last)
+            return dest - dest0;
         if(dest == end)
         {
             // dest too small
             return dest - dest0;
         }
-        if(*it == '%')
+        if(*it == '+')
         {
-            // escaped
+            // plus to space
+            *dest++ = ' ';
             ++it;
-            if(last - it < 2)
+            continue;
+        }
+        // escaped, often several in a row
+        do
+        {
+            if(last - it < 3)
             {
                 // missing input,
                 // initialize output
@@ -121,14 +95,15 @@ pct_decode_unchecked(
                     0, end - dest);
                 return dest - dest0;
             }
-            *dest++ = decode_hex(it);
-            it += 2;
-            continue;
+            *dest++ = detail::
+                decode_hex_unchecked(it + 1);
+            it += 3;
         }
-        // unescaped
-        *dest++ = *it++;
+        while(
+            it != last &&
+            dest != end &&
+            *it == '%');
     }
-    return dest - dest0;
 }
 
 namespace detail
@@ -139,18 +114,13 @@ validate_pct_encoding(
     error_code& ec,
     std::true_type) noexcept
 {
-    const auto is_safe = [](char c)
-    {
-        return c != '%';
-    };
-
     std::size_t pcts = 0;
     char const* it = s.data();
     char const* end = it + s.size();
-    it = grammar::find_if_not(it, end, is_safe);
+    it = find_pct(it, end);
     while (it != end)
     {
-        if (end - it < 2)
+        if (end - it < 3)
         {
             // missing HEXDIG
             ec = BOOST_URL_ERR(
@@ -167,7 +137,7 @@ validate_pct_encoding(
         }
         it += 3;
         ++pcts;
-        it = grammar::find_if_not(it, end, is_safe);
+        it = find_pct(it, end);
     }
     ec = {};
     return s.size() - pcts * 2;
@@ -179,15 +149,10 @@ validate_pct_encoding(
     error_code& ec,
     std::false_type) noexcept
 {
-    const auto is_safe = [](char c)
-    {
-        return c != '%' && c != '\0';
-    };
-
     std::size_t pcts = 0;
     char const* it = s.data();
     char const* end = it + s.size();
-    it = grammar::find_if_not(it, end, is_safe);
+    it = find_pct_or(it, end, '\0');
     while (it != end)
     {
         if (*it == '\0')
@@ -197,7 +162,7 @@ validate_pct_encoding(
                 error::illegal_null);
             return it - s.data() - pcts * 2;
         }
-        if (end - it < 2)
+        if (end - it < 3)
         {
             // missing HEXDIG
             ec = BOOST_URL_ERR(
@@ -222,7 +187,7 @@ validate_pct_encoding(
         }
         it += 3;
         ++pcts;
-        it = grammar::find_if_not(it, end, is_safe);
+        it = find_pct_or(it, end, '\0');
     }
     ec = {};
     return s.size() - pcts * 2;
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_RESOLVER_IPP
+#define BOOST_URL_IMPL_RESOLVER_IPP
+
+#include <boost/url/resolver.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/detail/copied_strings.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/url/detail/resolve.hpp>
+#include <functional>
+#include <utility>
+
+namespace boost {
+namespace urls {
+
+resolver::
+~resolver()
+{
+    delete[] buf_;
+}
+
+resolver::
+resolver(
+    url_view_base const& base)
+    : base_(base)
+{
+    if(! base_.has_scheme())
+        detail::throw_system_error(
+            error::not_a_base,
+            BOOST_CURRENT_LOCATION);
+    merge_ = detail::resolve_merge_prefix(
+        base_.u_);
+}
+
+resolver::
+resolver(
+    resolver const& other)
+    : base_(other.base_)
+    , merge_(detail::resolve_merge_prefix(
+        base_.u_))
+{
+}
+
+resolver::
+resolver(
+    resolver&& other) noexcept
+    : base_(std::move(other.base_))
+    , merge_(other.merge_)
+    , buf_(other.buf_)
+    , cap_(other.cap_)
+{
+    other.merge_ = {};
+    other.buf_ = nullptr;
+    other.cap_ = 0;
+}
+
+resolver&
+resolver::
+operator=(resolver const& other)
+{
+    if(this != &other)
+        *this = resolver(other);
+    return *this;
+}
+
+resolver&
+resolver::
+operator=(resolver&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    delete[] buf_;
+    base_ = std::move(other.base_);
+    merge_ = other.merge_;
+    buf_ = other.buf_;
+    cap_ = other.cap_;
+    other.merge_ = {};
+    other.buf_ = nullptr;
+    other.cap_ = 0;
+    return *this;
+}
+
+//------------------------------------------------
+
+void
+resolver::
+resolve(
+    url_view_base const& ref,
+    url_base& dest) const
+{
+    // ref may refer to the buffer
+    // of dest, which is overwritten
+    detail::copied_strings buf(
+        dest.string());
+    detail::url_impl r = ref.u_;
+    r.cs_ = buf.maybe_copy(
+        ref.string()).data();
+    detail::resolve_plan p;
+    detail::resolve_plan_init(
+        p, base_.u_, merge_, r);
+    dest.resolve_impl(p);
+}
+
+void
+resolver::
+resolve(
+    url_view const* src,
+    url* dest,
+    std::size_t n) const
+{
+    for(std::size_t i = 0; i < n; ++i)
+        resolve(src[i], dest[i]);
+}
+
+void
+resolver::
+resolve(
+    url_view const* src,
+    url_view* dest,
+    std::size_t n)
+{
+    // The results are written to a new
+    // buffer when they do not fit, or when
+    // a reference refers to the current
+    // one, so that the references stay
+    // valid until every result is written.
+    auto const less =
+        std::less<char const*>();
+    detail::resolve_plan p;
+    std::size_t total = 0;
+    bool overlap = false;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto const& r = src[i].u_;
+        detail::resolve_plan_init(
+            p, base_.u_, merge_, r);
+        auto const size = p.size();
+        if(size > url_view::max_size())
+            detail::throw_length_error(
+                "size > max_size",
+                BOOST_CURRENT_LOCATION);
+        total += size + 1;
+        overlap = overlap || (
+            less(r.cs_, buf_ + cap_) &&
+            less(buf_, r.cs_ + r.offset(
+                detail::url_impl::id_end)));
+    }
+    char* s = buf_;
+    std::size_t cap = cap_;
+    if( total > cap ||
+        overlap)
+    {
+        // 50% growth policy
+        cap += cap / 2;
+        if(cap < total)
+            cap = total;
+        s = new char[cap];
+    }
+    char* it = s;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        detail::resolve_plan_init(
+            p, base_.u_, merge_, src[i].u_);
+        auto const u =
+            detail::resolve_write(it, p);
+        it += u.offset(
+            detail::url_impl::id_end) + 1;
+        dest[i] = u.construct();
+    }
+    if(s != buf_)
+    {
+        delete[] buf_;
+        buf_ = s;
+        cap_ = cap;
+    }
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,509 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_ROUTER_IPP
+#define BOOST_URL_IMPL_ROUTER_IPP
+
+#include <boost/url/router.hpp>
+#include <boost/url/pct_encoding.hpp>
+#include <boost/url/url_view_base.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/url/detail/normalize.hpp>
+#include <boost/url/detail/pct_scan.hpp>
+#include <boost/url/rfc/pchars.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/*  Node 0 is the root. Each node has at most
+    one parameter child and one wildcard route.
+    The literal children of all the nodes are
+    in one open addressed hash table, with
+    linear probing, keyed by the parent and
+    the digest of the decoded segment. The
+    literal segments and parameter names are
+    kept in one string, by offset.
+*/
+struct router::impl
+{
+    static constexpr std::size_t npos =
+        std::size_t(-1);
+
+    struct node
+    {
+        // the node for a parameter
+        std::size_t param = npos;
+
+        // the route ending here
+        std::size_t route = npos;
+
+        // the route ending with a
+        // wildcard here
+        std::size_t wild = npos;
+    };
+
+    struct edge
+    {
+        std::size_t parent;
+        std::size_t child = npos;
+        std::size_t hash;
+        std::size_t pos;
+        std::size_t len;
+    };
+
+    struct name
+    {
+        std::size_t pos;
+        std::size_t len;
+    };
+
+    struct route
+    {
+        // index of the first name
+        std::size_t names;
+        std::size_t n;
+    };
+
+    std::vector<node> nodes;
+    std::vector<edge> edges;
+    std::size_t nedge = 0;
+    std::vector<route> routes;
+    std::vector<name> names;
+    std::string chars;
+
+    impl()
+        : nodes(1)
+    {
+    }
+
+    string_view
+    str(std::size_t pos,
+        std::size_t len) const noexcept
+    {
+        return string_view(
+            chars.data() + pos, len);
+    }
+
+    // FNV-1a of the decoded chars, since
+    // segments are short. The parent is
+    // mixed in at the end.
+    static
+    std::size_t
+    digest(
+        std::size_t parent,
+        string_view s) noexcept
+    {
+        std::uint64_t h =
+            0xcbf29ce484222325ULL;
+        auto it = s.data();
+        auto const end = it + s.size();
+        while(it != end)
+        {
+            unsigned char c = *it;
+            if( c == '%' &&
+                end - it >= 3)
+            {
+                c = detail::decode_hex_unchecked(
+                    it + 1);
+                it += 3;
+            }
+            else
+            {
+                ++it;
+            }
+            h = (h ^ c) * 0x100000001b3ULL;
+        }
+        return static_cast<std::size_t>(
+            detail::hash_mum(h,
+                parent ^ 0xa0761d6478bd642fULL));
+    }
+
+    // the literal child of
+    // parent for s, or npos
+    std::size_t
+    find(
+        std::size_t parent,
+        string_view s,
+        std::size_t hash) const noexcept
+    {
+        if(edges.empty())
+            return npos;
+        auto const mask = edges.size() - 1;
+        for(auto i = hash & mask;;
+            i = (i + 1) & mask)
+        {
+            auto const& e = edges[i];
+            if(e.child == npos)
+                return npos;
+            if( e.hash != hash ||
+                e.parent != parent)
+                continue;
+            // usually the same
+            // escapes, if any
+            auto const t = str(e.pos, e.len);
+            if( t == s ||
+                detail::compare_encoded(
+                    t, s) == 0)
+                return e.child;
+        }
+    }
+
+    void
+    put(edge const& e) noexcept
+    {
+        auto const mask = edges.size() - 1;
+        auto i = e.hash & mask;
+        while(edges[i].child != npos)
+            i = (i + 1) & mask;
+        edges[i] = e;
+    }
+
+    // at most half full
+    void
+    reserve_edge()
+    {
+        if(2 * (nedge + 1) <= edges.size())
+            return;
+        std::vector<edge> v(
+            edges.empty() ? 16 :
+                2 * edges.size());
+        v.swap(edges);
+        for(auto const& e : v)
+            if(e.child != npos)
+                put(e);
+    }
+
+    // the literal child of parent
+    // for s, added if needed
+    std::size_t
+    child(
+        std::size_t parent,
+        string_view s)
+    {
+        auto const hash = digest(parent, s);
+        auto i = find(parent, s, hash);
+        if(i != npos)
+            return i;
+        reserve_edge();
+        edge e;
+        e.parent = parent;
+        e.child = nodes.size();
+        e.hash = hash;
+        e.pos = chars.size();
+        e.len = s.size();
+        nodes.emplace_back();
+        chars.append(s.data(), s.size());
+        put(e);
+        ++nedge;
+        return e.child;
+    }
+
+    // match the segments [it, end) from
+    // node i, having found k parameters.
+    // pos is the end of the last segment.
+    bool
+    match(
+        std::size_t i,
+        segments_encoded_view::iterator it,
+        segments_encoded_view::iterator end,
+        char const* pos,
+        std::size_t k,
+        string_view* v,
+        std::size_t& id) const noexcept
+    {
+        auto const& n = nodes[i];
+        if(it == end)
+        {
+            if(n.route != npos)
+            {
+                id = n.route;
+                return true;
+            }
+            if(n.wild != npos)
+            {
+                v[k] = string_view(
+                    pos, std::size_t(0));
+                id = n.wild;
+                return true;
+            }
+            return false;
+        }
+        auto const s = *it;
+        auto next = it;
+        ++next;
+        auto const c = find(
+            i, s, digest(i, s));
+        if( c != npos &&
+            match(c, next, end,
+                s.data() + s.size(),
+                k, v, id))
+            return true;
+        if(n.param != npos)
+        {
+            v[k] = s;
+            if(match(n.param, next, end,
+                    s.data() + s.size(),
+                    k + 1, v, id))
+                return true;
+        }
+        if(n.wild != npos)
+        {
+            // the rest of the path
+            auto last = s;
+            for(; next != end; ++next)
+                last = *next;
+            v[k] = string_view(s.data(),
+                last.data() + last.size() -
+                    s.data());
+            id = n.wild;
+            return true;
+        }
+        return false;
+    }
+};
+
+// a segment of the form "{name}"
+static
+bool
+is_param(string_view s) noexcept
+{
+    return
+        s.size() >= 2 &&
+        s.front() == '{' &&
+        s.back() == '}';
+}
+
+//------------------------------------------------
+
+string_view
+route_match::
+name(std::size_t i) const noexcept
+{
+    auto const& r = *r_->impl_;
+    auto const& e = r.names[
+        r.routes[id_].names + i];
+    return r.str(e.pos, e.len);
+}
+
+std::size_t
+route_match::
+find(string_view name) const noexcept
+{
+    std::size_t i = 0;
+    for(; i < n_; ++i)
+        if(this->name(i) == name)
+            break;
+    return i;
+}
+
+//------------------------------------------------
+
+router::
+~router()
+{
+    delete impl_;
+}
+
+router::
+router(router const& other)
+    : impl_(other.impl_ ?
+        new impl(*other.impl_) : nullptr)
+{
+}
+
+router::
+router(router&& other) noexcept
+    : impl_(other.impl_)
+{
+    other.impl_ = nullptr;
+}
+
+router&
+router::
+operator=(router const& other)
+{
+    if(this != &other)
+        *this = router(other);
+    return *this;
+}
+
+router&
+router::
+operator=(router&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    delete impl_;
+    impl_ = other.impl_;
+    other.impl_ = nullptr;
+    return *this;
+}
+
+std::size_t
+router::
+size() const noexcept
+{
+    if(! impl_)
+        return 0;
+    return impl_->routes.size();
+}
+
+std::size_t
+router::
+insert(string_view pattern)
+{
+    // split as parse_path does
+    auto s = pattern;
+    if( ! s.empty() &&
+        s.front() == '/')
+        s.remove_prefix(1);
+    std::vector<string_view> segs;
+    if(! s.empty())
+    {
+        for(;;)
+        {
+            auto const p = s.find('/');
+            segs.push_back(s.substr(0, p));
+            if(p == string_view::npos)
+                break;
+            s.remove_prefix(p + 1);
+        }
+    }
+
+    // check the pattern before changing
+    // anything, for the strong guarantee
+    std::size_t nparam = 0;
+    for(std::size_t j = 0; j < segs.size(); ++j)
+    {
+        if(is_param(segs[j]))
+        {
+            ++nparam;
+        }
+        else if(segs[j] == "*")
+        {
+            if(j + 1 != segs.size())
+                detail::throw_invalid_argument(
+                    "router: '*' is not last",
+                    BOOST_CURRENT_LOCATION);
+            ++nparam;
+        }
+        else
+        {
+            // literals are compared as if
+            // decoded, which needs valid
+            // escapes
+            error_code ec;
+            validate_pct_encoding(
+                segs[j], ec, pchars, {});
+            if(ec.failed())
+                detail::throw_invalid_argument(
+                    "router: bad segment",
+                    BOOST_CURRENT_LOCATION);
+        }
+    }
+    if(nparam > route_match::max_params)
+        detail::throw_length_error(
+            "router: too many params",
+            BOOST_CURRENT_LOCATION);
+    if(! impl_)
+        impl_ = new impl;
+    auto& r = *impl_;
+    r.routes.reserve(r.routes.size() + 1);
+    r.names.reserve(r.names.size() + nparam);
+
+    // nodes added here, before an exception,
+    // have no routes and do not match anything
+    std::size_t i = 0;
+    bool const wild =
+        ! segs.empty() &&
+        segs.back() == "*";
+    auto const n = segs.size() -
+        (wild ? 1 : 0);
+    for(std::size_t j = 0; j < n; ++j)
+    {
+        if(! is_param(segs[j]))
+        {
+            i = r.child(i, segs[j]);
+            continue;
+        }
+        if(r.nodes[i].param == impl::npos)
+        {
+            r.nodes.emplace_back();
+            r.nodes[i].param =
+                r.nodes.size() - 1;
+        }
+        i = r.nodes[i].param;
+    }
+    auto& slot = wild ?
+        r.nodes[i].wild :
+        r.nodes[i].route;
+    if(slot != impl::npos)
+        detail::throw_invalid_argument(
+            "router: duplicate route",
+            BOOST_CURRENT_LOCATION);
+
+    impl::route rt;
+    rt.names = r.names.size();
+    rt.n = nparam;
+    for(auto const& seg : segs)
+    {
+        auto name = seg;
+        if(is_param(seg))
+            name = seg.substr(1, seg.size() - 2);
+        else if(seg != "*")
+            continue;
+        r.names.push_back({
+            r.chars.size(), name.size()});
+        r.chars.append(
+            name.data(), name.size());
+    }
+    auto const id = r.routes.size();
+    slot = id;
+    r.routes.push_back(rt);
+    return id;
+}
+
+bool
+router::
+match(
+    url_view_base const& u,
+    route_match& m) const noexcept
+{
+    return match(
+        u.encoded_segments(), m);
+}
+
+bool
+router::
+match(
+    segments_encoded_view const& path,
+    route_match& m) const noexcept
+{
+    if(! impl_)
+        return false;
+    auto const it = path.begin();
+    auto const end = path.end();
+    std::size_t id;
+    if(! impl_->match(0, it, end,
+            it != end ? (*it).data() : nullptr,
+            0, m.v_, id))
+        return false;
+    m.r_ = this;
+    m.id_ = id;
+    m.n_ = impl_->routes[id].n;
+    return true;
+}
+
+} // urls
+} // boost
+
+#endif
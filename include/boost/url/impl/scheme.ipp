@@ -11,100 +11,61 @@
 #define BOOST_URL_IMPL_SCHEME_IPP
 
 #include <boost/url/scheme.hpp>
-#include <boost/url/grammar/ci_string.hpp>
+#include <boost/url/detail/scheme_table.hpp>
 
 namespace boost {
 namespace urls {
 
-scheme
-string_to_scheme(
-    string_view s) noexcept
-{
-    using grammar::to_lower;
-    switch(s.size())
-    {
-    case 0: // none
-        return scheme::none;
-
-    case 2: // ws
-        if( to_lower(s[0]) == 'w' &&
-            to_lower(s[1]) == 's')
-            return scheme::ws;
-        break;
-
-    case 3:
-        switch(to_lower(s[0]))
-        {
-        case 'w': // wss
-            if( to_lower(s[1]) == 's' &&
-                to_lower(s[2]) == 's')
-                return scheme::wss;
-            break;
-
-        case 'f': // ftp
-            if( to_lower(s[1]) == 't' &&
-                to_lower(s[2]) == 'p')
-                return scheme::ftp;
-            break;
-
-        default:
-            break;
-        }
-        break;
-
-    case 4:
-        switch(to_lower(s[0]))
-        {
-        case 'f': // file
-            if( to_lower(s[1]) == 'i' &&
-                to_lower(s[2]) == 'l' &&
-                to_lower(s[3]) == 'e')
-                return scheme::file;
-            break;
+namespace detail {
 
-        case 'h': // http
-            if( to_lower(s[1]) == 't' &&
-                to_lower(s[2]) == 't' &&
-                to_lower(s[3]) == 'p')
-                return scheme::http;
-            break;
+constexpr std::size_t known_schemes::size;
+constexpr scheme_info known_schemes::value[];
 
-        default:
-            break;
-        }
-        break;
+// the entry for a known scheme
+static
+scheme_info const*
+find_scheme_info(scheme s) noexcept
+{
+    auto const i =
+        static_cast<std::size_t>(s) -
+        static_cast<std::size_t>(scheme::ftp);
+    if( s == scheme::none ||
+        s == scheme::unknown ||
+        i >= known_schemes::size)
+        return nullptr;
+    return &known_schemes::value[i];
+}
 
-    case 5: // https
-        if( to_lower(s[0]) == 'h' &&
-            to_lower(s[1]) == 't' &&
-            to_lower(s[2]) == 't' &&
-            to_lower(s[3]) == 'p' &&
-            to_lower(s[4]) == 's')
-            return scheme::https;
-        break;
+} // detail
 
-    default:
-        break;
-    }
-    return scheme::unknown;
+scheme
+string_to_scheme(
+    string_view s) noexcept
+{
+    return detail::scheme_table<
+        detail::known_schemes>::find(s);
 }
 
 string_view
 to_string(scheme s) noexcept
 {
-    switch(s)
-    {
-    case scheme::ftp:   return "ftp";
-    case scheme::file:  return "file";
-    case scheme::http:  return "http";
-    case scheme::https: return "https";
-    case scheme::ws:    return "ws";
-    case scheme::wss:   return "wss";
-    case scheme::none:  return {};
-    default:
-        break;
-    }
-    return "<unknown>";
+    if(s == scheme::none)
+        return {};
+    auto const e =
+        detail::find_scheme_info(s);
+    if(! e)
+        return "<unknown>";
+    return { e->str, e->len };
+}
+
+std::uint16_t
+default_port(scheme s) noexcept
+{
+    auto const e =
+        detail::find_scheme_info(s);
+    if(! e)
+        return 0;
+    return e->port;
 }
 
 } // urls
@@ -49,6 +49,15 @@ class segments::iterator
     {
     }
 
+    iterator(
+        string_view s,
+        std::size_t i,
+        std::size_t pos,
+        std::size_t next) noexcept
+        : impl_(s, i, pos, next)
+    {
+    }
+
 public:
     using value_type = std::string;
     using reference = pct_encoded_view;
@@ -212,6 +221,27 @@ end() const noexcept ->
         u_->encoded_path(), u_->u_.nseg_, 0);
 }
 
+// return an iterator to segment i
+// without walking the path
+inline
+auto
+segments::
+iterator_at(
+    std::size_t i) const noexcept ->
+        iterator
+{
+    if(i == 0)
+        return begin();
+    if(i == u_->u_.nseg_)
+        return end();
+    auto const p =
+        u_->u_.offset(id_path);
+    return iterator(
+        u_->encoded_path(), i,
+        u_->segment(i) - p,
+        u_->segment(i + 1) - p);
+}
+
 //------------------------------------------------
 //
 // Capacity
@@ -301,7 +331,7 @@ insert(
             first, last),
         detail::make_plain_segs_iter(
             first, last));
-    return std::next(begin(), before.impl_.i_);
+    return iterator_at(before.impl_.i_);
 }
 
 //------------------------------------------------
@@ -355,7 +385,7 @@ replace(
     BOOST_ASSERT(from.impl_.end_ <= u_->string().data() +
         u_->string().size());
     BOOST_ASSERT(to.impl_.begin_ >= u_->string().data());
-    BOOST_ASSERT(to.impl_.end_ >= u_->string().data() +
+    BOOST_ASSERT(to.impl_.end_ <= u_->string().data() +
         u_->string().size());
     u_->edit_segments(
         from.impl_.i_,
@@ -364,7 +394,7 @@ replace(
             first, last),
         detail::make_plain_segs_iter(
             first, last));
-    return std::next(begin(), from.impl_.i_);
+    return iterator_at(from.impl_.i_);
 }
 
 //------------------------------------------------
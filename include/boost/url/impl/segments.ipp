@@ -45,7 +45,7 @@ insert(
             &s, &s + 1),
         detail::make_plain_segs_iter(
             &s, &s + 1));
-    return std::next(begin(), before.impl_.i_);
+    return iterator_at(before.impl_.i_);
 }
 
 auto
@@ -67,7 +67,7 @@ erase(
         first.impl_.i_, last.impl_.i_,
         detail::make_enc_segs_iter(&s, &s),
         detail::make_enc_segs_iter(&s, &s));
-    return std::next(begin(), first.impl_.i_);
+    return iterator_at(first.impl_.i_);
 }
 
 } // urls
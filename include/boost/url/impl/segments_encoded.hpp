@@ -43,6 +43,15 @@ class segments_encoded::iterator
     {
     }
 
+    iterator(
+        string_view s,
+        std::size_t i,
+        std::size_t pos,
+        std::size_t next) noexcept
+        : impl_(s, i, pos, next)
+    {
+    }
+
 public:
     using value_type = std::string;
     using reference = string_view;
@@ -159,6 +168,27 @@ assign(
         detail::make_enc_segs_iter(first, last));
 }
 
+// return an iterator to segment i
+// without walking the path
+inline
+auto
+segments_encoded::
+iterator_at(
+    std::size_t i) const noexcept ->
+        iterator
+{
+    if(i == 0)
+        return begin();
+    if(i == u_->u_.nseg_)
+        return end();
+    auto const p =
+        u_->u_.offset(id_path);
+    return iterator(
+        u_->encoded_path(), i,
+        u_->segment(i) - p,
+        u_->segment(i + 1) - p);
+}
+
 //------------------------------------------------
 //
 // Element Access
@@ -272,7 +302,7 @@ insert(
             first, last),
         detail::make_enc_segs_iter(
             first, last));
-    return std::next(begin(), before.impl_.i_);
+    return iterator_at(before.impl_.i_);
 }
 
 //------------------------------------------------
@@ -326,14 +356,14 @@ replace(
     BOOST_ASSERT(from.impl_.end_ <= u_->string().data() +
         u_->string().size());
     BOOST_ASSERT(to.impl_.begin_ >= u_->string().data());
-    BOOST_ASSERT(to.impl_.end_ >= u_->string().data() +
+    BOOST_ASSERT(to.impl_.end_ <= u_->string().data() +
         u_->string().size());
     u_->edit_segments(
         from.impl_.i_,
         to.impl_.i_,
         detail::make_enc_segs_iter(first, last),
         detail::make_enc_segs_iter(first, last));
-    return std::next(begin(), from.impl_.i_);
+    return iterator_at(from.impl_.i_);
 }
 
 //------------------------------------------------
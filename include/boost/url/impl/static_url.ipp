@@ -27,6 +27,9 @@ static_url_base(
     cap_ = cap;
     s_[0] = '\0';
     u_.cs_ = s_;
+    // never allocate
+    segs_.disable();
+    parms_.disable();
 }
 
 static_url_base::
@@ -43,6 +46,9 @@ void
 static_url_base::
 clear_impl() noexcept
 {
+    segs_.invalidate();
+    parms_.invalidate();
+    digest_.invalidate();
     u_ = detail::url_impl(false);
     s_[0] = '\0';
     u_.cs_ = s_;
@@ -0,0 +1,761 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_STREAM_PARSER_IPP
+#define BOOST_URL_IMPL_STREAM_PARSER_IPP
+
+#include <boost/url/stream_parser.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/rfc/gen_delim_chars.hpp>
+#include <boost/url/rfc/detail/charsets.hpp>
+#include <boost/url/rfc/detail/host_rule.hpp>
+#include <boost/url/rfc/detail/port_rule.hpp>
+#include <boost/url/detail/path.hpp>
+#include <boost/url/grammar/alpha_chars.hpp>
+#include <boost/url/grammar/digit_chars.hpp>
+#include <boost/url/grammar/error.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <boost/url/grammar/parse.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+/*  The parser is a state machine. Each state
+    scans one part of the URL from pos_, and
+    either moves to the next part or waits
+    for more input at the character which it
+    cannot decide yet. These are the end of
+    the buffer, or an escape cut off by it.
+
+    The offsets of the parts are stored in
+    u_ as they are found. mark_ is the start
+    of the part being scanned, n0_ counts
+    its escapes, and n1_ counts escapes or
+    delimiters as the part requires.
+*/
+namespace detail {
+
+enum stream_state : unsigned char
+{
+    stream_scheme = 0,
+    stream_hier,        // after the scheme
+    stream_auth,        // [ userinfo "@" ] or host [ ":" port ]
+    stream_host,        // host after "@"
+    stream_ip_literal,
+    stream_host_end,
+    stream_port,
+    stream_abempty,     // after the authority
+    stream_nc,          // first segment of path-noscheme
+    stream_path,
+    stream_path_end,
+    stream_query,       // in a key
+    stream_query_value, // after "=" in a param
+    stream_query_end,
+    stream_frag,
+    stream_end,
+    stream_done,
+    stream_error
+};
+
+} // detail
+
+static
+constexpr
+grammar::lut_chars
+stream_scheme_chars(
+    "0123456789" "+-."
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    "abcdefghijklmnopqrstuvwxyz");
+
+// segment-nz-nc
+static
+constexpr
+auto
+stream_nc_chars =
+    pchars - ':';
+
+// as in query_rule
+static
+constexpr
+auto
+stream_key_chars =
+    pchars + '/' + '?' +
+    '[' + ']' - '&' - '=';
+
+static
+constexpr
+auto
+stream_value_chars =
+    pchars + '/' + '?' - '&';
+
+// Every character which can appear in
+// some part of a URL. Any other ends it.
+static
+constexpr
+auto
+stream_url_chars =
+    unreserved_chars +
+    sub_delim_chars +
+    gen_delim_chars + '%';
+
+// Advance it over characters in cs and
+// valid escapes, counting the escapes
+// and each occurrence of delim. An escape
+// cut off by end is left for more input.
+// Returns false on a malformed escape.
+static
+bool
+stream_scan(
+    char const*& it,
+    char const* const end,
+    grammar::lut_chars const& cs,
+    char delim,
+    std::size_t& ndelim,
+    std::size_t& npct) noexcept
+{
+    auto p = it;
+    while(p != end)
+    {
+        char const c = *p;
+        if(cs(c))
+        {
+            if(c == delim)
+                ++ndelim;
+            ++p;
+            continue;
+        }
+        if(c != '%')
+            break;
+        if( (end - p > 1 &&
+                ! grammar::hexdig_chars(p[1])) ||
+            (end - p > 2 &&
+                ! grammar::hexdig_chars(p[2])))
+            return false;
+        if(end - p < 3)
+            break;
+        ++npct;
+        p += 3;
+    }
+    it = p;
+    return true;
+}
+
+// Returns true if a scan stopped at the
+// end of the input, or at an escape
+// cut off by it.
+static
+bool
+stream_partial(
+    char const* p,
+    char const* end) noexcept
+{
+    return
+        p == end ||
+        *p == '%';
+}
+
+static
+void
+stream_apply_host(
+    detail::url_impl& u,
+    detail::host_rule_t::value_type const& h) noexcept
+{
+    u.host_type_ = h.host_type;
+    std::memcpy(
+        u.ip_addr_,
+        h.addr,
+        sizeof(u.ip_addr_));
+    if(h.host_type ==
+            urls::host_type::name)
+        u.decoded_[detail::url_impl::id_host] =
+            static_cast<pos_t>(h.name.size());
+    else
+        u.decoded_[detail::url_impl::id_host] =
+            static_cast<pos_t>(h.match.size());
+}
+
+//------------------------------------------------
+
+stream_parser::
+stream_parser() noexcept = default;
+
+bool
+stream_parser::
+done() const noexcept
+{
+    return st_ == detail::stream_done;
+}
+
+void
+stream_parser::
+reset() noexcept
+{
+    s_.clear();
+    u_ = detail::url_impl(false);
+    ec_ = {};
+    pos_ = 0;
+    mark_ = 0;
+    colon_ = 0;
+    n0_ = 0;
+    n1_ = 0;
+    st_ = detail::stream_scheme;
+    relative_ = false;
+}
+
+result<std::size_t>
+stream_parser::
+write(string_view s)
+{
+    if(st_ == detail::stream_error)
+        return ec_;
+    if(st_ == detail::stream_done)
+        return std::size_t(0);
+
+    // a URL must end within one
+    // character past the largest
+    // size, so the rest is not needed
+    auto const n0 = s_.size();
+    auto n = s.size();
+    if(n > url_view::max_size() + 1 - n0)
+        n = url_view::max_size() + 1 - n0;
+    s_.append(s.data(), n);
+    resume(false);
+    if(st_ == detail::stream_error)
+        return ec_;
+    if(st_ == detail::stream_done)
+    {
+        if(pos_ > url_view::max_size())
+        {
+            ec_ = error::no_space;
+            st_ = detail::stream_error;
+            return ec_;
+        }
+        return pos_ - n0;
+    }
+    if(s_.size() > url_view::max_size())
+    {
+        ec_ = error::no_space;
+        st_ = detail::stream_error;
+        return ec_;
+    }
+    return n;
+}
+
+result<url_view>
+stream_parser::
+finish() noexcept
+{
+    if(st_ == detail::stream_error)
+        return ec_;
+    if(st_ != detail::stream_done)
+    {
+        resume(true);
+        if(st_ == detail::stream_error)
+            return ec_;
+    }
+    u_.cs_ = s_.data();
+    return u_.construct();
+}
+
+void
+stream_parser::
+resume(bool eof) noexcept
+{
+    using detail::url_impl;
+    char const* const b = s_.data();
+    auto const end = b + s_.size();
+    auto p = b + pos_;
+    std::size_t nd = 0;
+
+    auto const at = [b](char const* q)
+    {
+        return static_cast<pos_t>(q - b);
+    };
+    auto const no_authority = [this](pos_t n)
+    {
+        u_.offset_[url_impl::id_pass] = n;
+        u_.offset_[url_impl::id_host] = n;
+        u_.offset_[url_impl::id_port] = n;
+        u_.offset_[url_impl::id_path] = n;
+        n0_ = 0;
+        n1_ = 0;
+    };
+    auto const fail = [this](error_code ec)
+    {
+        ec_ = ec;
+        st_ = detail::stream_error;
+    };
+
+    for(;;)
+    {
+        switch(st_)
+        {
+        case detail::stream_scheme:
+        {
+            while( p != end &&
+                stream_scheme_chars(*p))
+                ++p;
+            if( p == end &&
+                ! eof)
+                break;
+            if( p != end &&
+                *p == ':')
+            {
+                // path-noscheme may not
+                // have a ':' either
+                if( p == b ||
+                    ! grammar::alpha_chars(*b))
+                    return fail(
+                        grammar::error::syntax);
+                u_.scheme_ = string_to_scheme(
+                    string_view(b, p - b));
+                ++p;
+                relative_ = false;
+                u_.offset_[url_impl::id_user] = at(p);
+                st_ = detail::stream_hier;
+                continue;
+            }
+            relative_ = true;
+            if(p != b)
+            {
+                // the scheme chars are the
+                // start of path-noscheme
+                no_authority(0);
+                st_ = detail::stream_nc;
+                continue;
+            }
+            st_ = detail::stream_hier;
+            continue;
+        }
+
+        case detail::stream_hier:
+        {
+            if(end - p < 2)
+            {
+                if(! eof && (
+                    p == end ||
+                    *p == '/'))
+                    break;
+            }
+            else if(
+                p[0] == '/' &&
+                p[1] == '/')
+            {
+                // "//" authority
+                p += 2;
+                mark_ = at(p);
+                colon_ = std::size_t(-1);
+                n0_ = 0;
+                n1_ = 0;
+                st_ = detail::stream_auth;
+                continue;
+            }
+            no_authority(at(p));
+            if( relative_ &&
+                p != end &&
+                *p != '/')
+                st_ = detail::stream_nc;
+            else
+                st_ = detail::stream_path;
+            continue;
+        }
+
+        case detail::stream_auth:
+        {
+            auto const a = b + mark_;
+            if(colon_ == std::size_t(-1))
+            {
+                if(! stream_scan(p, end,
+                        detail::user_chars, 0, nd, n0_))
+                    return fail(error::bad_pct_hexdig);
+                if( p != end &&
+                    *p == ':')
+                {
+                    colon_ = at(p);
+                    ++p;
+                }
+            }
+            if( colon_ != std::size_t(-1) &&
+                ! stream_scan(p, end,
+                    detail::password_chars, 0, nd, n1_))
+                return fail(error::bad_pct_hexdig);
+            if(stream_partial(p, end))
+            {
+                if(! eof)
+                    break;
+                if(p != end)
+                    return fail(
+                        error::incomplete_pct_encoding);
+            }
+            if( p != end &&
+                *p == '@')
+            {
+                // userinfo
+                auto const ue =
+                    colon_ != std::size_t(-1) ?
+                        b + colon_ : p;
+                u_.offset_[url_impl::id_pass] = at(ue);
+                u_.decoded_[url_impl::id_user] =
+                    static_cast<pos_t>(
+                        (ue - a) - 2 * n0_);
+                if(ue != p)
+                    u_.decoded_[url_impl::id_pass] =
+                        static_cast<pos_t>(
+                            (p - ue - 1) - 2 * n1_);
+                ++p;
+                u_.offset_[url_impl::id_host] = at(p);
+                mark_ = at(p);
+                st_ = detail::stream_host;
+                continue;
+            }
+            u_.offset_[url_impl::id_pass] = at(a);
+            u_.offset_[url_impl::id_host] = at(a);
+            if( p == a &&
+                p != end &&
+                *p == '[')
+            {
+                st_ = detail::stream_ip_literal;
+                continue;
+            }
+
+            // no userinfo, so [a, p)
+            // is host [ ":" port ]
+            auto it = a;
+            auto rv = grammar::parse(
+                it, p, detail::host_rule);
+            if(! rv)
+                return fail(rv.error());
+            stream_apply_host(u_, *rv);
+            u_.offset_[url_impl::id_port] = at(it);
+            if(it != p)
+            {
+                if(*it != ':')
+                    return fail(
+                        grammar::error::leftover);
+                ++it;
+                auto rv1 = grammar::parse(
+                    it, p, detail::port_rule{});
+                if( ! rv1 ||
+                    it != p)
+                    return fail(
+                        grammar::error::leftover);
+                u_.port_number_ = rv1->number;
+            }
+            u_.offset_[url_impl::id_path] = at(p);
+            st_ = detail::stream_abempty;
+            continue;
+        }
+
+        case detail::stream_host:
+        {
+            auto const h = b + mark_;
+            if( p == h &&
+                p != end &&
+                *p == '[')
+            {
+                st_ = detail::stream_ip_literal;
+                continue;
+            }
+            if(! stream_scan(p, end,
+                    detail::reg_name_chars, 0, nd, n0_))
+                return fail(error::bad_pct_hexdig);
+            if(stream_partial(p, end))
+            {
+                if(! eof)
+                    break;
+                if(p != end)
+                    return fail(
+                        error::incomplete_pct_encoding);
+            }
+            auto it = h;
+            auto rv = grammar::parse(
+                it, p, detail::host_rule);
+            if(! rv)
+                return fail(rv.error());
+            if(it != p)
+                return fail(
+                    grammar::error::leftover);
+            stream_apply_host(u_, *rv);
+            u_.offset_[url_impl::id_port] = at(p);
+            st_ = detail::stream_host_end;
+            continue;
+        }
+
+        case detail::stream_ip_literal:
+        {
+            auto const h = b + mark_;
+            if(p == h)
+                ++p;
+            while(
+                p != end &&
+                *p != ']' &&
+                detail::password_chars(*p))
+                ++p;
+            if(p == end)
+            {
+                if(! eof)
+                    break;
+                return fail(
+                    grammar::error::incomplete);
+            }
+            if(*p != ']')
+                return fail(
+                    grammar::error::syntax);
+            ++p;
+            auto it = h;
+            auto rv = grammar::parse(
+                it, p, detail::host_rule);
+            if(! rv)
+                return fail(rv.error());
+            if(it != p)
+                return fail(
+                    grammar::error::leftover);
+            stream_apply_host(u_, *rv);
+            u_.offset_[url_impl::id_port] = at(p);
+            st_ = detail::stream_host_end;
+            continue;
+        }
+
+        case detail::stream_host_end:
+        {
+            if( p == end &&
+                ! eof)
+                break;
+            if( p != end &&
+                *p == ':')
+            {
+                ++p;
+                mark_ = at(p);
+                st_ = detail::stream_port;
+                continue;
+            }
+            u_.offset_[url_impl::id_path] = at(p);
+            st_ = detail::stream_abempty;
+            continue;
+        }
+
+        case detail::stream_port:
+        {
+            while( p != end &&
+                grammar::digit_chars(*p))
+                ++p;
+            if( p == end &&
+                ! eof)
+                break;
+            auto it = b + mark_;
+            auto rv = grammar::parse(
+                it, p, detail::port_rule{});
+            if(! rv)
+                return fail(rv.error());
+            u_.port_number_ = rv->number;
+            u_.offset_[url_impl::id_path] = at(p);
+            st_ = detail::stream_abempty;
+            continue;
+        }
+
+        case detail::stream_abempty:
+        {
+            if( p == end &&
+                ! eof)
+                break;
+            n0_ = 0;
+            n1_ = 0;
+            if( p != end &&
+                *p == '/')
+                st_ = detail::stream_path;
+            else
+                st_ = detail::stream_path_end;
+            continue;
+        }
+
+        case detail::stream_nc:
+        {
+            if(! stream_scan(p, end,
+                    stream_nc_chars, 0, nd, n0_))
+                return fail(error::bad_pct_hexdig);
+            if(stream_partial(p, end))
+            {
+                if(! eof)
+                    break;
+                if(p != end)
+                    return fail(
+                        error::incomplete_pct_encoding);
+            }
+            if( p != end &&
+                *p == ':')
+                return fail(
+                    grammar::error::syntax);
+            if( p != end &&
+                *p == '/')
+                st_ = detail::stream_path;
+            else
+                st_ = detail::stream_path_end;
+            continue;
+        }
+
+        case detail::stream_path:
+        {
+            if(! stream_scan(p, end,
+                    detail::path_chars, '/', n1_, n0_))
+                return fail(error::bad_pct_hexdig);
+            if(stream_partial(p, end))
+            {
+                if(! eof)
+                    break;
+                if(p != end)
+                    return fail(
+                        error::incomplete_pct_encoding);
+            }
+            st_ = detail::stream_path_end;
+            continue;
+        }
+
+        case detail::stream_path_end:
+        {
+            auto const s = string_view(
+                b + u_.offset_[url_impl::id_path],
+                p - b - u_.offset_[url_impl::id_path]);
+            u_.decoded_[url_impl::id_path] =
+                static_cast<pos_t>(
+                    s.size() - 2 * n0_);
+            auto nseg = n1_;
+            if( ! s.empty() &&
+                s[0] != '/')
+                ++nseg;
+            u_.nseg_ = static_cast<pos_t>(
+                detail::path_segments(s, nseg));
+            u_.offset_[url_impl::id_query] = at(p);
+            if( p != end &&
+                *p == '?')
+            {
+                ++p;
+                mark_ = at(p);
+                n0_ = 0;
+                n1_ = 0;
+                st_ = detail::stream_query;
+                continue;
+            }
+            st_ = detail::stream_query_end;
+            continue;
+        }
+
+        case detail::stream_query:
+        case detail::stream_query_value:
+        {
+            // a key may have brackets,
+            // but not the value after it
+            for(;;)
+            {
+                bool const key = st_ ==
+                    detail::stream_query;
+                if(! stream_scan(p, end, key ?
+                        stream_key_chars :
+                        stream_value_chars,
+                        0, nd, n0_))
+                    return fail(error::bad_pct_hexdig);
+                if(p == end)
+                    break;
+                if(*p == '&')
+                {
+                    ++n1_;
+                    st_ = detail::stream_query;
+                }
+                else if(
+                    key &&
+                    *p == '=')
+                {
+                    st_ = detail::stream_query_value;
+                }
+                else
+                {
+                    break;
+                }
+                ++p;
+            }
+            if(stream_partial(p, end))
+            {
+                if(! eof)
+                    break;
+                if(p != end)
+                    return fail(
+                        error::incomplete_pct_encoding);
+            }
+            u_.nparam_ = static_cast<pos_t>(
+                1 + n1_);
+            u_.decoded_[url_impl::id_query] =
+                static_cast<pos_t>(
+                    (p - b - mark_) - 2 * n0_);
+            st_ = detail::stream_query_end;
+            continue;
+        }
+
+        case detail::stream_query_end:
+        {
+            u_.offset_[url_impl::id_frag] = at(p);
+            if( p != end &&
+                *p == '#')
+            {
+                ++p;
+                mark_ = at(p);
+                n0_ = 0;
+                st_ = detail::stream_frag;
+                continue;
+            }
+            st_ = detail::stream_end;
+            continue;
+        }
+
+        case detail::stream_frag:
+        {
+            if(! stream_scan(p, end,
+                    detail::fragment_chars, 0, nd, n0_))
+                return fail(error::bad_pct_hexdig);
+            if(stream_partial(p, end))
+            {
+                if(! eof)
+                    break;
+                if(p != end)
+                    return fail(
+                        error::incomplete_pct_encoding);
+            }
+            u_.decoded_[url_impl::id_frag] =
+                static_cast<pos_t>(
+                    (p - b - mark_) - 2 * n0_);
+            st_ = detail::stream_end;
+            continue;
+        }
+
+        case detail::stream_end:
+        {
+            if( p != end &&
+                stream_url_chars(*p))
+                return fail(
+                    grammar::error::leftover);
+            u_.offset_[url_impl::id_end] = at(p);
+            pos_ = at(p);
+            s_.resize(pos_);
+            st_ = detail::stream_done;
+            return;
+        }
+
+        default:
+            return;
+        }
+
+        // wait for more input
+        pos_ = at(p);
+        return;
+    }
+}
+
+} // urls
+} // boost
+
+#endif
@@ -26,7 +26,7 @@ url::
     {
         BOOST_ASSERT(
             cap_ != 0);
-        deallocate(s_);
+        deallocate(s_, cap_);
     }
 }
 
@@ -40,15 +40,27 @@ url(string_view s)
 {
 }
 
+url::
+url(
+    string_view s,
+    container::pmr::memory_resource* mr)
+    : mr_(mr)
+{
+    copy(parse_uri_reference(s).value());
+}
+
 url::
 url(url&& u) noexcept
     : url_base(u.u_)
+    , mr_(u.mr_)
 {
     s_ = u.s_;
     cap_ = u.cap_;
+    digest_ = u.digest_;
     u.s_ = nullptr;
     u.cap_ = 0;
     u.u_ = detail::url_impl(false);
+    u.digest_.invalidate();
 }
 
 url&
@@ -56,13 +68,18 @@ url::
 operator=(url&& u) noexcept
 {
     if(s_)
-        deallocate(s_);
+        deallocate(s_, cap_);
+    segs_.invalidate();
+    parms_.invalidate();
+    mr_ = u.mr_;
     u_ = u.u_;
     s_ = u.s_;
     cap_ = u.cap_;
+    digest_ = u.digest_;
     u.s_ = nullptr;
     u.cap_ = 0;
     u.u_ = detail::url_impl(false);
+    u.digest_.invalidate();
     return *this;
 }
 
@@ -72,16 +89,22 @@ char*
 url::
 allocate(std::size_t n)
 {
-    auto s = new char[n + 1];
-    cap_ = n;
-    return s;
+    if(! mr_)
+        return new char[n + 1];
+    return static_cast<char*>(
+        mr_->allocate(n + 1, 1));
 }
 
 void
 url::
-deallocate(char* s)
+deallocate(
+    char* s,
+    std::size_t n) noexcept
 {
-    delete[] s;
+    if(! mr_)
+        delete[] s;
+    else
+        mr_->deallocate(s, n + 1, 1);
 }
 
 void
@@ -91,6 +114,9 @@ clear_impl() noexcept
     if(s_)
     {
         // preserve capacity
+        segs_.invalidate();
+        parms_.invalidate();
+        digest_.invalidate();
         u_ = detail::url_impl(false);
         s_[0] = '\0';
         u_.cs_ = s_;
@@ -127,13 +153,15 @@ reserve_impl(
             new_cap = n;
         s = allocate(new_cap);
         std::memcpy(s, s_, size());
-        deallocate(s_);
+        deallocate(s_, cap_);
         s_ = s;
+        cap_ = new_cap;
     }
     else
     {
         s_ = allocate(n);
         s_[0] = '\0';
+        cap_ = n;
     }
     u_.cs_ = s_;
 }
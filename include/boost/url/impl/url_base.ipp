@@ -18,6 +18,8 @@
 #include <boost/url/url_view.hpp>
 #include <boost/url/detail/except.hpp>
 #include <boost/url/detail/print.hpp>
+#include <boost/url/detail/remove_dot_segments.hpp>
+#include <boost/url/detail/resolve.hpp>
 #include <boost/url/grammar/parse.hpp>
 #include <boost/url/rfc/authority_rule.hpp>
 #include <boost/url/rfc/query_rule.hpp>
@@ -57,6 +59,9 @@ copy(url_view_base const& u)
         return;
     }
     reserve(u.size());
+    segs_.invalidate();
+    parms_.invalidate();
+    digest_.invalidate();
     u_ = u.u_;
     u_.cs_ = s_;
     std::memcpy(s_,
@@ -64,6 +69,18 @@ copy(url_view_base const& u)
     s_[size()] = '\0';
 }
 
+std::size_t
+url_base::
+digest(std::size_t salt) const noexcept
+{
+    std::size_t h;
+    if(digest_.get(salt, h))
+        return h;
+    h = url_view_base::digest(salt);
+    digest_.set(salt, h);
+    return h;
+}
+
 //------------------------------------------------
 //
 // Scheme
@@ -166,8 +183,10 @@ remove_scheme() noexcept
     }
 
     // remove the scheme but add "./"
-    // to the beginning of the path
+    // to the beginning of the path,
+    // editing in place
     BOOST_ASSERT(n >= 2);
+    digest_.invalidate();
     // move [id_scheme, id_path) left
     std::memmove(
         s_,
@@ -506,8 +525,8 @@ set_userinfo(
     {
         u_.split(id_user, pct_sep);
         auto sep = s.find_first_of(':');
-        u_.decoded_[id_user] = sep - 1;
-        u_.decoded_[id_pass] = s.size() - sep;
+        u_.decoded_[id_user] = sep;
+        u_.decoded_[id_pass] = s.size() - sep - 1;
     }
     else
     {
@@ -551,8 +570,8 @@ set_userinfo(
                 break;
             ++sep;
         }
-        u_.decoded_[id_user] = sep - 1;
-        u_.decoded_[id_pass] = s.size() - sep;
+        u_.decoded_[id_user] = sep;
+        u_.decoded_[id_pass] = s.size() - sep - 1;
     }
     else
     {
@@ -988,6 +1007,13 @@ remove_origin() noexcept
 //------------------------------------------------
 
 /*  Return offset of i-th segment
+
+    Lookups in the middle of the path go
+    through the segment table, which is
+    built here on first use and maintained
+    by edit_segments. Other modifications
+    to the path change its length, which
+    invalidates the table.
 */
 pos_t
 url_base::
@@ -999,6 +1025,12 @@ segment(
     if(i == u_.nseg_)
         return u_.offset(id_query);
     BOOST_ASSERT(i < u_.nseg_);
+    if(! segs_.valid(
+        u_.nseg_ + 1, u_.len(id_path)))
+        build_segments();
+    if(segs_.valid(
+        u_.nseg_ + 1, u_.len(id_path)))
+        return u_.offset(id_path) + segs_[i];
     auto it = s_ + u_.offset(id_path) +
         detail::path_prefix(
             u_.get(id_path));
@@ -1018,6 +1050,56 @@ segment(
     return it - s_;
 }
 
+/*  Build the segment table from scratch
+
+    Entry i holds the offset of segment i
+    from the start of the path, and entry
+    nseg holds the length of the path.
+*/
+void
+url_base::
+build_segments() const noexcept
+{
+    auto const p = u_.get(id_path);
+    segs_.build(u_.nseg_, p,
+        detail::path_prefix(p), '/');
+}
+
+/*  Update the segment table after segments
+    [i0, i1) were replaced with nseg new
+    segments, given the old path length n0.
+
+    Entries up to i0 are unchanged, the new
+    entries are found by scanning only the
+    characters which were written, and the
+    remaining entries are shifted.
+*/
+void
+url_base::
+update_segments(
+    std::size_t i0,
+    std::size_t i1,
+    std::size_t nseg,
+    pos_t n0) noexcept
+{
+    if(! segs_.valid(
+        u_.nseg_ + (i1 - i0) - nseg + 1,
+        n0))
+    {
+        segs_.invalidate();
+        return;
+    }
+    auto const p = u_.get(id_path);
+    std::size_t pos;
+    if(i0 == 0)
+        pos = detail::path_prefix(p);
+    else
+        pos = segs_[i0] + 1;
+    segs_.update(
+        i0 + 1, i1 + 1, nseg,
+        p, pos, '/');
+}
+
 /*  Remove segments [first, last) and make
     room for nseg new segments inserted
     before first, with space for n chars
@@ -1038,6 +1120,7 @@ edit_segments(
 {
     BOOST_ASSERT(i1 >= i0);
     BOOST_ASSERT(i1 - i0 <= u_.nseg_);
+    digest_.invalidate();
 
     // new number of segments
     std::size_t const nseg1 =
@@ -1258,6 +1341,8 @@ edit_segments(
 
     // copy
     n += prefix + suffix;
+    auto const nseg0 = nseg;
+    auto const n0 = u_.len(id_path);
     auto dest = edit_segments(
         i0, i1, n, nseg);
     auto const last = dest + n;
@@ -1302,6 +1387,8 @@ edit_segments(
     }
     if(suffix == 1)
         *dest++ = '/';
+    update_segments(
+        i0, i1, nseg0, n0);
 }
 
 //------------------------------------------------
@@ -1450,6 +1537,15 @@ param(
     if(u_.nparam_ < 2)
         return make_param(
             u_.offset(id_query), n);
+    if(! parms_.valid(
+            u_.nparam_ + 1, n))
+        build_params();
+    if(parms_.valid(
+            u_.nparam_ + 1, n))
+        return make_param(
+            u_.offset(id_query) +
+                parms_[i],
+            parms_[i + 1] - parms_[i]);
     auto it = s_ + u_.offset(id_query);
     auto start = it;
     auto const last =
@@ -1474,6 +1570,46 @@ param(
         start - s_, it - start);
 }
 
+/*  Build the param table from scratch
+
+    Entry i holds the offset of the leading
+    '?' or '&' of param i from the start of
+    the query, and entry nparam holds the
+    length of the query.
+*/
+void
+url_base::
+build_params() const noexcept
+{
+    parms_.build(u_.nparam_,
+        u_.get(id_query), 1, '&');
+}
+
+/*  Update the param table after params
+    [i0, i1) were replaced with nparam new
+    params, given the old query length n0.
+*/
+void
+url_base::
+update_params(
+    std::size_t i0,
+    std::size_t i1,
+    std::size_t nparam,
+    pos_t n0) noexcept
+{
+    if(! parms_.valid(
+        u_.nparam_ + (i1 - i0) - nparam + 1,
+        n0))
+    {
+        parms_.invalidate();
+        return;
+    }
+    parms_.update(
+        i0 + 1, i1 + 1, nparam,
+        u_.get(id_query),
+        parms_[i0] + 1, '&');
+}
+
 char*
 url_base::
 edit_params(
@@ -1484,6 +1620,7 @@ edit_params(
 {
     BOOST_ASSERT(i1 >= i0);
     BOOST_ASSERT(i1 - i0 <= u_.nparam_);
+    digest_.invalidate();
 
     // new number of params
     auto const nparam1 =
@@ -1556,6 +1693,7 @@ edit_params(
     }
     else if(
         i0 == 0 &&
+        i1 == u_.nparam_ &&
         set_hint)
     {
         prefix = true;
@@ -1567,6 +1705,9 @@ edit_params(
     }
 
     // copy
+    auto const nparam_new = nparam;
+    auto const nparam_old = u_.nparam_;
+    auto const n0 = u_.len(id_query);
     auto dest = edit_params(
         i0, i1, n, nparam);
     if(prefix)
@@ -1584,6 +1725,19 @@ edit_params(
             *dest++ = '&';
         }
     }
+    if( i0 == 0 &&
+        i1 < nparam_old)
+    {
+        // the first remaining param now
+        // follows the new params, or
+        // begins the query
+        if(nparam_new > 0)
+            *dest = '&';
+        else
+            *dest = '?';
+    }
+    update_params(
+        i0, i1, nparam_new, n0);
 
     check_invariants();
 }
@@ -1615,6 +1769,7 @@ set_encoded_query(
         this->string());
     s = buf.maybe_copy(s);
     check_invariants();
+    parms_.invalidate();
     edit_params(
         0,
         u_.nparam_,
@@ -1638,6 +1793,7 @@ set_query(
     detail::copied_strings buf(
         this->string());
     s = buf.maybe_copy(s);
+    parms_.invalidate();
     edit_params(
         0,
         u_.nparam_,
@@ -1660,6 +1816,7 @@ set_query(
     detail::copied_strings buf(
         this->string());
     s = buf.maybe_copy(s);
+    parms_.invalidate();
     edit_params(
         0,
         u_.nparam_,
@@ -1778,66 +1935,6 @@ resolve_impl(
     url_view_base const& ref,
     error_code& ec)
 {
-    auto const remove_dot_segments =
-        [this]
-    {
-        auto segs = encoded_segments();
-        if(segs.empty())
-            return;
-        auto it = segs.begin();
-        int n = 0;
-        for(;;)
-        {
-            if(*it == ".")
-            {
-                if(it != std::prev(segs.end()))
-                    it = segs.erase(it);
-                else
-                    it = segs.replace(it, "");
-            }
-            else if(it == segs.begin())
-            {
-            #if 0
-                if(*it == "..")
-                    it = segs.erase(it);
-                else
-                    ++it;
-            #else
-            /*  Errata 4547
-                https://www.rfc-editor.org/errata/eid4547
-            */
-                if(*it != "..")
-                    ++n;
-                ++it;
-            #endif
-            }
-            else if(*it == "..")
-            {
-                if(n > 0)
-                {
-                    it = segs.erase(std::prev(it));
-                    if( it == segs.begin() ||
-                        it != std::prev(segs.end()))
-                        it = segs.erase(it);
-                    else
-                        it = segs.replace(it, "");
-                    --n;
-                }
-                else
-                {
-                    ++it;
-                }
-            }
-            else
-            {
-                ++n;
-                ++it;
-            }
-            if(it == segs.end())
-                break;
-        }
-    };
-
     if(! base.has_scheme())
     {
         ec = error::not_a_base;
@@ -1846,131 +1943,36 @@ resolve_impl(
 
     ec = {};
 
-    //
-    // 5.2.2. Transform References
-    // https://datatracker.ietf.org/doc/html/rfc3986#section-5.2.2
-    //
-
-    if(ref.has_scheme())
-    {
-        reserve(ref.size());
-        copy(ref);
-        remove_dot_segments();
-        return true;
-    }
-    if(ref.has_authority())
-    {
-        reserve(
-            base.u_.offset(id_user) +
-                ref.size());
-        clear();
-        set_scheme(base.scheme());
-        set_encoded_authority(
-            ref.encoded_authority());
-        set_encoded_path(
-            ref.encoded_path());
-        remove_dot_segments();
-        if(ref.has_query())
-            set_encoded_query(
-                ref.encoded_query());
-        if(ref.has_fragment())
-            set_encoded_fragment(
-                ref.encoded_fragment());
-        return true;
-    }
-    if(ref.encoded_path().empty())
-    {
-        if(ref.has_query())
-        {
-            reserve(
-                base.u_.offset(id_query) +
-                    ref.size());
-            clear();
-            set_scheme(base.scheme());
-            if(base.has_authority())
-                set_encoded_authority(
-                    base.encoded_authority());
-            set_encoded_path(
-                base.encoded_path());
-            remove_dot_segments();
-            set_encoded_query(
-                ref.encoded_query());
-        }
-        else
-        {
-            reserve(
-                base.u_.offset(id_query) +
-                    ref.size());
-            clear();
-            set_scheme(base.scheme());
-            if(base.has_authority())
-                set_encoded_authority(
-                    base.encoded_authority());
-            set_encoded_path(
-                base.encoded_path());
-            remove_dot_segments();
-            if(base.has_query())
-                set_encoded_query(
-                    base.encoded_query());
-        }
-        if(ref.has_fragment())
-            set_encoded_fragment(
-                ref.encoded_fragment());
-        return true;
-    }
-    if(ref.encoded_path().starts_with('/'))
-    {
-        reserve(
-            base.u_.offset(id_path) +
-                ref.size());
-        clear();
-        set_scheme(base.scheme());
-        if(base.has_authority())
-            set_encoded_authority(
-                base.encoded_authority());
-        set_encoded_path(
-            ref.encoded_path());
-        remove_dot_segments();
-        if(ref.has_query())
-            set_encoded_query(
-                ref.encoded_query());
-        if(ref.has_fragment())
-            set_encoded_fragment(
-                ref.encoded_fragment());
-        return true;
-    }
-    reserve(
-        base.u_.offset(id_query) +
-            ref.size());
-    clear();
-    set_scheme(base.scheme());
-    if(base.has_authority())
-        set_encoded_authority(
-            base.encoded_authority());
-    {
-        // 5.2.3. Merge Paths
-        auto es = encoded_segments();
-        if(base.u_.nseg_ > 0)
-        {
-            set_encoded_path(
-                base.encoded_path());
-            if(u_.nseg_ > 0)
-                es.pop_back();
-        }
-        es.insert(es.end(),
-            ref.encoded_segments().begin(),
-            ref.encoded_segments().end());
-    }
-    remove_dot_segments();
-    if(ref.has_query())
-        set_encoded_query(
-            ref.encoded_query());
-    if(ref.has_fragment())
-        set_encoded_fragment(
-            ref.encoded_fragment());
+    // base and ref may refer to our
+    // buffer, which is overwritten below
+    detail::copied_strings buf(
+        this->string());
+    detail::url_impl b = base.u_;
+    b.cs_ = buf.maybe_copy(
+        base.string()).data();
+    detail::url_impl r = ref.u_;
+    r.cs_ = buf.maybe_copy(
+        ref.string()).data();
+    detail::resolve_plan p;
+    detail::resolve_plan_init(p, b,
+        detail::resolve_merge_prefix(b), r);
+    resolve_impl(p);
     return true;
 }
 
+void
+url_base::
+resolve_impl(
+    detail::resolve_plan const& p)
+{
+    reserve(p.size());
+    segs_.invalidate();
+    parms_.invalidate();
+    digest_.invalidate();
+    u_ = detail::resolve_write(s_, p);
+    check_invariants();
+}
+
 //------------------------------------------------
 //
 // Normalization
@@ -2012,12 +2014,13 @@ normalize_octets_impl(
             continue;
         }
 
-        // uppercase percent-encoding triplets
-        ++it;
-        *it = grammar::to_upper(*it);
-        ++it;
-        *it = grammar::to_upper(*it);
-        ++it;
+        // uppercase percent-encoding triplets,
+        // which move down when an earlier
+        // one was decoded
+        dest[0] = '%';
+        dest[1] = grammar::to_upper(it[1]);
+        dest[2] = grammar::to_upper(it[2]);
+        it += 3;
         dest += 3;
     }
     if (it != dest)
@@ -2095,7 +2098,9 @@ url_base&
 url_base::
 normalize_path()
 {
-    normalize_octets_impl(id_path, detail::path_chars);
+    // an escaped '/' is not a separator,
+    // so it is left escaped
+    normalize_octets_impl(id_path, pchars);
     string_view p = encoded_path();
     char* p_dest = s_ + u_.offset(id_path);
     char* p_end = s_ + u_.offset(id_path + 1);
@@ -2113,6 +2118,7 @@ normalize_path()
                 p.begin() + 1, p.end(), '/') + 1;
         else
             u_.nseg_ = 0;
+        segs_.invalidate();
     }
     return *this;
 }
@@ -2205,6 +2211,8 @@ resize_impl(
     int last,
     std::size_t new_len)
 {
+    // the caller writes the new chars
+    digest_.invalidate();
     auto const n0 = u_.len(first, last);
     if(new_len == 0 && n0 == 0)
         return s_ + u_.offset(first);
@@ -2251,6 +2259,7 @@ shrink_impl(
     std::size_t new_len)
 {
     // shrinking
+    digest_.invalidate();
     auto const n0 = u_.len(first, last);
     BOOST_ASSERT(new_len <= n0);
     std::size_t n = n0 - new_len;
@@ -0,0 +1,706 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_BUILDER_IPP
+#define BOOST_URL_IMPL_URL_BUILDER_IPP
+
+#include <boost/url/url_builder.hpp>
+#include <boost/url/ipv4_address.hpp>
+#include <boost/url/pct_encoding.hpp>
+#include <boost/url/detail/copied_strings.hpp>
+#include <boost/url/detail/except.hpp>
+#include <boost/url/detail/path.hpp>
+#include <boost/url/detail/print.hpp>
+#include <boost/url/detail/url_impl.hpp>
+#include <boost/url/grammar/parse.hpp>
+#include <boost/url/rfc/detail/charsets.hpp>
+#include <boost/url/rfc/detail/host_rule.hpp>
+#include <boost/url/rfc/detail/port_rule.hpp>
+#include <boost/url/rfc/detail/scheme_rule.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+// Write s, encoding it if it is plain
+static
+char*
+build_part(
+    char* dest,
+    string_view s,
+    bool plain,
+    grammar::lut_chars const& cs) noexcept
+{
+    if(plain)
+        return dest +
+            pct_encode_unchecked(
+                dest, s, cs);
+    if(! s.empty())
+        std::memcpy(dest,
+            s.data(), s.size());
+    return dest + s.size();
+}
+
+} // detail
+
+bool
+url_builder::
+has_authority() const noexcept
+{
+    return
+        host_.has ||
+        user_.has ||
+        pass_.has ||
+        has_port_;
+}
+
+// Return the chars written before the
+// path, which keep it from being taken
+// for some other part of the URL
+string_view
+url_builder::
+path_prefix() const noexcept
+{
+    auto const p = path_.s;
+    if(has_authority())
+    {
+        // path-abempty
+        if( ! p.empty() &&
+            p.front() != '/')
+            return "/";
+        return {};
+    }
+    // not an authority
+    if(p.starts_with("//"))
+        return "/.";
+    // path-noscheme
+    if( scheme_.empty() &&
+        ! p.starts_with('/') &&
+        p.substr(0, p.find('/')).find(
+            ':') != string_view::npos)
+        return "./";
+    return {};
+}
+
+url_builder::
+url_builder(
+    url_view_base const& u) noexcept
+{
+    auto const& v = u.u_;
+    if(u.has_scheme())
+    {
+        scheme_ = u.scheme();
+        scheme_id_ = v.scheme_;
+    }
+    if(u.has_userinfo())
+    {
+        user_.s = u.encoded_user();
+        user_.n = user_.s.size();
+        user_.dn = v.decoded_[
+            detail::url_impl::id_user];
+        user_.has = true;
+        if(u.has_password())
+        {
+            pass_.s = u.encoded_password();
+            pass_.n = pass_.s.size();
+            pass_.dn = v.decoded_[
+                detail::url_impl::id_pass];
+            pass_.has = true;
+        }
+    }
+    if(u.has_authority())
+    {
+        host_.s = u.encoded_host();
+        host_.n = host_.s.size();
+        host_.dn = v.decoded_[
+            detail::url_impl::id_host];
+        host_.has = true;
+        host_type_ = v.host_type_;
+        std::memcpy(
+            ip_addr_,
+            v.ip_addr_,
+            sizeof(ip_addr_));
+        if(u.has_port())
+        {
+            port_ = u.port();
+            port_number_ = v.port_number_;
+            has_port_ = true;
+        }
+    }
+    path_.s = u.encoded_path();
+    path_.n = path_.s.size();
+    path_.dn = v.decoded_[
+        detail::url_impl::id_path];
+    nslash_ = std::count(
+        path_.s.begin(),
+        path_.s.end(), '/');
+    if(u.has_query())
+    {
+        query_.s = u.encoded_query();
+        query_.n = query_.s.size();
+        query_.dn = v.decoded_[
+            detail::url_impl::id_query];
+        query_.has = true;
+        namp_ = v.nparam_ - 1;
+    }
+    if(u.has_fragment())
+    {
+        frag_.s = u.encoded_fragment();
+        frag_.n = frag_.s.size();
+        frag_.dn = v.decoded_[
+            detail::url_impl::id_frag];
+        frag_.has = true;
+    }
+}
+
+std::size_t
+url_builder::
+size() const noexcept
+{
+    std::size_t n = 0;
+    if(! scheme_.empty())
+        n += scheme_.size() + 1;
+    bool const auth = has_authority();
+    if(auth)
+    {
+        n += 2 + host_.n;
+        if(user_.has || pass_.has)
+            n += user_.n + 1;
+        if(pass_.has)
+            n += 1 + pass_.n;
+        if(has_port_)
+            n += 1 + (print_port_ ?
+                detail::make_printed(
+                    port_number_).string().size() :
+                port_.size());
+    }
+    n += path_.n;
+    n += path_prefix().size();
+    if(query_.has)
+        n += 1 + query_.n;
+    if(frag_.has)
+        n += 1 + frag_.n;
+    return n;
+}
+
+void
+url_builder::
+build(url_base& dest) const
+{
+    using detail::url_impl;
+
+    // the parts may refer to dest,
+    // whose chars are overwritten
+    detail::copied_strings buf(
+        dest.string());
+    auto const scheme =
+        buf.maybe_copy(scheme_);
+    auto const user =
+        buf.maybe_copy(user_.s);
+    auto const pass =
+        buf.maybe_copy(pass_.s);
+    auto const host =
+        buf.maybe_copy(host_.s);
+    auto const printed =
+        detail::make_printed(
+            port_number_);
+    auto const port = print_port_ ?
+        printed.string() :
+        buf.maybe_copy(port_);
+    auto const path =
+        buf.maybe_copy(path_.s);
+    auto const query =
+        buf.maybe_copy(query_.s);
+    auto const frag =
+        buf.maybe_copy(frag_.s);
+
+    bool const auth = has_authority();
+    auto const pre = path_prefix();
+    auto const n = size();
+    if(n == 0)
+    {
+        dest.clear();
+        return;
+    }
+    dest.reserve(n);
+
+    // write the parts in order,
+    // noting where each one starts
+    url_impl u(false);
+    char* const start = dest.s_;
+    char* it = start;
+    auto const mark = [&u, start, &it](int id)
+    {
+        u.offset_[id] = static_cast<
+            pos_t>(it - start);
+    };
+    if(! scheme.empty())
+    {
+        std::memcpy(it,
+            scheme.data(), scheme.size());
+        it += scheme.size();
+        *it++ = ':';
+    }
+    mark(url_impl::id_user);
+    if(auth)
+    {
+        *it++ = '/';
+        *it++ = '/';
+        it = detail::build_part(it, user,
+            user_.plain, detail::user_chars);
+        mark(url_impl::id_pass);
+        if(pass_.has)
+        {
+            *it++ = ':';
+            it = detail::build_part(it, pass,
+                pass_.plain, detail::password_chars);
+        }
+        if(user_.has || pass_.has)
+            *it++ = '@';
+        mark(url_impl::id_host);
+        it = detail::build_part(it, host,
+            host_.plain, detail::host_chars);
+        mark(url_impl::id_port);
+        if(has_port_)
+        {
+            *it++ = ':';
+            if(! port.empty())
+                std::memcpy(it,
+                    port.data(), port.size());
+            it += port.size();
+        }
+        u.decoded_[url_impl::id_user] =
+            static_cast<pos_t>(user_.dn);
+        u.decoded_[url_impl::id_pass] =
+            static_cast<pos_t>(pass_.dn);
+        u.decoded_[url_impl::id_host] =
+            static_cast<pos_t>(host_.dn);
+        u.host_type_ = host_.has ?
+            host_type_ : urls::host_type::name;
+        std::memcpy(
+            u.ip_addr_,
+            ip_addr_,
+            sizeof(u.ip_addr_));
+        u.port_number_ = port_number_;
+    }
+    else
+    {
+        mark(url_impl::id_pass);
+        mark(url_impl::id_host);
+        mark(url_impl::id_port);
+    }
+    mark(url_impl::id_path);
+    {
+        auto const p = it;
+        if(! pre.empty())
+            std::memcpy(it,
+                pre.data(), pre.size());
+        it += pre.size();
+        it = detail::build_part(it, path,
+            path_.plain, detail::path_chars);
+        string_view const s(p, it - p);
+        std::size_t nseg = nslash_ + (
+            pre.empty() ? 0 : 1);
+        if( ! s.empty() &&
+            s.front() != '/')
+            ++nseg;
+        u.decoded_[url_impl::id_path] =
+            static_cast<pos_t>(
+                path_.dn + pre.size());
+        u.nseg_ = static_cast<pos_t>(
+            detail::path_segments(s, nseg));
+    }
+    mark(url_impl::id_query);
+    if(query_.has)
+    {
+        *it++ = '?';
+        it = detail::build_part(it, query,
+            query_.plain, detail::query_chars);
+        u.decoded_[url_impl::id_query] =
+            static_cast<pos_t>(query_.dn);
+        u.nparam_ = static_cast<pos_t>(
+            namp_ + 1);
+    }
+    mark(url_impl::id_frag);
+    if(frag_.has)
+    {
+        *it++ = '#';
+        it = detail::build_part(it, frag,
+            frag_.plain, detail::fragment_chars);
+        u.decoded_[url_impl::id_frag] =
+            static_cast<pos_t>(frag_.dn);
+    }
+    mark(url_impl::id_end);
+    BOOST_ASSERT(
+        static_cast<std::size_t>(
+            it - start) == n);
+    *it = '\0';
+
+    u.cs_ = start;
+    u.scheme_ = scheme_id_;
+    dest.segs_.invalidate();
+    dest.parms_.invalidate();
+    dest.digest_.invalidate();
+    dest.u_ = u;
+    dest.check_invariants();
+}
+
+//------------------------------------------------
+
+url_builder&
+url_builder::
+remove_scheme() noexcept
+{
+    scheme_ = {};
+    scheme_id_ = urls::scheme::none;
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_scheme(string_view s)
+{
+    grammar::parse(
+        s, detail::scheme_rule()).value();
+    scheme_ = s;
+    scheme_id_ = string_to_scheme(s);
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_scheme(urls::scheme id)
+{
+    if(id == urls::scheme::unknown)
+        detail::throw_invalid_argument(
+            BOOST_CURRENT_LOCATION);
+    if(id == urls::scheme::none)
+        return remove_scheme();
+    scheme_ = to_string(id);
+    scheme_id_ = id;
+    return *this;
+}
+
+//------------------------------------------------
+
+url_builder&
+url_builder::
+remove_authority() noexcept
+{
+    user_ = {};
+    pass_ = {};
+    host_ = {};
+    host_type_ = urls::host_type::none;
+    return remove_port();
+}
+
+url_builder&
+url_builder::
+remove_userinfo() noexcept
+{
+    user_ = {};
+    pass_ = {};
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_user(string_view s) noexcept
+{
+    user_.s = s;
+    user_.n = pct_encode_bytes(
+        s, detail::user_chars);
+    user_.dn = s.size();
+    user_.plain = true;
+    user_.has = true;
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_encoded_user(string_view s)
+{
+    error_code ec;
+    auto const n = validate_pct_encoding(
+        s, ec, detail::user_chars, {});
+    if(ec.failed())
+        detail::throw_invalid_argument(
+            BOOST_CURRENT_LOCATION);
+    user_.s = s;
+    user_.n = s.size();
+    user_.dn = n;
+    user_.plain = false;
+    user_.has = true;
+    return *this;
+}
+
+url_builder&
+url_builder::
+remove_password() noexcept
+{
+    if(pass_.has)
+    {
+        // keep the '@'
+        pass_ = {};
+        user_.has = true;
+    }
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_password(string_view s) noexcept
+{
+    pass_.s = s;
+    pass_.n = pct_encode_bytes(
+        s, detail::password_chars);
+    pass_.dn = s.size();
+    pass_.plain = true;
+    pass_.has = true;
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_encoded_password(string_view s)
+{
+    error_code ec;
+    auto const n = validate_pct_encoding(
+        s, ec, detail::password_chars, {});
+    if(ec.failed())
+        detail::throw_invalid_argument(
+            BOOST_CURRENT_LOCATION);
+    pass_.s = s;
+    pass_.n = s.size();
+    pass_.dn = n;
+    pass_.plain = false;
+    pass_.has = true;
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_host(string_view s) noexcept
+{
+    host_.s = s;
+    host_.has = true;
+    auto rv = parse_ipv4_address(s);
+    if(rv.has_value())
+    {
+        host_.n = s.size();
+        host_.dn = s.size();
+        host_.plain = false;
+        host_type_ =
+            urls::host_type::ipv4;
+        auto const b = rv->to_bytes();
+        std::memset(ip_addr_, 0,
+            sizeof(ip_addr_));
+        std::memcpy(ip_addr_,
+            b.data(), b.size());
+        return *this;
+    }
+    host_.n = pct_encode_bytes(
+        s, detail::host_chars);
+    host_.dn = s.size();
+    host_.plain = true;
+    host_type_ =
+        urls::host_type::name;
+    std::memset(ip_addr_, 0,
+        sizeof(ip_addr_));
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_encoded_host(string_view s)
+{
+    auto t = grammar::parse(
+        s, detail::host_rule).value();
+    host_.s = s;
+    host_.n = s.size();
+    if(t.host_type ==
+            urls::host_type::name)
+        host_.dn = t.name.size();
+    else
+        host_.dn = s.size();
+    host_.plain = false;
+    host_.has = true;
+    host_type_ = t.host_type;
+    std::memcpy(
+        ip_addr_,
+        t.addr,
+        sizeof(ip_addr_));
+    return *this;
+}
+
+url_builder&
+url_builder::
+remove_port() noexcept
+{
+    port_ = {};
+    port_number_ = 0;
+    has_port_ = false;
+    print_port_ = false;
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_port(std::uint16_t n) noexcept
+{
+    port_ = {};
+    port_number_ = n;
+    has_port_ = true;
+    print_port_ = true;
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_port(string_view s)
+{
+    auto t = grammar::parse(
+        s, detail::port_rule{}).value();
+    port_ = s;
+    port_number_ = t.has_number ?
+        t.number : 0;
+    has_port_ = true;
+    print_port_ = false;
+    return *this;
+}
+
+//------------------------------------------------
+
+url_builder&
+url_builder::
+set_path(string_view s) noexcept
+{
+    path_.s = s;
+    path_.n = pct_encode_bytes(
+        s, detail::path_chars);
+    path_.dn = s.size();
+    path_.plain = true;
+    nslash_ = std::count(
+        s.begin(), s.end(), '/');
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_encoded_path(string_view s)
+{
+    error_code ec;
+    auto const n = validate_pct_encoding(
+        s, ec, detail::path_chars, {});
+    if(ec.failed())
+        detail::throw_invalid_argument(
+            BOOST_CURRENT_LOCATION);
+    path_.s = s;
+    path_.n = s.size();
+    path_.dn = n;
+    path_.plain = false;
+    nslash_ = std::count(
+        s.begin(), s.end(), '/');
+    return *this;
+}
+
+//------------------------------------------------
+
+url_builder&
+url_builder::
+remove_query() noexcept
+{
+    query_ = {};
+    namp_ = 0;
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_query(string_view s) noexcept
+{
+    query_.s = s;
+    query_.n = pct_encode_bytes(
+        s, detail::query_chars);
+    query_.dn = s.size();
+    query_.plain = true;
+    query_.has = true;
+    namp_ = std::count(
+        s.begin(), s.end(), '&');
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_encoded_query(string_view s)
+{
+    error_code ec;
+    auto const n = validate_pct_encoding(
+        s, ec, detail::query_chars, {});
+    if(ec.failed())
+        detail::throw_invalid_argument(
+            BOOST_CURRENT_LOCATION);
+    query_.s = s;
+    query_.n = s.size();
+    query_.dn = n;
+    query_.plain = false;
+    query_.has = true;
+    namp_ = std::count(
+        s.begin(), s.end(), '&');
+    return *this;
+}
+
+//------------------------------------------------
+
+url_builder&
+url_builder::
+remove_fragment() noexcept
+{
+    frag_ = {};
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_fragment(string_view s) noexcept
+{
+    frag_.s = s;
+    frag_.n = pct_encode_bytes(
+        s, detail::fragment_chars);
+    frag_.dn = s.size();
+    frag_.plain = true;
+    frag_.has = true;
+    return *this;
+}
+
+url_builder&
+url_builder::
+set_encoded_fragment(string_view s)
+{
+    error_code ec;
+    auto const n = validate_pct_encoding(
+        s, ec, detail::fragment_chars, {});
+    if(ec.failed())
+        detail::throw_invalid_argument(
+            BOOST_CURRENT_LOCATION);
+    frag_.s = s;
+    frag_.n = s.size();
+    frag_.dn = n;
+    frag_.plain = false;
+    frag_.has = true;
+    return *this;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -20,6 +20,7 @@
 #include <boost/url/rfc/origin_form_rule.hpp>
 #include <boost/url/grammar/parse.hpp>
 #include <boost/assert/source_location.hpp>
+#include <cstring>
 
 namespace boost {
 namespace urls {
@@ -133,6 +134,104 @@ parse_uri_reference(
         s, uri_reference_rule);
 }
 
+//------------------------------------------------
+
+namespace detail {
+
+// like parse_uri_reference,
+// but without throwing
+static
+result<url_view>
+parse_uri_reference_record(
+    string_view s) noexcept
+{
+    if(s.size() > url_view::max_size())
+        return error::no_space;
+    return grammar::parse(
+        s, uri_reference_rule);
+}
+
+} // detail
+
+void
+parse_uri_references(
+    string_view const* src,
+    result<url_view>* dest,
+    std::size_t n) noexcept
+{
+    for(std::size_t i = 0; i < n; ++i)
+        dest[i] = detail::
+            parse_uri_reference_record(src[i]);
+}
+
+std::size_t
+parse_uri_reference_lines(
+    string_view& s,
+    result<url_view>* dest,
+    std::size_t n) noexcept
+{
+    auto it = s.data();
+    auto const end = it + s.size();
+    std::size_t i = 0;
+    while(
+        i < n &&
+        it != end)
+    {
+        // Line breaks are not valid in any
+        // part of a URL, so the rule stops
+        // at the end of a valid record.
+        auto const first = it;
+        auto lim = end;
+        if(static_cast<std::size_t>(
+            end - it) > url_view::max_size())
+            lim = it + url_view::max_size();
+        auto rv = grammar::parse(
+            it, lim, uri_reference_rule);
+        if(rv.has_value())
+        {
+            if(it == end)
+            {
+                dest[i++] = rv;
+                continue;
+            }
+            if(*it == '\n')
+            {
+                dest[i++] = rv;
+                ++it;
+                continue;
+            }
+            if( *it == '\r' &&
+                end - it > 1 &&
+                it[1] == '\n')
+            {
+                dest[i++] = rv;
+                it += 2;
+                continue;
+            }
+        }
+
+        // parse the record by itself,
+        // to report the same error
+        auto nl = static_cast<
+            char const*>(std::memchr(
+                first, '\n', end - first));
+        if(! nl)
+            nl = end;
+        it = nl;
+        if( nl != first &&
+            nl[-1] == '\r' &&
+            nl != end)
+            --nl;
+        dest[i++] = detail::
+            parse_uri_reference_record(
+                string_view(first, nl - first));
+        if(it != end)
+            ++it;
+    }
+    s = string_view(it, end - it);
+    return i;
+}
+
 } // urls
 } // boost
 
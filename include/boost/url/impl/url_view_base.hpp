@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_VIEW_BASE_HPP
+#define BOOST_URL_IMPL_URL_VIEW_BASE_HPP
+
+#include <boost/url/detail/over_allocator.hpp>
+#include <cstring>
+#include <memory>
+
+namespace boost {
+namespace urls {
+
+// a view followed by a copy of its
+// characters, in the same allocation.
+// View is always url_view; it is a
+// parameter so that only its declaration
+// is needed here.
+template<class View>
+struct url_view_base::shared_impl
+    : View
+{
+    virtual
+    ~shared_impl()
+    {
+    }
+
+    explicit
+    shared_impl(
+        detail::url_impl const& u) noexcept
+        : View(u)
+    {
+        this->u_.cs_ = reinterpret_cast<
+            char const*>(this + 1);
+    }
+};
+
+template<class Allocator>
+std::shared_ptr<url_view const>
+url_view_base::
+persist(Allocator const& a) const
+{
+    using T = shared_impl<url_view>;
+    auto p = std::allocate_shared<T>(
+        detail::over_allocator<T, Allocator>(
+            size(), a), u_);
+    std::memcpy(
+        reinterpret_cast<char*>(
+            p.get() + 1), data(), size());
+    return p;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -12,8 +12,8 @@
 #define BOOST_URL_IMPL_URL_VIEW_BASE_IPP
 
 #include <boost/url/url_view_base.hpp>
+#include <boost/url/url_view.hpp>
 #include <boost/url/detail/except.hpp>
-#include <boost/url/detail/over_allocator.hpp>
 
 namespace boost {
 namespace urls {
@@ -39,16 +39,28 @@ std::size_t
 url_view_base::
 digest(std::size_t salt) const noexcept
 {
-    detail::fnv_1a h(salt);
-    detail::ci_digest(u_.get(id_scheme), h);
-    detail::digest_encoded(u_.get(id_user), h);
-    detail::digest_encoded(u_.get(id_pass), h);
-    detail::ci_digest_encoded(u_.get(id_host), h);
-    h.put(u_.get(id_port));
+    // The parts are the ones compare uses,
+    // without their delimiters, so urls
+    // which compare equal have the same
+    // digest. Each is followed by a null
+    // to keep the parts apart.
+    detail::block_hasher h(salt);
+    detail::ci_digest(scheme(), h);
+    h.put('\0');
+    detail::digest_encoded(encoded_user(), h);
+    h.put('\0');
+    detail::digest_encoded(encoded_password(), h);
+    h.put('\0');
+    detail::ci_digest_encoded(encoded_host(), h);
+    h.put('\0');
+    h.put(port());
+    h.put('\0');
     detail::normalized_path_digest(
-        u_.get(id_path), is_path_absolute(), h);
-    detail::digest_encoded(u_.get(id_query), h);
-    detail::digest_encoded(u_.get(id_frag), h);
+        encoded_path(), is_path_absolute(), h);
+    h.put('\0');
+    detail::digest_encoded(encoded_query(), h);
+    h.put('\0');
+    detail::digest_encoded(encoded_fragment(), h);
     return h.digest();
 }
 
@@ -58,37 +70,12 @@ digest(std::size_t salt) const noexcept
 //
 //------------------------------------------------
 
-struct url_view_base::shared_impl
-    : url_view
-{
-    virtual
-    ~shared_impl()
-    {
-    }
-
-    shared_impl(
-        url_view const& u) noexcept
-        : url_view(u)
-    {
-        u_.cs_ = reinterpret_cast<
-            char const*>(this + 1);
-    }
-};
-
 std::shared_ptr<url_view const>
 url_view_base::
 persist() const
 {
-    using T = shared_impl;
-    using Alloc = std::allocator<char>;
-    Alloc a;
-    auto p = std::allocate_shared<T>(
-        detail::over_allocator<T, Alloc>(
-            size(), a), url_view(u_));
-    std::memcpy(
-        reinterpret_cast<char*>(
-            p.get() + 1), data(), size());
-    return p;
+    return persist(
+        std::allocator<char>{});
 }
 
 //------------------------------------------------
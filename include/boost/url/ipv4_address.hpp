@@ -308,6 +308,55 @@ result<ipv4_address>
 parse_ipv4_address(
     string_view s) noexcept;
 
+/** Format a range of addresses into one buffer
+
+    This function writes each address in the
+    range `[src, src + n)` to `dest`, in the
+    same form as @ref ipv4_address::to_buffer,
+    followed by the character `sep`. The
+    output for all the addresses is
+    contiguous, without terminating null.
+
+    @par Example
+    @code
+    ipv4_address const src[] = { ipv4_address( 0x7f000001 ), ipv4_address( 0xc0a80001 ) };
+    char buf[ 2 * ( ipv4_address::max_str_len + 1 ) ];
+
+    std::size_t n = print_ipv4_addresses( buf, sizeof( buf ), src, 2 );
+
+    assert( string_view( buf, n ) == "127.0.0.1\n192.168.0.1\n" );
+    @endcode
+
+    @par Exception Safety
+    Throws nothing if the buffer is large enough.
+
+    @return The number of characters written.
+
+    @param dest The buffer to write to.
+
+    @param dest_size The size of the buffer.
+
+    @param src A pointer to the addresses.
+
+    @param n The number of addresses.
+
+    @param sep The character written after
+    each address.
+
+    @throw std::length_error `dest_size < n * (ipv4_address::max_str_len + 1)`
+
+    @see
+        @ref ipv4_address::to_buffer.
+*/
+BOOST_URL_DECL
+std::size_t
+print_ipv4_addresses(
+    char* dest,
+    std::size_t dest_size,
+    ipv4_address const* src,
+    std::size_t n,
+    char sep = '\n');
+
 } // urls
 } // boost
 
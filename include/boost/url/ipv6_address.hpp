@@ -361,6 +361,55 @@ result<ipv6_address>
 parse_ipv6_address(
     string_view s) noexcept;
 
+/** Format a range of addresses into one buffer
+
+    This function writes each address in the
+    range `[src, src + n)` to `dest`, in the
+    same form as @ref ipv6_address::to_buffer,
+    followed by the character `sep`. The
+    output for all the addresses is
+    contiguous, without terminating null.
+
+    @par Example
+    @code
+    ipv6_address const src[] = { ipv6_address( "::1" ), ipv6_address( "2001:db8::1" ) };
+    char buf[ 2 * ( ipv6_address::max_str_len + 1 ) ];
+
+    std::size_t n = print_ipv6_addresses( buf, sizeof( buf ), src, 2, ' ' );
+
+    assert( string_view( buf, n ) == "::1 2001:db8::1 " );
+    @endcode
+
+    @par Exception Safety
+    Throws nothing if the buffer is large enough.
+
+    @return The number of characters written.
+
+    @param dest The buffer to write to.
+
+    @param dest_size The size of the buffer.
+
+    @param src A pointer to the addresses.
+
+    @param n The number of addresses.
+
+    @param sep The character written after
+    each address.
+
+    @throw std::length_error `dest_size < n * (ipv6_address::max_str_len + 1)`
+
+    @see
+        @ref ipv6_address::to_buffer.
+*/
+BOOST_URL_DECL
+std::size_t
+print_ipv6_addresses(
+    char* dest,
+    std::size_t dest_size,
+    ipv6_address const* src,
+    std::size_t n,
+    char sep = '\n');
+
 } // urls
 } // boost
 
@@ -0,0 +1,186 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_PARALLEL_PARSE_HPP
+#define BOOST_URL_PARALLEL_PARSE_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/result.hpp>
+#include <boost/url/string_view.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+#ifndef BOOST_URL_DOCS
+namespace detail {
+
+struct any_lines_handler
+{
+    virtual
+    ~any_lines_handler() noexcept = default;
+
+    // Called once with the number of
+    // records, before any chunk.
+    virtual
+    void
+    on_count(std::size_t n) = 0;
+
+    // Called concurrently with consecutive
+    // records starting at record number
+    // index, which end at a line break
+    // or at the end of the input.
+    virtual
+    void
+    on_chunk(
+        std::size_t index,
+        string_view chunk) = 0;
+};
+
+void
+parallel_parse_lines(
+    string_view s,
+    std::size_t threads,
+    any_lines_handler& h);
+
+} // detail
+#endif
+
+/** Parse newline-delimited URL strings in parallel
+
+    This function parses each record in the
+    buffer `s` as a <em>URI-reference</em>,
+    using several threads, and returns the
+    results in the order of the records.
+    Records are delimited as described in
+    @ref parse_uri_reference_lines, and the
+    result for each record is the same.
+    <br>
+    The buffer is split at line breaks into
+    chunks which the threads parse
+    independently, each writing directly to
+    its own range of the returned results.
+    Ownership of the buffer is not transferred;
+    the caller is responsible for ensuring
+    that its lifetime extends until the
+    returned views are no longer being
+    accessed.
+
+    @par Example
+    @code
+    string_view s = "https://www.example.com/\n/index.htm?q=1\n";
+
+    std::vector< result< url_view > > v = parallel_parse_uri_reference_lines( s );
+
+    assert( v.size() == 2 );
+    @endcode
+
+    @par Exception Safety
+    Strong guarantee.
+    Calls to allocate may throw, and
+    `std::system_error` is thrown if a
+    thread cannot be started.
+
+    @return The results, one per record.
+
+    @param s The buffer to parse.
+
+    @param threads The number of threads to
+    use, including the calling thread. If
+    this is zero, the value returned by
+    `std::thread::hardware_concurrency`
+    is used.
+
+    @par Remarks
+    This function is header-only, and is not
+    included by `<boost/url.hpp>`. Programs
+    which call it must link with the
+    threads library.
+
+    @see
+        @ref parse_uri_reference_lines.
+*/
+std::vector<result<url_view>>
+parallel_parse_uri_reference_lines(
+    string_view s,
+    std::size_t threads = 0);
+
+/** Parse newline-delimited URL strings in parallel
+
+    This function parses each record in the
+    buffer `s` as a <em>URI-reference</em>,
+    using several threads, and passes the
+    results to the handler in batches, as
+    they become available. Records are
+    delimited as described in
+    @ref parse_uri_reference_lines, and the
+    result for each record is the same.
+    <br>
+    The handler is invoked concurrently from
+    each thread, and the batches are not
+    delivered in order. The handler must
+    have this equivalent signature:
+    @code
+    void( std::size_t index, result< url_view > const* r, std::size_t n );
+    @endcode
+    Each invocation delivers the results of
+    the `n` consecutive records numbered from
+    `index`, counting from zero at the start
+    of `s`. If the handler throws, the
+    remaining batches are abandoned and the
+    exception is rethrown to the caller after
+    every thread has stopped.
+
+    @par Example
+    @code
+    std::atomic< std::size_t > errors( 0 );
+
+    parallel_parse_uri_reference_lines( s, 0,
+        [&]( std::size_t, result< url_view > const* r, std::size_t n )
+        {
+            for( std::size_t i = 0; i < n; ++i )
+                if( r[ i ].has_error() )
+                    ++errors;
+        });
+    @endcode
+
+    @par Exception Safety
+    Basic guarantee.
+    Exceptions thrown by the handler are
+    propagated, and `std::system_error` is
+    thrown if a thread cannot be started.
+
+    @param s The buffer to parse.
+
+    @param threads The number of threads to
+    use, including the calling thread. If
+    this is zero, the value returned by
+    `std::thread::hardware_concurrency`
+    is used.
+
+    @param h The handler to invoke.
+
+    @see
+        @ref parse_uri_reference_lines.
+*/
+template<class Handler>
+void
+parallel_parse_uri_reference_lines(
+    string_view s,
+    std::size_t threads,
+    Handler&& h);
+
+} // urls
+} // boost
+
+#include <boost/url/impl/parallel_parse.hpp>
+
+#endif
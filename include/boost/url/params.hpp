@@ -241,6 +241,12 @@ public:
     iterator
     end() const noexcept;
 
+private:
+    iterator
+    iterator_at(
+        std::size_t i) const noexcept;
+public:
+
     //--------------------------------------------
     //
     // Capacity
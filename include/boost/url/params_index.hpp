@@ -0,0 +1,291 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_PARAMS_INDEX_HPP
+#define BOOST_URL_PARAMS_INDEX_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/params_encoded_view.hpp>
+#include <boost/url/string_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+#ifndef BOOST_URL_DOCS
+class url_view_base;
+#endif
+
+/** A hash index over encoded query parameters
+
+    Objects of this type index the keys of a
+    range of encoded query parameters, so that
+    looking up a key takes constant time on
+    average instead of a scan over every
+    parameter. Keys are compared as if they
+    were percent-decoded, with the same results
+    as the lookup functions of
+    @ref params_encoded_view.
+
+    The index is built once, which allocates
+    memory and runs in linear time on the size
+    of the query. It is worth building when
+    several keys are looked up in the same
+    query.
+
+    Ownership of the underlying characters is
+    not transferred; the character buffer used
+    to construct the index must remain valid
+    and unmodified for as long as the index
+    is used.
+
+    @par Example
+    @code
+    url_view u( "https://www.example.com/?utm_source=mail&id=42&utm_medium=email" );
+
+    params_index idx( u );
+
+    assert( idx.contains( "id" ) );
+    assert( (*idx.find( "utm_source" )).value == "mail" );
+    @endcode
+
+    @par Complexity
+    Lookups run in constant time on average,
+    plus linear time on the size of the key.
+    Functions returning iterators also run in
+    linear time on the size of the parameter
+    found.
+
+    @see
+        @ref params_encoded_view.
+*/
+class params_index
+{
+    struct entry;
+
+    params_encoded_view v_;
+    entry* e_ = nullptr;
+    std::size_t* slots_ = nullptr;
+    std::size_t mask_ = 0;
+
+    BOOST_URL_DECL
+    void
+    build();
+
+    BOOST_URL_DECL
+    std::size_t
+    lookup(string_view key) const noexcept;
+
+    params_encoded_view::iterator
+    iterator_at(
+        std::size_t i) const noexcept;
+
+public:
+    /** A read-only forward iterator to an encoded query parameter.
+    */
+    using iterator =
+        params_encoded_view::iterator;
+
+    /// @copydoc iterator
+    using const_iterator = iterator;
+
+    /** Destructor
+    */
+    BOOST_URL_DECL
+    ~params_index();
+
+    /** Constructor
+
+        A default-constructed index refers
+        to an empty range.
+    */
+    params_index() = default;
+
+    /** Constructor
+
+        The index is built from the specified
+        range of encoded parameters.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param v The parameters to index.
+    */
+    BOOST_URL_DECL
+    explicit
+    params_index(
+        params_encoded_view const& v);
+
+    /** Constructor
+
+        The index is built from the parameters
+        in the query of the specified url.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The url whose query is indexed.
+    */
+    BOOST_URL_DECL
+    explicit
+    params_index(
+        url_view_base const& u);
+
+    /** Constructor
+
+        After the copy both indexes refer to
+        the same character buffer.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    params_index(
+        params_index const& other);
+
+    /** Constructor
+
+        After the move the moved-from index
+        refers to an empty range.
+    */
+    BOOST_URL_DECL
+    params_index(
+        params_index&& other) noexcept;
+
+    /** Assignment
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    params_index&
+    operator=(params_index const& other);
+
+    /** Assignment
+
+        After the move the moved-from index
+        refers to an empty range.
+    */
+    BOOST_URL_DECL
+    params_index&
+    operator=(params_index&& other) noexcept;
+
+    //--------------------------------------------
+
+    /** Return the indexed parameters
+    */
+    params_encoded_view const&
+    params() const noexcept
+    {
+        return v_;
+    }
+
+    /** Return an iterator to the beginning
+    */
+    iterator
+    begin() const noexcept
+    {
+        return v_.begin();
+    }
+
+    /** Return an iterator to the end
+    */
+    iterator
+    end() const noexcept
+    {
+        return v_.end();
+    }
+
+    /** Return true if the range contains no elements
+    */
+    bool
+    empty() const noexcept
+    {
+        return v_.empty();
+    }
+
+    /** Return the number of elements
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return v_.size();
+    }
+
+    //--------------------------------------------
+    //
+    // Lookup
+    //
+    //--------------------------------------------
+
+    /** Return the number of matching elements.
+
+        This function returns the total number
+        of elements whose key matches the
+        specified encoded string.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @return The number of elements.
+
+        @param key The encoded key.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    count(string_view key) const noexcept;
+
+    /** Return the first element matching the key
+
+        This function returns the first
+        element which matches the specified
+        percent-encoded key. If no element
+        matches, then an iterator to the end
+        is returned.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @return An iterator to the element.
+
+        @param key The encoded key.
+    */
+    BOOST_URL_DECL
+    iterator
+    find(string_view key) const noexcept;
+
+    /** Return true if at least one matching element exists.
+
+        This function returns true if at least one
+        element matches the specified percent-encoded
+        key.
+
+        @par Exception Safety
+        Throws nothing.
+
+        @return `true` if a matching element exists.
+
+        @param key The encoded key.
+    */
+    bool
+    contains(string_view key) const noexcept
+    {
+        return lookup(key) != v_.size();
+    }
+};
+
+} // urls
+} // boost
+
+#endif
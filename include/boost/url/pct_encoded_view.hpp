@@ -397,8 +397,9 @@ public:
     std::string
     to_string() const
     {
-        std::string r;
-        assign_to(r);
+        std::string r(size(), '\0');
+        if(! r.empty())
+            copy(&r[0], r.size());
         return r;
     }
 
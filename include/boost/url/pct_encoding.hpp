@@ -556,6 +556,69 @@ pct_encode(
     CharSet const& allowed,
     pct_encode_opts const& opt = {});
 
+/** Write a string with percent-encoding into a buffer, without measuring.
+
+    This function applies percent-encoding to
+    the given plain string, by escaping all
+    characters that are not in the specified
+    <em>CharSet</em>, in a single pass.
+    No character encodes to more than three,
+    so the output is never larger than
+    `3 * s.size()`. A buffer of that size
+    can be used instead of calling
+    @ref pct_encode_bytes first.
+
+    @par Example
+    @code
+    string_view s = "Program Files";
+    std::unique_ptr< char[] > dest( new char[ 3 * s.size() ] );
+    std::size_t n = pct_encode_unchecked( dest.get(), s, pchars );
+
+    assert( string_view( dest.get(), n ) == "Program%20Files" );
+    @endcode
+
+    @par Preconditions
+    @code
+    dest != nullptr || s.empty()
+    @endcode
+    The buffer pointed to by `dest` holds
+    at least `3 * s.size()` characters.
+
+    @par Exception Safety
+    Throws nothing.
+
+    @return The number of characters written.
+
+    @param dest A pointer to the beginning
+    of the output buffer.
+
+    @param s The string to encode.
+
+    @param allowed The set of characters
+    allowed to appear unescaped.
+    This type must satisfy the requirements
+    of <em>CharSet</em>.
+
+    @param opt The options for encoding. If
+    this parameter is omitted, the default
+    options will be used.
+
+    @par Specification
+    @li <a href="https://datatracker.ietf.org/doc/html/rfc3986#section-2.1"
+        >2.1. Percent-Encoding (rfc3986)</a>
+
+    @see
+        @ref pct_encode,
+        @ref pct_encode_bytes.
+*/
+template <class CharSet>
+std::size_t
+pct_encode_unchecked(
+    char* dest,
+    string_view s,
+    CharSet const& allowed,
+    pct_encode_opts const& opt = {}) noexcept;
+
 /** Return a string with percent-encoding applied
 
     This function applies percent-encoding to
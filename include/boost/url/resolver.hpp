@@ -0,0 +1,267 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_RESOLVER_HPP
+#define BOOST_URL_RESOLVER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/string_view.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** Resolves URL references against one base URL
+
+    Objects of this type hold a copy of a base
+    URL, and resolve references against it as
+    described in rfc3986. The result of each
+    resolution is the same as that of
+    @ref resolve called with the base.
+    <br>
+    The parts of the work which depend only
+    on the base, such as finding the part of
+    its path that is kept when a relative path
+    is merged, are done once when the resolver
+    is constructed. This makes a resolver
+    worth using when many references, such as
+    the links found on one page, are resolved
+    against the same base.
+    <br>
+    References may be resolved into
+    containers, or into views of storage owned
+    by the resolver. The storage is reused by
+    later calls, so that resolving batches of
+    references does not allocate once it has
+    grown to fit.
+
+    @par Example
+    @code
+    resolver r( url_view( "http://www.example.com/docs/index.htm" ) );
+
+    url_view refs[ 2 ] = { url_view( "../img/logo.png" ), url_view( "?page=2" ) };
+    url_view dest[ 2 ];
+
+    r.resolve( refs, dest, 2 );
+
+    assert( dest[ 0 ].string() == "http://www.example.com/img/logo.png" );
+    assert( dest[ 1 ].string() == "http://www.example.com/docs/index.htm?page=2" );
+    @endcode
+
+    @par Specification
+    <a href="https://datatracker.ietf.org/doc/html/rfc3986#section-5"
+        >5. Reference Resolution (rfc3986)</a>
+
+    @see
+        @ref resolve.
+*/
+class resolver
+{
+    url base_;
+    string_view merge_;
+    char* buf_ = nullptr;
+    std::size_t cap_ = 0;
+
+public:
+    /** Destructor
+
+        Views returned by the resolver are
+        invalidated.
+    */
+    BOOST_URL_DECL
+    ~resolver();
+
+    /** Constructor
+
+        The resolver holds a copy of the
+        specified base URL, which must satisfy
+        the <em>absolute-URI</em> grammar
+        except that it may have a fragment.
+
+        @par BNF
+        @code
+        absolute-URI  = scheme ":" hier-part [ "?" query ]
+        @endcode
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @throw system_error The base has
+        no scheme, with the error
+        @ref error::not_a_base.
+
+        @param base The base URL to resolve
+        against.
+    */
+    BOOST_URL_DECL
+    explicit
+    resolver(
+        url_view_base const& base);
+
+    /** Constructor
+
+        The new resolver holds a copy of the
+        base of `other`. Storage used for views
+        is not shared.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    resolver(
+        resolver const& other);
+
+    /** Constructor
+
+        Views returned by `other` remain valid,
+        and now refer to storage owned by the
+        new resolver.
+    */
+    BOOST_URL_DECL
+    resolver(
+        resolver&& other) noexcept;
+
+    /** Assignment
+
+        Views returned by this resolver are
+        invalidated.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    resolver&
+    operator=(resolver const& other);
+
+    /** Assignment
+
+        Views returned by this resolver are
+        invalidated. Views returned by `other`
+        remain valid, and now refer to storage
+        owned by this resolver.
+    */
+    BOOST_URL_DECL
+    resolver&
+    operator=(resolver&& other) noexcept;
+
+    //--------------------------------------------
+
+    /** Return the base URL
+    */
+    url_view
+    base() const noexcept
+    {
+        return base_;
+    }
+
+    /** Resolve a URL reference
+
+        This function resolves the reference
+        `ref` against the base and places the
+        result in `dest`.
+        The reference may be `dest`, or
+        refer to its contents.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to allocate may throw.
+
+        @param ref The URL reference to resolve.
+
+        @param dest The container where the
+        result is written.
+    */
+    BOOST_URL_DECL
+    void
+    resolve(
+        url_view_base const& ref,
+        url_base& dest) const;
+
+    /** Resolve URL references into containers
+
+        This function resolves each of the `n`
+        references starting at `src` against
+        the base, and places the results in the
+        corresponding elements of `dest`.
+        Containers in `dest` keep their storage
+        when the result fits, so a batch of
+        containers which is reused allocates
+        less with each call.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to allocate may throw.
+
+        @param src A pointer to the references
+        to resolve.
+
+        @param dest A pointer to an array of at
+        least `n` containers which receive the
+        results.
+
+        @param n The number of references.
+    */
+    BOOST_URL_DECL
+    void
+    resolve(
+        url_view const* src,
+        url* dest,
+        std::size_t n) const;
+
+    /** Resolve URL references into views
+
+        This function resolves each of the `n`
+        references starting at `src` against
+        the base, and places the results in the
+        corresponding elements of `dest`.
+        The results are stored one after the
+        other in storage owned by the
+        resolver, which the returned views
+        refer to. They remain valid until the
+        next call to this function, or until
+        the resolver is destroyed or assigned.
+        <br>
+        The references may refer to views
+        returned by a previous call.
+        The storage grows as needed, and is
+        reused by later calls.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to allocate may throw.
+        If an exception is thrown, views
+        returned by a previous call remain
+        valid.
+
+        @param src A pointer to the references
+        to resolve.
+
+        @param dest A pointer to an array of at
+        least `n` views which receive the
+        results.
+
+        @param n The number of references.
+    */
+    BOOST_URL_DECL
+    void
+    resolve(
+        url_view const* src,
+        url_view* dest,
+        std::size_t n);
+};
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_RFC_DETAIL_FUSED_RULES_HPP
+#define BOOST_URL_RFC_DETAIL_FUSED_RULES_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/detail/url_impl.hpp>
+#include <boost/url/result.hpp>
+#include <boost/url/url_view.hpp>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+/*  The fused parsers
+
+    These scan a URI, relative-ref,
+    URI-reference, or origin-form in a
+    single pass, filling in the offsets,
+    decoded sizes, and the rest of the
+    url_impl as they go.
+
+    They only accept inputs for which the
+    result is certain to be identical to
+    what the rule-by-rule grammar produces.
+    For anything else, such as a malformed
+    escape or a match which ends on a
+    character that could continue some
+    other part of the URL, they return
+    false and leave `it` unchanged. The
+    caller then uses the grammar-based
+    rules below, which produce the error
+    or the unusual match.
+
+    The origin-form parser is tuned for
+    HTTP request targets. It classifies
+    sixteen characters at a time, counting
+    the segments and params as it goes.
+
+    Defining BOOST_URL_NO_FUSED_PARSER when
+    building the library turns the fused
+    parsers off.
+*/
+
+bool
+parse_uri_fused(
+    char const*& it,
+    char const* end,
+    url_impl& u) noexcept;
+
+bool
+parse_relative_ref_fused(
+    char const*& it,
+    char const* end,
+    url_impl& u) noexcept;
+
+bool
+parse_uri_reference_fused(
+    char const*& it,
+    char const* end,
+    url_impl& u) noexcept;
+
+bool
+parse_origin_form_fused(
+    char const*& it,
+    char const* end,
+    url_impl& u) noexcept;
+
+//------------------------------------------------
+
+/*  The grammar-based rules
+
+    These are the rule-by-rule
+    implementations of uri_rule,
+    relative_ref_rule, uri_reference_rule,
+    and origin_form_rule.
+*/
+
+struct uri_grammar_rule_t
+{
+    using value_type = url_view;
+
+    BOOST_URL_DECL
+    auto
+    parse(
+        char const*& it,
+        char const* end
+            ) const noexcept ->
+        result<value_type>;
+};
+
+constexpr uri_grammar_rule_t uri_grammar_rule{};
+
+struct relative_ref_grammar_rule_t
+{
+    using value_type = url_view;
+
+    BOOST_URL_DECL
+    auto
+    parse(
+        char const*& it,
+        char const* end
+            ) const noexcept ->
+        result<value_type>;
+};
+
+constexpr relative_ref_grammar_rule_t relative_ref_grammar_rule{};
+
+struct uri_reference_grammar_rule_t
+{
+    using value_type = url_view;
+
+    BOOST_URL_DECL
+    auto
+    parse(
+        char const*& it,
+        char const* end
+            ) const noexcept ->
+        result<value_type>;
+};
+
+constexpr uri_reference_grammar_rule_t uri_reference_grammar_rule{};
+
+struct origin_form_grammar_rule_t
+{
+    using value_type = url_view;
+
+    BOOST_URL_DECL
+    auto
+    parse(
+        char const*& it,
+        char const* end
+            ) const noexcept ->
+        result<value_type>;
+};
+
+constexpr origin_form_grammar_rule_t origin_form_grammar_rule{};
+
+} // detail
+} // urls
+} // boost
+
+#endif
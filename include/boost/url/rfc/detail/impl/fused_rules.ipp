@@ -0,0 +1,622 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_RFC_DETAIL_IMPL_FUSED_RULES_IPP
+#define BOOST_URL_RFC_DETAIL_IMPL_FUSED_RULES_IPP
+
+#include <boost/url/rfc/detail/fused_rules.hpp>
+#include <boost/url/rfc/gen_delim_chars.hpp>
+#include <boost/url/rfc/detail/charsets.hpp>
+#include <boost/url/rfc/detail/host_rule.hpp>
+#include <boost/url/rfc/detail/port_rule.hpp>
+#include <boost/url/detail/path.hpp>
+#include <boost/url/grammar/alpha_chars.hpp>
+#include <boost/url/grammar/digit_chars.hpp>
+#include <boost/url/grammar/hexdig_chars.hpp>
+#include <boost/url/grammar/parse.hpp>
+#include <boost/url/grammar/detail/charset.hpp>
+#include <boost/core/bit.hpp>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// segment-nz-nc
+static
+constexpr
+auto
+fused_nc_chars =
+    pchars - ':';
+
+static
+constexpr
+grammar::lut_chars
+fused_scheme_chars(
+    "0123456789" "+-."
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    "abcdefghijklmnopqrstuvwxyz");
+
+// Every character which can appear
+// in some part of a URL. A match which
+// stops on one of these might have
+// stopped elsewhere with different
+// rules, so the grammar decides.
+static
+constexpr
+auto
+fused_url_chars =
+    unreserved_chars +
+    sub_delim_chars +
+    gen_delim_chars + '%';
+
+// Advance it over characters in cs and
+// valid escapes, counting the escapes
+// and each occurrence of delim. Returns
+// false on a malformed escape.
+static
+bool
+fused_scan(
+    char const*& it,
+    char const* const end,
+    grammar::lut_chars const& cs,
+    char delim,
+    std::size_t& ndelim,
+    std::size_t& npct) noexcept
+{
+    auto p = it;
+    while(p != end)
+    {
+        char const c = *p;
+        if(cs(c))
+        {
+            if(c == delim)
+                ++ndelim;
+            ++p;
+            continue;
+        }
+        if(c != '%')
+            break;
+        if( end - p < 3 ||
+            ! grammar::hexdig_chars(p[1]) ||
+            ! grammar::hexdig_chars(p[2]))
+            return false;
+        ++npct;
+        p += 3;
+    }
+    it = p;
+    return true;
+}
+
+// Returns one past the ':' ending a
+// scheme, or nullptr if there is none.
+static
+char const*
+fused_scheme(
+    char const* it,
+    char const* const end) noexcept
+{
+    if( it == end ||
+        ! grammar::alpha_chars(*it))
+        return nullptr;
+    ++it;
+    while( it != end &&
+        fused_scheme_chars(*it))
+        ++it;
+    if( it == end ||
+        *it != ':')
+        return nullptr;
+    return it + 1;
+}
+
+// Parse everything after the scheme,
+// given the start of the string in
+// u.cs_. Scheme-less strings use the
+// path-noscheme rule in place of
+// path-rootless.
+static
+bool
+fused_parse_rest(
+    char const*& it,
+    char const* const end,
+    url_impl& u,
+    bool relative) noexcept
+{
+    auto const start = u.cs_;
+    auto p = it;
+    std::size_t nd = 0;
+    std::size_t npct;
+    std::size_t nseg = 0;
+
+    u.offset_[url_impl::id_user] =
+        static_cast<pos_t>(p - start);
+    if( end - p >= 2 &&
+        p[0] == '/' &&
+        p[1] == '/')
+    {
+        // "//" authority
+        p += 2;
+        auto const a = p;
+
+        // [ userinfo "@" ]
+        std::size_t nu = 0;
+        if(! fused_scan(p, end,
+                user_chars, 0, nd, nu))
+            return false;
+        auto const user_end = p;
+        std::size_t np = 0;
+        if( p != end &&
+            *p == ':')
+        {
+            ++p;
+            if(! fused_scan(p, end,
+                    password_chars, 0, nd, np))
+                return false;
+        }
+        if( p != end &&
+            *p == '@')
+        {
+            u.offset_[url_impl::id_pass] =
+                static_cast<pos_t>(
+                    user_end - start);
+            u.decoded_[url_impl::id_user] =
+                static_cast<pos_t>(
+                    (user_end - a) - 2 * nu);
+            if(p != user_end)
+                u.decoded_[url_impl::id_pass] =
+                    static_cast<pos_t>(
+                        (p - user_end - 1) - 2 * np);
+            ++p;
+        }
+        else
+        {
+            p = a;
+            u.offset_[url_impl::id_pass] =
+                static_cast<pos_t>(p - start);
+        }
+        u.offset_[url_impl::id_host] =
+            static_cast<pos_t>(p - start);
+
+        // host
+        if( p != end && (
+            *p == '[' ||
+            grammar::digit_chars(*p)))
+        {
+            // IP-literal or IPv4address,
+            // either of which may still
+            // turn out to be a reg-name
+            auto rv = grammar::parse(
+                p, end, host_rule);
+            if(! rv)
+                return false;
+            u.host_type_ = rv->host_type;
+            std::memcpy(
+                u.ip_addr_,
+                rv->addr,
+                sizeof(u.ip_addr_));
+            if(rv->host_type ==
+                    urls::host_type::name)
+                u.decoded_[url_impl::id_host] =
+                    static_cast<pos_t>(
+                        rv->name.size());
+            else
+                u.decoded_[url_impl::id_host] =
+                    static_cast<pos_t>(
+                        rv->match.size());
+        }
+        else
+        {
+            // reg-name
+            auto const h = p;
+            npct = 0;
+            if(! fused_scan(p, end,
+                    reg_name_chars, 0, nd, npct))
+                return false;
+            u.host_type_ =
+                urls::host_type::name;
+            u.decoded_[url_impl::id_host] =
+                static_cast<pos_t>(
+                    (p - h) - 2 * npct);
+        }
+        u.offset_[url_impl::id_port] =
+            static_cast<pos_t>(p - start);
+
+        // [ ":" port ]
+        if( p != end &&
+            *p == ':')
+        {
+            ++p;
+            auto rv = grammar::parse(
+                p, end, port_rule{});
+            if(! rv)
+                return false;
+            u.port_number_ = rv->number;
+        }
+        u.offset_[url_impl::id_path] =
+            static_cast<pos_t>(p - start);
+
+        // path-abempty
+        npct = 0;
+        if( p != end &&
+            *p == '/' &&
+            ! fused_scan(p, end,
+                path_chars, '/', nseg, npct))
+            return false;
+    }
+    else
+    {
+        u.offset_[url_impl::id_pass] =
+            static_cast<pos_t>(p - start);
+        u.offset_[url_impl::id_host] = u.offset_[url_impl::id_pass];
+        u.offset_[url_impl::id_port] = u.offset_[url_impl::id_pass];
+        u.offset_[url_impl::id_path] = u.offset_[url_impl::id_pass];
+
+        npct = 0;
+        if(p == end)
+        {
+            // path-empty
+        }
+        else if(*p == '/')
+        {
+            // path-absolute
+            if(! fused_scan(p, end,
+                    path_chars, '/', nseg, npct))
+                return false;
+        }
+        else if(relative)
+        {
+            // path-noscheme, or
+            // path-empty if that fails
+            auto const p0 = p;
+            if(! fused_scan(p, end,
+                    fused_nc_chars, 0, nd, npct))
+                return false;
+            if(p != p0)
+            {
+                nseg = 1;
+                if( p != end &&
+                    *p == '/' &&
+                    ! fused_scan(p, end,
+                        path_chars, '/', nseg, npct))
+                    return false;
+            }
+        }
+        else
+        {
+            // path-rootless, or
+            // path-empty if that fails
+            if(! fused_scan(p, end,
+                    path_chars, '/', nseg, npct))
+                return false;
+            if(p != it)
+                ++nseg;
+        }
+    }
+    {
+        auto const s = string_view(
+            start + u.offset_[url_impl::id_path],
+            p - start - u.offset_[url_impl::id_path]);
+        u.decoded_[url_impl::id_path] =
+            static_cast<pos_t>(
+                s.size() - 2 * npct);
+        u.nseg_ = static_cast<pos_t>(
+            path_segments(s, nseg));
+    }
+    u.offset_[url_impl::id_query] =
+        static_cast<pos_t>(p - start);
+
+    // [ "?" query ]
+    if( p != end &&
+        *p == '?')
+    {
+        ++p;
+        auto const q = p;
+        std::size_t namp = 0;
+        npct = 0;
+        if(! fused_scan(p, end,
+                query_chars, '&', namp, npct))
+            return false;
+        u.nparam_ = static_cast<pos_t>(
+            1 + namp);
+        u.decoded_[url_impl::id_query] =
+            static_cast<pos_t>(
+                (p - q) - 2 * npct);
+    }
+    u.offset_[url_impl::id_frag] =
+        static_cast<pos_t>(p - start);
+
+    // [ "#" fragment ]
+    if( p != end &&
+        *p == '#')
+    {
+        ++p;
+        auto const f = p;
+        npct = 0;
+        if(! fused_scan(p, end,
+                fragment_chars, 0, nd, npct))
+            return false;
+        u.decoded_[url_impl::id_frag] =
+            static_cast<pos_t>(
+                (p - f) - 2 * npct);
+    }
+    u.offset_[url_impl::id_end] =
+        static_cast<pos_t>(p - start);
+
+    if( p != end &&
+        fused_url_chars(*p))
+        return false;
+    it = p;
+    return true;
+}
+
+bool
+parse_uri_fused(
+    char const*& it,
+    char const* end,
+    url_impl& u) noexcept
+{
+    auto p = fused_scheme(it, end);
+    if(! p)
+        return false;
+    u.cs_ = it;
+    u.scheme_ = string_to_scheme(
+        string_view(it, p - it - 1));
+    if(! fused_parse_rest(
+            p, end, u, false))
+        return false;
+    it = p;
+    return true;
+}
+
+bool
+parse_relative_ref_fused(
+    char const*& it,
+    char const* end,
+    url_impl& u) noexcept
+{
+    u.cs_ = it;
+    return fused_parse_rest(
+        it, end, u, true);
+}
+
+bool
+parse_uri_reference_fused(
+    char const*& it,
+    char const* end,
+    url_impl& u) noexcept
+{
+    // Every string with a scheme is
+    // either a URI, or something the
+    // fused parsers decline, because
+    // path-noscheme would stop at the ':'
+    if(fused_scheme(it, end))
+        return parse_uri_fused(
+            it, end, u);
+    return parse_relative_ref_fused(
+        it, end, u);
+}
+
+//------------------------------------------------
+
+#ifdef BOOST_URL_USE_SSE2
+
+// 0xff in the lanes of v holding
+// a char in path_chars
+static
+__m128i
+origin_match_16(__m128i v) noexcept
+{
+    auto const eq = [&v](char c)
+    {
+        return _mm_cmpeq_epi8(
+            v, _mm_set1_epi8(c));
+    };
+    // lo < c < hi, as signed chars
+    auto const in = [&v](char lo, char hi)
+    {
+        return _mm_and_si128(
+            _mm_cmpgt_epi8(v, _mm_set1_epi8(lo)),
+            _mm_cmplt_epi8(v, _mm_set1_epi8(hi)));
+    };
+    // the printable chars, less
+    // those which are not pchars
+    __m128i bad = _mm_or_si128(
+        in(0x21, 0x24), eq(0x25));
+    bad = _mm_or_si128(bad, eq(0x3c));
+    bad = _mm_or_si128(bad, in(0x3d, 0x40));
+    bad = _mm_or_si128(bad, in(0x5a, 0x5f));
+    bad = _mm_or_si128(bad, eq(0x60));
+    bad = _mm_or_si128(bad, in(0x7a, 0x7e));
+    return _mm_andnot_si128(
+        bad, in(0x20, 0x7f));
+}
+
+#endif
+
+// Return the first char in [p, end) not
+// in path_chars, adding to n the number
+// of times delim occurs before it
+static
+char const*
+origin_scan(
+    char const* p,
+    char const* const end,
+    char delim,
+    std::size_t& n) noexcept
+{
+#ifdef BOOST_URL_USE_SSE2
+    if(end - p >= 16)
+    {
+        __m128i const d =
+            _mm_set1_epi8(delim);
+        do
+        {
+            __m128i const v = _mm_loadu_si128(
+                reinterpret_cast<
+                    __m128i const*>(p));
+            unsigned const stop = ~static_cast<
+                unsigned>(_mm_movemask_epi8(
+                    origin_match_16(v))) & 0xffff;
+            unsigned m = static_cast<
+                unsigned>(_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(v, d)));
+            if(stop)
+            {
+                auto const i = boost::core::
+                    countr_zero(stop);
+                m &= (1u << i) - 1;
+                n += boost::core::popcount(m);
+                return p + i;
+            }
+            n += boost::core::popcount(m);
+            p += 16;
+        }
+        while(end - p >= 16);
+    }
+#endif
+    while(
+        p != end &&
+        path_chars(*p))
+    {
+        if(*p == delim)
+            ++n;
+        ++p;
+    }
+    return p;
+}
+
+// Return true if the query which begins
+// at q is in a key at p. Keys may have
+// '[' and ']' while values may not.
+static
+bool
+origin_in_key(
+    char const* q,
+    char const* p) noexcept
+{
+    while(p != q)
+    {
+        --p;
+        if(*p == '&')
+            return true;
+        if(*p == '=')
+            return false;
+    }
+    return true;
+}
+
+// The escape at p, if valid
+static
+bool
+origin_pct(
+    char const* p,
+    char const* const end) noexcept
+{
+    return
+        end - p >= 3 &&
+        grammar::hexdig_chars(p[1]) &&
+        grammar::hexdig_chars(p[2]);
+}
+
+bool
+parse_origin_form_fused(
+    char const*& it,
+    char const* end,
+    url_impl& u) noexcept
+{
+    auto const start = it;
+    if( it == end ||
+        *it != '/')
+        return false;
+    u.cs_ = start;
+
+    // absolute-path, which ends at
+    // the first char not in a segment
+    auto p = it;
+    std::size_t nseg = 0;
+    std::size_t npct = 0;
+    for(;;)
+    {
+        p = origin_scan(
+            p, end, '/', nseg);
+        if( p == end ||
+            *p != '%')
+            break;
+        if(! origin_pct(p, end))
+            return false;
+        ++npct;
+        p += 3;
+    }
+    {
+        auto const s = string_view(
+            start, p - start);
+        u.decoded_[url_impl::id_path] =
+            static_cast<pos_t>(
+                s.size() - 2 * npct);
+        u.nseg_ = static_cast<pos_t>(
+            path_segments(s, nseg));
+    }
+    u.offset_[url_impl::id_query] =
+        static_cast<pos_t>(p - start);
+
+    // [ "?" query ]
+    if( p != end &&
+        *p == '?')
+    {
+        ++p;
+        auto const q = p;
+        std::size_t namp = 0;
+        npct = 0;
+        for(;;)
+        {
+            p = origin_scan(
+                p, end, '&', namp);
+            if(p == end)
+                break;
+            char const c = *p;
+            if(c == '%')
+            {
+                if(! origin_pct(p, end))
+                    return false;
+                ++npct;
+                p += 3;
+                continue;
+            }
+            if( c == '?' || ((
+                c == '[' || c == ']') &&
+                origin_in_key(q, p)))
+            {
+                ++p;
+                continue;
+            }
+            break;
+        }
+        u.nparam_ = static_cast<pos_t>(
+            1 + namp);
+        u.decoded_[url_impl::id_query] =
+            static_cast<pos_t>(
+                (p - q) - 2 * npct);
+    }
+    u.offset_[url_impl::id_frag] =
+        static_cast<pos_t>(p - start);
+    u.offset_[url_impl::id_end] =
+        static_cast<pos_t>(p - start);
+
+    // the grammar stops at any other
+    // char, including '#', so the match
+    // is certain
+    it = p;
+    return true;
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
@@ -13,7 +13,9 @@
 #include <boost/url/rfc/detail/host_rule.hpp>
 #include <boost/url/rfc/detail/ip_literal_rule.hpp>
 #include <boost/url/rfc/detail/reg_name_rule.hpp>
+#include <boost/url/detail/ip_scan.hpp>
 #include <boost/url/grammar/parse.hpp>
+#include <cstring>
 
 namespace boost {
 namespace urls {
@@ -71,25 +73,38 @@ parse(
         return t;
     }
     // IPv4address
+    //
+    // An IPv4address starts with at
+    // least 7 digits and dots, so a
+    // short scan skips the parse for
+    // most reg-names. As before, the
+    // address may be followed by more
+    // chars, which the caller rejects.
     {
-        auto rv = grammar::parse(
-            it, end, ipv4_address_rule);
-        if(rv.has_value())
+        auto const last =
+            end - it > 7 ? it + 7 : end;
+        auto p = it;
+        while(
+            p != last && (
+                detail::digit_value(*p) <= 9 ||
+                *p == '.'))
+            ++p;
+        if(p - it == 7)
         {
-            auto const b =
-                rv->to_bytes();
-            std::memcpy(
-                t.addr,
-                b.data(),
-                b.size());
-            t.host_type =
-                urls::host_type::ipv4;
-            t.match = string_view(
-                it0, it - it0);
-            return t;
+            auto it1 = it;
+            if(detail::parse_ipv4(
+                    it1, end, t.addr))
+            {
+                it = it1;
+                t.host_type =
+                    urls::host_type::ipv4;
+                t.match = string_view(
+                    it0, it - it0);
+                return t;
+            }
+            std::memset(
+                t.addr, 0, 4);
         }
-
-        it = it0; // rewind
     }
     // reg-name
     {
@@ -58,6 +58,8 @@ parse(
         auto rv = grammar::parse(
             it, end,
             path_absolute_rule);
+        if(! rv)
+            return rv.error();
         t.path = std::move(*rv);
         t.has_authority = false;
         BOOST_URL_RETURN(t);
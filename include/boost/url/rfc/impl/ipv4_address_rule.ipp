@@ -11,6 +11,7 @@
 #define BOOST_URL_RFC_IMPL_IPV4_ADDRESS_RULE_IPP
 
 #include <boost/url/rfc/ipv4_address_rule.hpp>
+#include <boost/url/detail/ip_scan.hpp>
 #include <boost/url/grammar/delim_rule.hpp>
 #include <boost/url/grammar/dec_octet_rule.hpp>
 #include <boost/url/grammar/parse.hpp>
@@ -27,6 +28,12 @@ parse(
         ) const noexcept ->
     result<value_type>
 {
+    std::array<unsigned char, 4> v;
+    if(detail::parse_ipv4(
+            it, end, v.data()))
+        return ipv4_address(v);
+
+    // parse again for the error
     auto rv = grammar::parse(
         it, end,
         grammar::tuple_rule(
@@ -42,7 +49,6 @@ parse(
             grammar::dec_octet_rule));
     if(! rv)
         return rv.error();
-    std::array<unsigned char, 4> v;
     v[0] = std::get<0>(*rv);
     v[1] = std::get<1>(*rv);
     v[2] = std::get<2>(*rv);
@@ -12,7 +12,7 @@
 
 #include <boost/url/rfc/ipv6_address_rule.hpp>
 #include <boost/url/rfc/ipv4_address_rule.hpp>
-#include <boost/url/rfc/detail/h16_rule.hpp>
+#include <boost/url/detail/ip_scan.hpp>
 #include <boost/url/grammar/charset.hpp>
 #include <boost/url/grammar/parse.hpp>
 #include <boost/assert.hpp>
@@ -60,8 +60,7 @@ parse(
                     // when '::' seen
     bool c = false; // need colon
     auto prev = it;
-    ipv6_address::bytes_type bytes;
-    result<detail::h16_rule_t::value_type> rv;
+    ipv6_address::bytes_type bytes = {};
     for(;;)
     {
         if(it == end)
@@ -102,13 +101,9 @@ parse(
             if(c)
             {
                 prev = it;
-                rv = grammar::parse(
-                    it, end,
-                    detail::h16_rule);
-                if(! rv)
-                    return rv.error();
-                bytes[2*(8-n)+0] = rv->hi;
-                bytes[2*(8-n)+1] = rv->lo;
+                if(! detail::parse_h16(
+                        it, end, &bytes[2*(8-n)]))
+                    return grammar::error::syntax;
                 --n;
                 if(n == 0)
                     break;
@@ -133,17 +128,14 @@ parse(
             // rewind the h16 and
             // parse it as ipv4
             it = prev;
-            auto rv1 = grammar::parse(
-                it, end, ipv4_address_rule);
-            if(! rv1)
+            if(! detail::parse_ipv4(
+                    it, end, &bytes[2*(7-n)]))
+            {
+                auto rv1 = grammar::parse(
+                    it, end, ipv4_address_rule);
+                BOOST_ASSERT(! rv1);
                 return rv1.error();
-            auto v4 = rv1.value();
-            auto const b4 =
-                v4.to_bytes();
-            bytes[2*(7-n)+0] = b4[0];
-            bytes[2*(7-n)+1] = b4[1];
-            bytes[2*(7-n)+2] = b4[2];
-            bytes[2*(7-n)+3] = b4[3];
+            }
             --n;
             break;
         }
@@ -158,13 +150,9 @@ parse(
         if(! c)
         {
             prev = it;
-            rv = grammar::parse(
-                it, end,
-                detail::h16_rule);
-            if(! rv)
-                return rv.error();
-            bytes[2*(8-n)+0] = rv->hi;
-            bytes[2*(8-n)+1] = rv->lo;
+            if(! detail::parse_h16(
+                    it, end, &bytes[2*(8-n)]))
+                return grammar::error::syntax;
             --n;
             if(n == 0)
                 break;
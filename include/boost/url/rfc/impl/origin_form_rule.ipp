@@ -11,37 +11,22 @@
 #define BOOST_URL_RFC_IMPL_ORIGIN_FORM_RULE_IPP
 
 #include <boost/url/rfc/origin_form_rule.hpp>
+#include <boost/url/rfc/detail/fused_rules.hpp>
 #include <boost/url/rfc/query_rule.hpp>
 #include <boost/url/rfc/detail/path_rules.hpp>
 #include <boost/url/grammar/delim_rule.hpp>
+#include <boost/url/grammar/optional_rule.hpp>
+#include <boost/url/grammar/parse.hpp>
 #include <boost/url/grammar/range_rule.hpp>
 #include <boost/url/grammar/tuple_rule.hpp>
 
 namespace boost {
 namespace urls {
 
-#if 0
 namespace detail {
 
-constexpr auto origin_form_rule =
-    grammar::tuple_rule(
-        grammar::range_rule(
-            grammar::tuple_rule(
-                grammar::delim_rule('/'),
-                segment_rule),
-            segment_rule,
-            1),
-        grammar::optional_rule(
-            grammar::tuple_rule(
-                grammar::delim_rule('?'),
-                query_rule))
-    );
-
-} // detail
-#endif
-
 auto
-origin_form_rule_t::
+origin_form_grammar_rule_t::
 parse(
     char const*& it,
     char const* end
@@ -51,21 +36,7 @@ parse(
     detail::url_impl u(false);
     u.cs_ = it;
 
-#if 0
-    auto rv = grammar::parse(
-        it, end, detail::origin_form_rule);
-    if(! rv)
-        return rv.error();
-#if 0
-    u.apply_path(
-        std::get<0>(*rv).string(),
-        std::get<0>(*rv).size());
-    if(std::get<1>(*rv).has_value())
-        u.apply_query(
-            (std::get<1>(*rv))->encoded_string(),
-            (std::get<1>(*rv))->size());
-#endif
-#else
+    // absolute-path
     {
         auto rv = grammar::parse(it, end,
             grammar::range_rule(
@@ -80,6 +51,7 @@ parse(
             rv->size());
     }
 
+    // [ "?" query ]
     {
         auto rv = grammar::parse(it, end,
             grammar::optional_rule(
@@ -94,11 +66,30 @@ parse(
                 (*rv)->encoded_string(),
                 (*rv)->size());
     }
-#endif
 
     return u.construct();
 }
 
+} // detail
+
+auto
+origin_form_rule_t::
+parse(
+    char const*& it,
+    char const* end
+        ) const noexcept ->
+    result<value_type>
+{
+#ifndef BOOST_URL_NO_FUSED_PARSER
+    detail::url_impl u(false);
+    if(detail::parse_origin_form_fused(
+            it, end, u))
+        return u.construct();
+#endif
+    return detail::origin_form_grammar_rule.parse(
+        it, end);
+}
+
 } // urls
 } // boost
 
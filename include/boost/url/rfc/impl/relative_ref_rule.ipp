@@ -11,6 +11,7 @@
 #define BOOST_URL_RFC_IMPL_RELATIVE_REF_RULE_IPP
 
 #include <boost/url/rfc/relative_ref_rule.hpp>
+#include <boost/url/rfc/detail/fused_rules.hpp>
 #include <boost/url/rfc/query_rule.hpp>
 #include <boost/url/rfc/detail/fragment_rule.hpp>
 #include <boost/url/rfc/detail/relative_part_rule.hpp>
@@ -22,8 +23,10 @@
 namespace boost {
 namespace urls {
 
+namespace detail {
+
 auto
-relative_ref_rule_t::
+relative_ref_grammar_rule_t::
 parse(
     char const*& it,
     char const* const end
@@ -80,6 +83,26 @@ parse(
     return u.construct();
 }
 
+} // detail
+
+auto
+relative_ref_rule_t::
+parse(
+    char const*& it,
+    char const* const end
+        ) const noexcept ->
+    result<value_type>
+{
+#ifndef BOOST_URL_NO_FUSED_PARSER
+    detail::url_impl u(false);
+    if(detail::parse_relative_ref_fused(
+            it, end, u))
+        return u.construct();
+#endif
+    return detail::relative_ref_grammar_rule.parse(
+        it, end);
+}
+
 } // urls
 } // boost
 
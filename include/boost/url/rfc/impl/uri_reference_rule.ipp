@@ -11,6 +11,7 @@
 #define BOOST_URL_RFC_IMPL_URI_REFERENCE_RULE_IPP
 
 #include <boost/url/rfc/uri_reference_rule.hpp>
+#include <boost/url/rfc/detail/fused_rules.hpp>
 #include <boost/url/rfc/uri_rule.hpp>
 #include <boost/url/rfc/relative_ref_rule.hpp>
 #include <boost/url/grammar/parse.hpp>
@@ -19,8 +20,10 @@
 namespace boost {
 namespace urls {
 
+namespace detail {
+
 auto
-uri_reference_rule_t::
+uri_reference_grammar_rule_t::
 parse(
     char const*& it,
     char const* const end
@@ -30,8 +33,8 @@ parse(
     auto rv = grammar::parse(
         it, end,
         grammar::variant_rule(
-            uri_rule,
-            relative_ref_rule));
+            uri_grammar_rule,
+            relative_ref_grammar_rule));
     if(! rv)
         return rv.error();
     switch(rv->index())
@@ -44,6 +47,26 @@ parse(
     }
 }
 
+} // detail
+
+auto
+uri_reference_rule_t::
+parse(
+    char const*& it,
+    char const* const end
+        ) const noexcept ->
+    result<value_type>
+{
+#ifndef BOOST_URL_NO_FUSED_PARSER
+    detail::url_impl u(false);
+    if(detail::parse_uri_reference_fused(
+            it, end, u))
+        return u.construct();
+#endif
+    return detail::uri_reference_grammar_rule.parse(
+        it, end);
+}
+
 } // urls
 } // boost
 
@@ -11,6 +11,7 @@
 #define BOOST_URL_RFC_IMPL_URI_RULE_IPP
 
 #include <boost/url/rfc/uri_rule.hpp>
+#include <boost/url/rfc/detail/fused_rules.hpp>
 #include <boost/url/rfc/query_rule.hpp>
 #include <boost/url/rfc/detail/fragment_rule.hpp>
 #include <boost/url/rfc/detail/hier_part_rule.hpp>
@@ -23,8 +24,10 @@
 namespace boost {
 namespace urls {
 
+namespace detail {
+
 auto
-uri_rule_t::
+uri_grammar_rule_t::
 parse(
     char const*& it,
     char const* const end
@@ -95,6 +98,26 @@ parse(
     return u.construct();
 }
 
+} // detail
+
+auto
+uri_rule_t::
+parse(
+    char const*& it,
+    char const* const end
+        ) const noexcept ->
+    result<value_type>
+{
+#ifndef BOOST_URL_NO_FUSED_PARSER
+    detail::url_impl u(false);
+    if(detail::parse_uri_fused(
+            it, end, u))
+        return u.construct();
+#endif
+    return detail::uri_grammar_rule.parse(
+        it, end);
+}
+
 } // urls
 } // boost
 
@@ -0,0 +1,315 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_ROUTER_HPP
+#define BOOST_URL_ROUTER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/segments_encoded_view.hpp>
+#include <boost/url/string_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+#ifndef BOOST_URL_DOCS
+class url_view_base;
+class router;
+#endif
+
+/** The result of matching a path with a router
+
+    Objects of this type are filled in by
+    @ref router::match. They hold the route
+    which matched and the values of its
+    parameters, in the order in which they
+    appear in the route pattern.
+    <br>
+    Each value is the percent-encoded segment
+    which matched a `{name}` parameter, or the
+    rest of the path which matched a trailing
+    `*`. Values refer to the character buffer
+    of the matched path, which must remain
+    valid for as long as they are used.
+    Parameter names refer to the router, which
+    must remain valid and unmodified for as
+    long as they are used.
+
+    @see
+        @ref router.
+*/
+class route_match
+{
+public:
+    /** The largest number of parameters in a route
+    */
+    static
+    constexpr
+    std::size_t max_params = 16;
+
+    /** Constructor
+
+        A default-constructed match has
+        no parameters.
+    */
+    route_match() = default;
+
+    /** Return the index of the route which matched
+
+        This is the value returned by
+        @ref router::insert when the route
+        was added.
+    */
+    std::size_t
+    id() const noexcept
+    {
+        return id_;
+    }
+
+    /** Return the number of parameters
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+    /** Return the value of the parameter at index i
+
+        @par Preconditions
+        @code
+        i < size()
+        @endcode
+    */
+    string_view
+    operator[](std::size_t i) const noexcept
+    {
+        return v_[i];
+    }
+
+    /** Return the name of the parameter at index i
+
+        The name of a `{name}` parameter is
+        the text between the braces, and the
+        name of a trailing wildcard is `"*"`.
+
+        @par Preconditions
+        @code
+        i < size()
+        @endcode
+    */
+    BOOST_URL_DECL
+    string_view
+    name(std::size_t i) const noexcept;
+
+    /** Return the index of the parameter with the given name
+
+        If there is no such parameter,
+        `size()` is returned.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    find(string_view name) const noexcept;
+
+private:
+    friend class router;
+
+    router const* r_ = nullptr;
+    std::size_t id_ = 0;
+    std::size_t n_ = 0;
+    string_view v_[max_params];
+};
+
+//------------------------------------------------
+
+/** A table of routes matched by path segments
+
+    A router holds route patterns and finds
+    the one which matches the path of a url.
+    A pattern is a path whose segments are
+    either literal, a parameter written as
+    `{name}` which matches any one segment,
+    or a final `*` which matches the rest of
+    the path, including nothing.
+
+    The patterns form a trie with one node
+    per distinct prefix of segments. The
+    literal edges of every node are kept in
+    one hash table, keyed by the node and
+    the segment as if percent-decoded. So
+    matching costs one hash lookup per
+    segment, no matter how many routes there
+    are, and allocates nothing. When more than
+    one pattern matches, a literal segment is
+    preferred over a parameter, and a
+    parameter over a wildcard.
+
+    @par Example
+    @code
+    router r;
+    r.insert( "/users/{id}" );
+    r.insert( "*" );
+
+    route_match m;
+
+    assert( r.match( url_view( "/users/42" ), m ) );
+    assert( m.id() == 0 );
+    assert( m[0] == "42" );
+
+    assert( r.match( url_view( "/about/team" ), m ) );
+    assert( m.id() == 1 );
+    assert( m[0] == "about/team" );
+    @endcode
+
+    @see
+        @ref route_match,
+        @ref segments_encoded_view.
+*/
+class router
+{
+    struct impl;
+
+    impl* impl_ = nullptr;
+
+    friend class route_match;
+
+public:
+    /** Destructor
+    */
+    BOOST_URL_DECL
+    ~router();
+
+    /** Constructor
+
+        A default-constructed router
+        has no routes.
+    */
+    router() = default;
+
+    /** Constructor
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    router(router const& other);
+
+    /** Constructor
+
+        After the move the moved-from router
+        has no routes.
+    */
+    BOOST_URL_DECL
+    router(router&& other) noexcept;
+
+    /** Assignment
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    router&
+    operator=(router const& other);
+
+    /** Assignment
+
+        After the move the moved-from router
+        has no routes.
+    */
+    BOOST_URL_DECL
+    router&
+    operator=(router&& other) noexcept;
+
+    /** Return the number of routes
+    */
+    BOOST_URL_DECL
+    std::size_t
+    size() const noexcept;
+
+    /** Add a route
+
+        The pattern is split into segments the
+        same way as the path of a url. Literal
+        segments are percent-encoded, and are
+        compared as if they were decoded.
+
+        @par Example
+        @code
+        router r;
+        assert( r.insert( "/" ) == 0 );
+        assert( r.insert( "*" ) == 1 );
+        assert( r.insert( "/users/{id}/posts/{post}" ) == 2 );
+        @endcode
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @return The index of the new route,
+        which is the number of routes before
+        it was added.
+
+        @param pattern The route pattern.
+
+        @throw std::invalid_argument A `*` is
+        not the last segment, a literal segment
+        is not a valid encoded segment, or a
+        route with the same segments exists.
+
+        @throw std::length_error The pattern has
+        more than @ref route_match::max_params
+        parameters.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    insert(string_view pattern);
+
+    /** Match the path of a url
+
+        @par Exception Safety
+        Throws nothing.
+
+        @return `true` if a route matched, in
+        which case `m` holds the result.
+
+        @param u The url whose path is matched.
+
+        @param m The result.
+    */
+    BOOST_URL_DECL
+    bool
+    match(
+        url_view_base const& u,
+        route_match& m) const noexcept;
+
+    /** Match a path
+
+        @par Exception Safety
+        Throws nothing.
+
+        @return `true` if a route matched, in
+        which case `m` holds the result.
+
+        @param path The segments to match.
+
+        @param m The result.
+    */
+    BOOST_URL_DECL
+    bool
+    match(
+        segments_encoded_view const& path,
+        route_match& m) const noexcept;
+};
+
+} // urls
+} // boost
+
+#endif
@@ -11,7 +11,29 @@
 #define BOOST_URL_SCHEME_HPP
 
 #include <boost/url/detail/config.hpp>
+#include <boost/url/detail/link_check.hpp>
 #include <boost/url/string_view.hpp>
+#include <cstdint>
+
+/*  Applications may register more schemes
+    by defining BOOST_URL_USER_SCHEMES to
+    a list of X(id, "string", port) entries:
+
+    #define BOOST_URL_USER_SCHEMES(X) \
+        X(s3, "s3", 443) \
+        X(kafka, "kafka", 9092)
+
+    Each becomes a value of the enumeration
+    scheme, recognized by string_to_scheme
+    and returned by scheme_id. The strings
+    are case-insensitive and must be unique.
+    The macro must have the same value when
+    building the library and every source
+    file that uses it, see link_check.hpp.
+*/
+#ifndef BOOST_URL_USER_SCHEMES
+# define BOOST_URL_USER_SCHEMES(X)
+#endif
 
 namespace boost {
 namespace urls {
@@ -115,8 +137,30 @@ enum class scheme : unsigned short
             The WebSocket Protocol (rfc6455)</a>
     */
     wss
+
+#ifndef BOOST_URL_DOCS
+# define BOOST_URL_SCHEME_ENUM(id, str, port) , id
+    BOOST_URL_USER_SCHEMES(BOOST_URL_SCHEME_ENUM)
+# undef BOOST_URL_SCHEME_ENUM
+#endif
 };
 
+#ifndef BOOST_URL_DOCS
+namespace detail {
+
+// Every entry in BOOST_URL_USER_SCHEMES,
+// as one string. The enumeration and the
+// table built by the library both depend
+// on it, so its digest must match.
+# define BOOST_URL_SCHEME_STRING(id, str, port) \
+    #id "\0" str "\0" #port "\0"
+constexpr char const user_schemes_string[] =
+    "" BOOST_URL_USER_SCHEMES(BOOST_URL_SCHEME_STRING);
+# undef BOOST_URL_SCHEME_STRING
+
+} // detail
+#endif
+
 /** Return the known scheme for a non-normalized string, if known
 
     If the string does not identify a known
@@ -150,7 +194,25 @@ BOOST_URL_DECL
 string_view
 to_string(scheme s) noexcept;
 
+/** Return the default port for a known scheme
+
+    @return The port number, or zero if the
+    scheme has no default port or is not
+    a known scheme.
+
+    @param s The known scheme constant
+*/
+BOOST_URL_DECL
+std::uint16_t
+default_port(scheme s) noexcept;
+
 } // urls
 } // boost
 
+BOOST_URL_LINK_CHECK(
+    user_schemes,
+    link_check_digest(
+        user_schemes_string,
+        sizeof(user_schemes_string) - 1))
+
 #endif
@@ -31,9 +31,12 @@ in a translation unit of the program.
 #include <boost/url/detail/impl/any_query_iter.ipp>
 #include <boost/url/detail/impl/copied_strings.ipp>
 #include <boost/url/detail/impl/except.ipp>
+#include <boost/url/detail/impl/link_check.ipp>
 #include <boost/url/detail/impl/normalize.ipp>
+#include <boost/url/detail/impl/offset_table.ipp>
 #include <boost/url/detail/impl/path.ipp>
 #include <boost/url/detail/impl/remove_dot_segments.ipp>
+#include <boost/url/detail/impl/resolve.ipp>
 #include <boost/url/detail/impl/params_encoded_iterator_impl.ipp>
 #include <boost/url/detail/impl/params_iterator_impl.ipp>
 #include <boost/url/detail/impl/pct_encoded_view.ipp>
@@ -49,18 +52,23 @@ in a translation unit of the program.
 #include <boost/url/impl/params.ipp>
 #include <boost/url/impl/params_encoded.ipp>
 #include <boost/url/impl/params_encoded_view.ipp>
+#include <boost/url/impl/params_index.ipp>
 #include <boost/url/impl/params_view.ipp>
 #include <boost/url/impl/pct_encoded_view.ipp>
 #include <boost/url/impl/pct_encoding.ipp>
 #include <boost/url/impl/query_param.ipp>
+#include <boost/url/impl/resolver.ipp>
+#include <boost/url/impl/router.ipp>
 #include <boost/url/impl/scheme.ipp>
 #include <boost/url/impl/segments.ipp>
 #include <boost/url/impl/segments_encoded.ipp>
 #include <boost/url/impl/segments_encoded_view.ipp>
 #include <boost/url/impl/segments_view.ipp>
 #include <boost/url/impl/static_url.ipp>
+#include <boost/url/impl/stream_parser.ipp>
 #include <boost/url/impl/url.ipp>
 #include <boost/url/impl/url_base.ipp>
+#include <boost/url/impl/url_builder.ipp>
 #include <boost/url/impl/url_view.ipp>
 #include <boost/url/impl/url_view_base.ipp>
 
@@ -78,6 +86,7 @@ in a translation unit of the program.
 #include <boost/url/rfc/impl/uri_rule.ipp>
 #include <boost/url/rfc/impl/uri_reference_rule.ipp>
 
+#include <boost/url/rfc/detail/impl/fused_rules.ipp>
 #include <boost/url/rfc/detail/impl/h16_rule.ipp>
 #include <boost/url/rfc/detail/impl/hier_part_rule.ipp>
 #include <boost/url/rfc/detail/impl/host_rule.ipp>
@@ -79,7 +79,7 @@ class static_url
     char buf_[Capacity + 1];
 
     friend std::hash<static_url>;
-    using url_view_base::digest;
+    using url_base::digest;
 
 public:
     /** Destructor
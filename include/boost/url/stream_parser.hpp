@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_STREAM_PARSER_HPP
+#define BOOST_URL_STREAM_PARSER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/error_code.hpp>
+#include <boost/url/result.hpp>
+#include <boost/url/string_view.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/url_impl.hpp>
+#include <cstddef>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+/** An incremental parser for a URI-reference
+
+    This parser accepts a URL in pieces, such
+    as the request-target of an HTTP request
+    arriving across several reads of a socket.
+    Each piece is appended to a buffer owned by
+    the parser and scanned once, from where the
+    previous piece left off. The parser keeps
+    only the offsets of the parts found so far
+    and a few counters, so that when the input
+    ends the @ref url_view is formed without
+    scanning the buffer again.
+    <br>
+    The result is the same as that of
+    @ref parse_uri_reference called with all
+    of the input. An error is reported by the
+    first call to @ref write whose input makes
+    it certain.
+    <br>
+    The end of the input is signaled either
+    by calling @ref finish, or by a character
+    which cannot appear in any part of a URL,
+    such as the space which follows the
+    request-target in an HTTP request line.
+    That character is not consumed, and
+    @ref done returns `true`.
+
+    @par Example
+    @code
+    stream_parser p;
+
+    auto rv = p.write( "/index.ht" );
+    assert( rv.value() == 9 && ! p.done() );
+
+    rv = p.write( "m?id=42 HTTP/1.1\r\n" );
+    assert( rv.value() == 7 && p.done() );
+
+    url_view u = p.finish().value();
+
+    assert( u.encoded_path() == "/index.htm" );
+    assert( u.encoded_query() == "id=42" );
+    @endcode
+
+    @see
+        @ref parse_uri_reference.
+*/
+class stream_parser
+{
+    std::string s_;
+    detail::url_impl u_{false};
+    error_code ec_;
+    std::size_t pos_ = 0;
+    std::size_t mark_ = 0;
+    std::size_t colon_ = 0;
+    std::size_t n0_ = 0;
+    std::size_t n1_ = 0;
+    unsigned char st_ = 0;
+    bool relative_ = false;
+
+    void resume(bool eof) noexcept;
+
+public:
+    /** Constructor
+
+        Default constructed parsers
+        are ready to parse a URL.
+    */
+    BOOST_URL_DECL
+    stream_parser() noexcept;
+
+    /** Constructor
+
+        Parsers are not copyable.
+    */
+    stream_parser(
+        stream_parser const&) = delete;
+
+    /** Assignment
+
+        Parsers are not copyable.
+    */
+    stream_parser& operator=(
+        stream_parser const&) = delete;
+
+    /** Return true if the end of the URL was found
+
+        This function returns `true` if a
+        character which cannot appear in a URL
+        was written, or if @ref finish was
+        called and succeeded.
+    */
+    BOOST_URL_DECL
+    bool
+    done() const noexcept;
+
+    /** Discard the input and start a new URL
+
+        The buffer is kept, so that parsing
+        many URLs with one parser does not
+        allocate once it has grown to fit.
+        Views returned by @ref finish are
+        invalidated.
+    */
+    BOOST_URL_DECL
+    void
+    reset() noexcept;
+
+    /** Parse a piece of the URL
+
+        The characters are appended to the
+        URL, up to the first character which
+        cannot appear in a URL. If there is such
+        a character, the URL is complete and
+        @ref done returns `true`. Once the URL
+        is complete, or an error is reported,
+        further input is not consumed.
+
+        @par Exception Safety
+        Calls to allocate may throw.
+
+        @return The number of characters
+        consumed, or an error if the input
+        so far is not the beginning of a
+        URI-reference.
+
+        @param s The characters to parse.
+    */
+    BOOST_URL_DECL
+    result<std::size_t>
+    write(string_view s);
+
+    /** Signal the end of the URL and return it
+
+        This function parses the URL as if it
+        ended after the last character written,
+        unless the end was already found. The
+        returned view refers to the buffer of
+        the parser, and remains valid until
+        the parser is reset or destroyed.
+
+        @return The URL, or an error if the
+        characters written are not a
+        URI-reference.
+    */
+    BOOST_URL_DECL
+    result<url_view>
+    finish() noexcept;
+};
+
+} // urls
+} // boost
+
+#endif
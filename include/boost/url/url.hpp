@@ -13,6 +13,7 @@
 
 #include <boost/url/detail/config.hpp>
 #include <boost/url/url_base.hpp>
+#include <boost/container/pmr/memory_resource.hpp>
 #include <boost/assert.hpp>
 #include <utility>
 
@@ -28,6 +29,12 @@ namespace urls {
     The underlying string stored in the container
     is always null-terminated.
 
+    Storage for the string is obtained from a
+    memory resource, which may be specified when
+    the url is constructed. If no resource is
+    specified, storage is allocated with
+    `operator new`.
+
     @par Exception Safety
 
     @li Functions marked `noexcept` provide the
@@ -63,7 +70,9 @@ class BOOST_SYMBOL_VISIBLE url
 {
     friend std::hash<url>;
 
-    using url_view_base::digest;
+    container::pmr::memory_resource* mr_ = nullptr;
+
+    using url_base::digest;
 
 public:
     //--------------------------------------------
@@ -130,11 +139,66 @@ public:
     explicit
     url(string_view s);
 
+    /** Constructor
+
+        This function constructs an empty URL
+        which obtains storage from the
+        specified memory resource.
+
+        @par Example
+        @code
+        char buf[ 4096 ];
+        container::pmr::monotonic_buffer_resource mr( buf, sizeof( buf ) );
+
+        url u( &mr );
+        u.set_encoded_path( "/index.htm" );
+        @endcode
+
+        @par Exception Safety
+        Throws nothing.
+
+        @param mr The memory resource to use.
+        Ownership is not transferred; the resource
+        must remain valid for the lifetime of the
+        url. If this is null, storage is allocated
+        with `operator new`.
+    */
+    explicit
+    url(container::pmr::memory_resource* mr) noexcept
+        : mr_(mr)
+    {
+    }
+
+    /** Construct from a string
+
+        This function constructs a URL from
+        the string `s`, which must contain a
+        valid URI or <em>relative-ref</em> or
+        else an exception is thrown. Storage is
+        obtained from the specified memory
+        resource.
+
+        @throw std::invalid_argument parse error.
+
+        @param s The string to parse.
+
+        @param mr The memory resource to use.
+        Ownership is not transferred; the resource
+        must remain valid for the lifetime of the
+        url. If this is null, storage is allocated
+        with `operator new`.
+    */
+    BOOST_URL_DECL
+    url(
+        string_view s,
+        container::pmr::memory_resource* mr);
+
     /** Constructor
 
         This function performs a move-construction
         from `u`. After the move. the state of `u`
-        will be as-if default constructed.
+        will be as-if default constructed. The
+        memory resource of `u` is copied.
 
         @par Exception Safety
         Throws nothing.
@@ -155,9 +219,33 @@ public:
         copy(u);
     }
 
+    /** Constructor
+
+        This function constructs a copy of `u`,
+        which obtains storage from the specified
+        memory resource.
+
+        @param u The url to construct from.
+
+        @param mr The memory resource to use.
+        Ownership is not transferred; the resource
+        must remain valid for the lifetime of the
+        url. If this is null, storage is allocated
+        with `operator new`.
+    */
+    url(
+        url_view_base const& u,
+        container::pmr::memory_resource* mr)
+        : mr_(mr)
+    {
+        copy(u);
+    }
+
     /** Constructor
 
         This function constructs a copy of `u`.
+        The copy allocates with `operator new`,
+        regardless of the memory resource of `u`.
 
         @param u The url to construct from.
     */
@@ -171,7 +259,10 @@ public:
 
         This function performs a move-assignment
         from `u`. After the move. the state of `u`
-        will be as-if default constructed.
+        will be as-if default constructed. The
+        storage of `u` is transferred along with
+        its memory resource, which replaces the
+        memory resource of `*this`.
 
         @par Exception Safety
         Throws nothing.
@@ -185,7 +276,8 @@ public:
     /** Assignment
 
         This function assigns a copy of `u`
-        to `*this`.
+        to `*this`, using the memory resource
+        of `*this`.
 
         @par Exception Safety
         Strong guarantee.
@@ -204,7 +296,8 @@ public:
     /** Assignment
 
         This function assigns a copy of `u`
-        to `*this`.
+        to `*this`, using the memory resource
+        of `*this`.
 
         @par Exception Safety
         Strong guarantee.
@@ -219,9 +312,25 @@ public:
             url_view_base const&>(u);
     }
 
+    /** Return the memory resource
+
+        This function returns the memory resource
+        used to obtain storage, or null if
+        storage is allocated with `operator new`.
+
+        @par Exception Safety
+        Throws nothing.
+    */
+    container::pmr::memory_resource*
+    resource() const noexcept
+    {
+        return mr_;
+    }
+
 private:
-    char* allocate(std::size_t);
-    void deallocate(char* s);
+    char* allocate(std::size_t n);
+    void deallocate(
+        char* s, std::size_t n) noexcept;
 
     BOOST_URL_DECL void clear_impl() noexcept override;
     BOOST_URL_DECL void reserve_impl(std::size_t) override;
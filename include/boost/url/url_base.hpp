@@ -19,9 +19,12 @@
 #include <boost/url/scheme.hpp>
 #include <boost/url/segments.hpp>
 #include <boost/url/segments_encoded.hpp>
+#include <boost/url/url_view.hpp>
 #include <boost/url/url_view_base.hpp>
 #include <boost/url/detail/any_path_iter.hpp>
 #include <boost/url/detail/any_query_iter.hpp>
+#include <boost/url/detail/digest_cache.hpp>
+#include <boost/url/detail/offset_table.hpp>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -33,6 +36,7 @@ namespace urls {
 #ifndef BOOST_URL_DOCS
 namespace detail {
 struct any_path_iter;
+struct resolve_plan;
 }
 namespace grammar {
 class lut_chars;
@@ -67,12 +71,26 @@ class BOOST_SYMBOL_VISIBLE
     char* s_ = nullptr;
     std::size_t cap_ = 0;
 
+    // offsets of the path segments relative
+    // to the start of the path, see segment()
+    mutable detail::offset_table segs_;
+
+    // offsets of the query params relative
+    // to the start of the query, see param()
+    mutable detail::offset_table parms_;
+
+    // digest of the url for std::hash,
+    // see digest()
+    mutable detail::digest_cache digest_;
+
     friend class url;
     friend class static_url_base;
     friend class urls::segments;
     friend class urls::params;
     friend class segments_encoded;
     friend class params_encoded;
+    friend class resolver;
+    friend class url_builder;
 
     url_base() noexcept = default;
     url_base(detail::url_impl const&) noexcept;
@@ -81,6 +99,17 @@ class BOOST_SYMBOL_VISIBLE
     BOOST_URL_DECL virtual void clear_impl() noexcept = 0;
     BOOST_URL_DECL virtual void reserve_impl(std::size_t) = 0;
 
+#ifndef BOOST_URL_DOCS
+public:
+#endif
+    // Same as url_view_base::digest,
+    // computed once until the url changes.
+    // Like other const members, this may
+    // be called from several threads.
+    BOOST_URL_DECL
+    std::size_t
+    digest(std::size_t = 0) const noexcept;
+
 public:
     //--------------------------------------------
 
@@ -864,6 +893,16 @@ private:
     segment(
         std::size_t i) const noexcept;
 
+    void
+    build_segments() const noexcept;
+
+    void
+    update_segments(
+        std::size_t i0,
+        std::size_t i1,
+        std::size_t nseg,
+        pos_t n0) noexcept;
+
     char*
     edit_segments(
         std::size_t i0,
@@ -1044,6 +1083,16 @@ private:
     param(
         std::size_t i) const noexcept;
 
+    void
+    build_params() const noexcept;
+
+    void
+    update_params(
+        std::size_t i0,
+        std::size_t i1,
+        std::size_t nparam,
+        pos_t n0) noexcept;
+
     char*
     edit_params(
         std::size_t i0,
@@ -1424,6 +1473,76 @@ public:
     url_base&
     normalize_fragment();
 
+    //--------------------------------------------
+    //
+    // Comparison
+    //
+    //--------------------------------------------
+
+    /** Return the result of comparing two URLs
+
+        The URLs are compared character
+        by character as if they were first
+        normalized.
+        When the digests of both URLs were
+        already computed for the same salt,
+        for example by `std::hash`, URLs with
+        different digests are unequal without
+        comparing the characters.
+
+        @par Effects
+        @code
+        return url( u0 ).normalize() == url( u1 ).normalize();
+        @endcode
+
+        @par Complexity
+        Linear in `min( u0.size(), u1.size() )`
+
+        @par Exception Safety
+        Throws nothing
+    */
+    friend
+    bool
+    operator==(
+        url_base const& u0,
+        url_base const& u1) noexcept
+    {
+        if(u0.digest_.mismatch(u1.digest_))
+            return false;
+        return u0.compare(u1) == 0;
+    }
+
+    /** Return the result of comparing two URLs
+
+        The URLs are compared character
+        by character as if they were first
+        normalized.
+        When the digests of both URLs were
+        already computed for the same salt,
+        for example by `std::hash`, URLs with
+        different digests are unequal without
+        comparing the characters.
+
+        @par Effects
+        @code
+        return url( u0 ).normalize() != url( u1 ).normalize();
+        @endcode
+
+        @par Complexity
+        Linear in `min( u0.size(), u1.size() )`
+
+        @par Exception Safety
+        Throws nothing
+    */
+    friend
+    bool
+    operator!=(
+        url_base const& u0,
+        url_base const& u1) noexcept
+    {
+        return ! (u0 == u1);
+    }
+
     //--------------------------------------------
     //
     // Resolution
@@ -1457,6 +1576,11 @@ private:
         url_view_base const& base,
         url_view_base const& ref,
         error_code& ec);
+
+    BOOST_URL_DECL
+    void
+    resolve_impl(
+        detail::resolve_plan const& p);
 };
 
 } // urls
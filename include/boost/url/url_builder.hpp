@@ -0,0 +1,477 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#ifndef BOOST_URL_URL_BUILDER_HPP
+#define BOOST_URL_URL_BUILDER_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/url/host_type.hpp>
+#include <boost/url/scheme.hpp>
+#include <boost/url/string_view.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_base.hpp>
+#include <boost/url/url_view_base.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace urls {
+
+/** Builds a URL from its parts in one write
+
+    Each call to a setter of @ref url_base
+    resizes the URL and moves everything which
+    follows the part being set, so building a
+    URL one part at a time costs time in
+    proportion to both the number of parts and
+    the length of the URL, and may reallocate
+    more than once.
+    <br>
+    A builder instead collects the parts,
+    checking each one as it is set. When
+    @ref build is called, the size of the
+    result is computed, the container is
+    resized once, and the parts are written
+    in order without moving anything.
+    <br>
+    Parts which are not set are absent from
+    the result. A builder constructed from a
+    URL starts with the parts of that URL, so
+    that a batch of changes to a container can
+    be applied with one write.
+    <br>
+    The builder refers to the strings passed
+    to it, without making copies. They must
+    remain valid until the builder is no
+    longer used.
+
+    @par Example
+    @code
+    url u = url_builder()
+        .set_scheme( "https" )
+        .set_host( "example.com" )
+        .set_port( 8080 )
+        .set_path( "/docs/index.htm" )
+        .set_query( "page=2" )
+        .build();
+
+    assert( u.string() == "https://example.com:8080/docs/index.htm?page=2" );
+    @endcode
+
+    @see
+        @ref url_base.
+*/
+class url_builder
+{
+    struct part
+    {
+        string_view s;
+
+        // the size when written,
+        // and the decoded size
+        std::size_t n = 0;
+        std::size_t dn = 0;
+
+        // s is encoded when written
+        bool plain = false;
+
+        bool has = false;
+    };
+
+    string_view scheme_;
+    part user_;
+    part pass_;
+    part host_;
+    string_view port_;
+    part path_;
+    part query_;
+    part frag_;
+    std::size_t nslash_ = 0;
+    std::size_t namp_ = 0;
+    unsigned char ip_addr_[16] = {};
+    std::uint16_t port_number_ = 0;
+    urls::host_type host_type_ =
+        urls::host_type::none;
+    urls::scheme scheme_id_ =
+        urls::scheme::none;
+    bool has_port_ = false;
+    bool print_port_ = false;
+
+    bool has_authority() const noexcept;
+    string_view path_prefix() const noexcept;
+
+public:
+    /** Constructor
+
+        Default constructed builders have
+        no parts.
+    */
+    url_builder() noexcept = default;
+
+    /** Constructor
+
+        The builder starts with the parts of
+        `u`, which it refers to. `u` may be
+        the container later passed to
+        @ref build.
+
+        @param u The URL whose parts are used.
+    */
+    BOOST_URL_DECL
+    explicit
+    url_builder(
+        url_view_base const& u) noexcept;
+
+    /** Return the number of characters in the built URL
+
+        This does not include the
+        null terminator.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    size() const noexcept;
+
+    /** Write the URL to a container
+
+        The contents of `dest` are replaced
+        by the URL. The container is resized
+        at most once.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param dest The container to write to.
+    */
+    BOOST_URL_DECL
+    void
+    build(url_base& dest) const;
+
+    /** Return the URL in a new container
+
+        @par Exception Safety
+        Calls to allocate may throw.
+    */
+    url
+    build() const
+    {
+        url u;
+        build(u);
+        return u;
+    }
+
+    //--------------------------------------------
+
+    /** Remove the scheme
+    */
+    BOOST_URL_DECL
+    url_builder&
+    remove_scheme() noexcept;
+
+    /** Set the scheme
+
+        @par BNF
+        @code
+        scheme        = ALPHA *( ALPHA / DIGIT / "+" / "-" / "." )
+        @endcode
+
+        @throw system_error `s` is not a
+        valid scheme.
+
+        @param s The scheme, without
+        the trailing colon.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_scheme(string_view s);
+
+    /** Set the scheme
+
+        @throw std::invalid_argument `id`
+        is @ref scheme::unknown.
+
+        @param id The scheme. If this is
+        @ref scheme::none, the scheme
+        is removed.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_scheme(urls::scheme id);
+
+    //--------------------------------------------
+
+    /** Remove the authority
+
+        The userinfo, host, and
+        port are removed.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    remove_authority() noexcept;
+
+    /** Remove the userinfo
+    */
+    BOOST_URL_DECL
+    url_builder&
+    remove_userinfo() noexcept;
+
+    /** Set the user
+
+        Reserved characters in the string are
+        percent-encoded when the URL is built.
+        The URL will have a userinfo and an
+        authority.
+
+        @param s The plain string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_user(string_view s) noexcept;
+
+    /** Set the user
+
+        The URL will have a userinfo
+        and an authority.
+
+        @par BNF
+        @code
+        user          = *( unreserved / pct-encoded / sub-delims )
+        @endcode
+
+        @throw std::invalid_argument `s` is
+        not a valid encoded user.
+
+        @param s The encoded string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_encoded_user(string_view s);
+
+    /** Remove the password
+
+        The user is kept.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    remove_password() noexcept;
+
+    /** Set the password
+
+        Reserved characters in the string are
+        percent-encoded when the URL is built.
+        The URL will have a userinfo and an
+        authority.
+
+        @param s The plain string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_password(string_view s) noexcept;
+
+    /** Set the password
+
+        The URL will have a userinfo
+        and an authority.
+
+        @par BNF
+        @code
+        password      = *( unreserved / pct-encoded / sub-delims / ":" )
+        @endcode
+
+        @throw std::invalid_argument `s` is
+        not a valid encoded password.
+
+        @param s The encoded string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_encoded_password(string_view s);
+
+    /** Set the host
+
+        If the string is an IPv4 address the
+        host is that address, otherwise it is
+        a registered name whose reserved
+        characters are percent-encoded when
+        the URL is built. The URL will have
+        an authority.
+
+        @param s The plain string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_host(string_view s) noexcept;
+
+    /** Set the host
+
+        The URL will have an authority.
+
+        @par BNF
+        @code
+        host          = IP-literal / IPv4address / reg-name
+        @endcode
+
+        @throw system_error `s` is
+        not a valid host.
+
+        @param s The encoded string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_encoded_host(string_view s);
+
+    /** Remove the port
+    */
+    BOOST_URL_DECL
+    url_builder&
+    remove_port() noexcept;
+
+    /** Set the port
+
+        The URL will have an authority.
+
+        @param n The port number.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_port(std::uint16_t n) noexcept;
+
+    /** Set the port
+
+        The URL will have an authority.
+
+        @par BNF
+        @code
+        port          = *DIGIT
+        @endcode
+
+        @throw system_error `s` is
+        not a valid port.
+
+        @param s The port string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_port(string_view s);
+
+    //--------------------------------------------
+
+    /** Set the path
+
+        Reserved characters in the string,
+        other than '/', are percent-encoded
+        when the URL is built.
+
+        @param s The plain string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_path(string_view s) noexcept;
+
+    /** Set the path
+
+        @par BNF
+        @code
+        path          = *( pchar / "/" )
+        @endcode
+
+        @throw std::invalid_argument `s` is
+        not a valid encoded path.
+
+        @param s The encoded string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_encoded_path(string_view s);
+
+    //--------------------------------------------
+
+    /** Remove the query
+    */
+    BOOST_URL_DECL
+    url_builder&
+    remove_query() noexcept;
+
+    /** Set the query
+
+        Reserved characters in the string are
+        percent-encoded when the URL is built.
+        The URL will have a query, even if the
+        string is empty.
+
+        @param s The plain string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_query(string_view s) noexcept;
+
+    /** Set the query
+
+        The URL will have a query, even
+        if the string is empty.
+
+        @par BNF
+        @code
+        query         = *( pchar / "/" / "?" )
+        @endcode
+
+        @throw std::invalid_argument `s` is
+        not a valid encoded query.
+
+        @param s The encoded string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_encoded_query(string_view s);
+
+    //--------------------------------------------
+
+    /** Remove the fragment
+    */
+    BOOST_URL_DECL
+    url_builder&
+    remove_fragment() noexcept;
+
+    /** Set the fragment
+
+        Reserved characters in the string are
+        percent-encoded when the URL is built.
+        The URL will have a fragment, even if
+        the string is empty.
+
+        @param s The plain string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_fragment(string_view s) noexcept;
+
+    /** Set the fragment
+
+        The URL will have a fragment, even
+        if the string is empty.
+
+        @par BNF
+        @code
+        fragment      = *( pchar / "/" / "?" )
+        @endcode
+
+        @throw std::invalid_argument `s` is
+        not a valid encoded fragment.
+
+        @param s The encoded string.
+    */
+    BOOST_URL_DECL
+    url_builder&
+    set_encoded_fragment(string_view s);
+};
+
+} // urls
+} // boost
+
+#endif
@@ -461,6 +461,123 @@ result<url_view>
 parse_uri_reference(
     string_view s);
 
+//------------------------------------------------
+
+/** Parse a range of URL strings
+
+    This function parses each string in the
+    range `[src, src + n)` as a
+    <em>URI-reference</em>, and stores the
+    result in the corresponding element of
+    the array `dest`. The result for each
+    string is the same as calling
+    @ref parse_uri_reference on it, except
+    that strings longer than
+    @ref url_view::max_size produce the error
+    @ref error::no_space instead of throwing.
+    Ownership of the strings is not
+    transferred.
+
+    @par Example
+    @code
+    string_view src[] = { "https://www.example.com/", "a b" };
+    result< url_view > dest[ 2 ];
+
+    parse_uri_references( src, dest, 2 );
+
+    assert( dest[ 0 ].has_value() );
+    assert( dest[ 1 ].has_error() );
+    @endcode
+
+    @par Exception Safety
+    Throws nothing.
+
+    @param src A pointer to the strings
+    to parse.
+
+    @param dest A pointer to an array of at
+    least `n` elements which receives
+    the results.
+
+    @param n The number of strings.
+
+    @see
+        @ref parse_uri_reference,
+        @ref parse_uri_reference_lines.
+*/
+BOOST_URL_DECL
+void
+parse_uri_references(
+    string_view const* src,
+    result<url_view>* dest,
+    std::size_t n) noexcept;
+
+/** Parse newline-delimited URL strings
+
+    This function parses records from the
+    front of the buffer `s`, each ending in a
+    line feed optionally preceded by a carriage
+    return, or at the end of the buffer. Each
+    record is parsed as a
+    <em>URI-reference</em> and the results are
+    stored in consecutive elements of `dest`,
+    until `n` records are parsed or the
+    buffer is exhausted. The consumed records
+    and their line endings are removed from
+    the front of `s`, so that the function may
+    be called again to continue.
+    <br>
+    The result for each record is the same as
+    calling @ref parse_uri_reference on it,
+    except that records longer than
+    @ref url_view::max_size produce the error
+    @ref error::no_space instead of throwing.
+    Records are parsed in a single pass over
+    the buffer; a record is only scanned again
+    when it fails to parse.
+    Ownership of the buffer is not transferred.
+
+    @par Example
+    @code
+    string_view s = "https://www.example.com/\n/index.htm?q=1\r\n";
+    result< url_view > dest[ 64 ];
+
+    while( ! s.empty() )
+    {
+        std::size_t n = parse_uri_reference_lines( s, dest, 64 );
+        for( std::size_t i = 0; i < n; ++i )
+            if( dest[ i ] )
+                std::cout << dest[ i ]->encoded_path() << "\n";
+    }
+    @endcode
+
+    @par Exception Safety
+    Throws nothing.
+
+    @return The number of records parsed.
+
+    @param s The buffer to parse. Upon return,
+    this contains the records which were
+    not parsed.
+
+    @param dest A pointer to an array of at
+    least `n` elements which receives
+    the results.
+
+    @param n The maximum number of records
+    to parse.
+
+    @see
+        @ref parse_uri_reference,
+        @ref parse_uri_references.
+*/
+BOOST_URL_DECL
+std::size_t
+parse_uri_reference_lines(
+    string_view& s,
+    result<url_view>* dest,
+    std::size_t n) noexcept;
+
 } // urls
 } // boost
 
@@ -494,4 +611,6 @@ private:
 } // std
 #endif
 
+#include <boost/url/impl/url_view.hpp>
+
 #endif
@@ -69,11 +69,14 @@ class BOOST_SYMBOL_VISIBLE
     friend class params_view;
     friend class params_encoded;
     friend class params_encoded_view;
+    friend class resolver;
     friend class segments;
     friend class segments_view;
     friend class segments_encoded;
     friend class segments_encoded_view;
+    friend class url_builder;
 
+    template<class View>
     struct shared_impl;
 
     BOOST_URL_DECL
@@ -230,6 +233,37 @@ public:
     std::shared_ptr<
         url_view const> persist() const;
 
+    /** Return a shared, persistent copy of the URL
+
+        This function returns a read-only copy of
+        the URL, with shared lifetime. The returned
+        value owns (persists) the underlying string.
+        The control block, the view, and the copy
+        of the string are obtained in a single
+        allocation from the specified allocator.
+
+        @par Example
+        @code
+        char buf[ 4096 ];
+        container::pmr::monotonic_buffer_resource mr( buf, sizeof( buf ) );
+
+        url_view u( "http://example.com" );
+
+        std::shared_ptr< url_view const > sp = u.persist(
+            container::pmr::polymorphic_allocator< char >( &mr ) );
+        @endcode
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param a The allocator to use.
+    */
+    template<class Allocator>
+    std::shared_ptr<
+        url_view const> persist(
+            Allocator const& a) const;
+
     //--------------------------------------------
     //
     // Scheme
@@ -1997,4 +2031,6 @@ operator<<(
 } // urls
 } // boost
 
+#include <boost/url/impl/url_view_base.hpp>
+
 #endif
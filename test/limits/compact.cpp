@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+#include <boost/url.hpp>
+
+#include <boost/static_assert.hpp>
+#include <string>
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+// built with BOOST_URL_OFFSET_BITS=16
+class compact_test
+{
+public:
+    void
+    testSize()
+    {
+        BOOST_STATIC_ASSERT(
+            sizeof(pos_t) == 2);
+        BOOST_TEST_EQ(
+            url_view::max_size(), 65534u);
+        BOOST_TEST_EQ(
+            url::max_size(), 65534u);
+    }
+
+    void
+    testParse()
+    {
+        std::string s =
+            "http://www.example.com/";
+        s.append(65534 - s.size(), 'x');
+        url_view u = parse_uri(s).value();
+        BOOST_TEST_EQ(u.encoded_path().size(),
+            65534u - 22u);
+        BOOST_TEST_EQ(u.encoded_host(),
+            "www.example.com");
+
+        s.push_back('x');
+        BOOST_TEST_THROWS(
+            parse_uri(s),
+            std::length_error);
+
+        // records too long for a url_view
+        std::string b = s;
+        b += "\n/index.htm\n";
+        b += s.substr(0, 65534);
+        b += "\n";
+        string_view bs = b;
+        result<url_view> r[4];
+        BOOST_TEST_EQ(
+            parse_uri_reference_lines(
+                bs, r, 4), 3u);
+        BOOST_TEST(bs.empty());
+        BOOST_TEST(r[0].error() == error::no_space);
+        BOOST_TEST_EQ(r[1]->encoded_path(), "/index.htm");
+        BOOST_TEST_EQ(r[2]->size(), 65534u);
+    }
+
+    void
+    testModify()
+    {
+        url u = parse_uri(
+            "http://www.example.com/?k=v#f").value();
+        std::string p(65000, 'p');
+        u.set_encoded_path(p);
+        BOOST_TEST_EQ(
+            u.encoded_path().size(), 65001u);
+        BOOST_TEST_EQ(u.encoded_query(), "k=v");
+        BOOST_TEST_EQ(u.encoded_fragment(), "f");
+        u.encoded_segments().push_back("seg");
+        BOOST_TEST_EQ(
+            u.encoded_segments().back(), "seg");
+        BOOST_TEST_EQ(
+            u.encoded_params().size(), 1u);
+
+        BOOST_TEST_THROWS(
+            u.set_encoded_fragment(
+                std::string(1000, 'f')),
+            std::length_error);
+        BOOST_TEST_EQ(u.encoded_fragment(), "f");
+    }
+
+    void
+    run()
+    {
+        testSize();
+        testParse();
+        testModify();
+    }
+};
+
+TEST_SUITE(
+    compact_test,
+    "boost.url.compact");
+
+} // urls
+} // boost
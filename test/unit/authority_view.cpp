@@ -10,9 +10,17 @@
 // Test that header file is self-contained.
 #include <boost/url/authority_view.hpp>
 
+#include <boost/url/grammar/dec_octet_rule.hpp>
+#include <boost/url/grammar/delim_rule.hpp>
 #include <boost/url/grammar/parse.hpp>
+#include <boost/url/grammar/tuple_rule.hpp>
+#include <boost/url/rfc/detail/host_rule.hpp>
+#include <boost/url/rfc/detail/reg_name_rule.hpp>
 #include "test_rule.hpp"
+#include <cstdint>
+#include <cstring>
 #include <sstream>
+#include <string>
 
 namespace boost {
 namespace urls {
@@ -258,6 +266,53 @@ public:
                 a.ipv4_address().to_uint() ==
                     0xc0a80001);
         }
+        {
+            // a dotted quad followed by more
+            // chars is still an IPv4address,
+            // and the rest is left over
+            auto const bad = [](string_view s)
+            {
+                BOOST_TEST(
+                    parse_authority(s).has_error());
+            };
+            bad("1.2.3.4!");
+            bad("1.2.3.4$");
+            bad("1.2.3.4=");
+            bad("1.2.3.4x");
+            bad("1.2.3.4%41");
+            bad("1.2.3.1234");
+            bad("a=b");
+            bad("a!b");
+
+            auto const name = [](string_view s)
+            {
+                auto a = parse_authority(s).value();
+                BOOST_TEST(a.host_type() ==
+                    host_type::name);
+                BOOST_TEST_EQ(a.encoded_host(), s);
+                BOOST_TEST(a.ipv4_address() ==
+                    ipv4_address());
+            };
+            name("1.2.3");
+            name("1.2.3.");
+            name("1.2.3.256");
+            name("01.2.3.4");
+            name("1111.2.3.4");
+
+            auto a = parse_authority(
+                "255.255.255.255:80").value();
+            BOOST_TEST(a.host_type() ==
+                host_type::ipv4);
+            BOOST_TEST_EQ(a.encoded_host(),
+                "255.255.255.255");
+            BOOST_TEST_EQ(
+                a.ipv4_address().to_uint(),
+                0xffffffffu);
+            a = parse_authority(
+                "u@0.0.0.0").value();
+            BOOST_TEST(a.host_type() ==
+                host_type::ipv4);
+        }
         {
             auto a = parse_authority(
                 "[1::6:192.168.0.1]:8080").value();
@@ -284,6 +339,127 @@ public:
         }
     }
 
+    // host_rule as it was, trying the
+    // grammar for an IPv4address first
+    static
+    result<detail::host_rule_t::value_type>
+    parse_host_baseline(
+        char const*& it,
+        char const* const end)
+    {
+        detail::host_rule_t::value_type t;
+        auto const it0 = it;
+        {
+            auto rv = grammar::parse(
+                it, end,
+                grammar::tuple_rule(
+                    grammar::dec_octet_rule,
+                    grammar::squelch(
+                        grammar::delim_rule('.')),
+                    grammar::dec_octet_rule,
+                    grammar::squelch(
+                        grammar::delim_rule('.')),
+                    grammar::dec_octet_rule,
+                    grammar::squelch(
+                        grammar::delim_rule('.')),
+                    grammar::dec_octet_rule));
+            if(rv.has_value())
+            {
+                t.addr[0] = std::get<0>(*rv);
+                t.addr[1] = std::get<1>(*rv);
+                t.addr[2] = std::get<2>(*rv);
+                t.addr[3] = std::get<3>(*rv);
+                t.host_type =
+                    urls::host_type::ipv4;
+                t.match = string_view(
+                    it0, it - it0);
+                return t;
+            }
+            it = it0;
+        }
+        auto rv = grammar::parse(
+            it, end,
+            detail::reg_name_rule);
+        if(! rv)
+            return rv.error();
+        t.name = *rv;
+        t.host_type =
+            urls::host_type::name;
+        t.match = string_view(
+            it0, it - it0);
+        return t;
+    }
+
+    void
+    testHostBaseline()
+    {
+        auto const check = [](string_view s)
+        {
+            auto it0 = s.data();
+            auto it1 = s.data();
+            auto const end = s.data() + s.size();
+            auto r0 = parse_host_baseline(it0, end);
+            auto r1 = grammar::parse(
+                it1, end, detail::host_rule);
+            if(! BOOST_TEST_EQ(
+                r0.has_error(), r1.has_error()))
+                return;
+            if(r0.has_error())
+            {
+                BOOST_TEST_EQ(r0.error(), r1.error());
+                return;
+            }
+            BOOST_TEST_EQ(it0, it1);
+            BOOST_TEST(r0->host_type == r1->host_type);
+            BOOST_TEST_EQ(r0->match, r1->match);
+            BOOST_TEST_EQ(std::memcmp(
+                r0->addr, r1->addr, 16), 0);
+            BOOST_TEST_EQ(
+                r0->name.encoded(),
+                r1->name.encoded());
+
+            // and the authority is the same
+            BOOST_TEST_EQ(
+                parse_authority(s).has_error(),
+                it0 != end);
+        };
+        check("1.2.3.4");
+        check("1.2.3.4!");
+        check("1.2.3.4$");
+        check("1.2.3.4=");
+        check("1.2.3.4x");
+        check("1.2.3.4.5");
+        check("1.2.3.4%41");
+        check("1.2.3.1234");
+        check("1.2.3.256");
+        check("255.255.255.2550");
+        check("a=b");
+        check("a!b");
+        check("ho+st.com");
+        check("o,t");
+        check("%");
+        check("%4");
+
+        // random strings of host chars
+        std::uint32_t seed = 1;
+        auto const rand = [&seed]
+        {
+            seed = seed * 1103515245 + 12345;
+            return (seed >> 16) & 0x7fff;
+        };
+        string_view const cs =
+            "0123456789....12525a-!=%4F";
+        std::string s;
+        for(int i = 0; i < 20000; ++i)
+        {
+            s.clear();
+            auto const len = rand() % 20;
+            for(unsigned j = 0; j < len; ++j)
+                s.push_back(cs[rand() % cs.size()]);
+            check(s);
+        }
+    }
+
     void
     testPort()
     {
@@ -380,6 +556,7 @@ public:
         testObservers();
         testUserinfo();
         testHost();
+        testHostBaseline();
         testPort();
         testHostAndPort();
     }
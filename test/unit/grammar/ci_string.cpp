@@ -15,7 +15,9 @@
 #include <boost/unordered_map.hpp>
 #include "test_suite.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -131,6 +133,109 @@ public:
         BOOST_TEST_EQ(ci_compare("bA", "BB"), -1);
     }
 
+    void
+    testIsEqualLowered()
+    {
+        BOOST_TEST(ci_is_equal_lowered("", ""));
+        BOOST_TEST(ci_is_equal_lowered("a", "a"));
+        BOOST_TEST(ci_is_equal_lowered("A", "a"));
+        BOOST_TEST(ci_is_equal_lowered(
+            "WWW.Example.COM", "www.example.com"));
+        BOOST_TEST(! ci_is_equal_lowered("a", "A"));
+        BOOST_TEST(! ci_is_equal_lowered("ab", "a"));
+        BOOST_TEST(! ci_is_equal_lowered(
+            "WWW.Example.COM", "www.example.org"));
+    }
+
+    static
+    int
+    ref_compare(
+        string_view s0,
+        string_view s1)
+    {
+        auto const n = (std::min)(
+            s0.size(), s1.size());
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            auto const c0 = to_lower(s0[i]);
+            auto const c1 = to_lower(s1[i]);
+            if(c0 != c1)
+                return c0 < c1 ? -1 : 1;
+        }
+        if(s0.size() == s1.size())
+            return 0;
+        return s0.size() < s1.size() ? -1 : 1;
+    }
+
+    // compare with the one char at a time
+    // definitions, for every length and
+    // alignment the vector loops handle
+    void
+    testReference()
+    {
+        // letters and their neighbors,
+        // with and without the high bit
+        static char const cs[] =
+            "@AMZ[`amz{09.-"
+            "\xc0\xc1\xda\xdb\xe1\xfa\x80\xff";
+        std::uint32_t r = 1;
+        auto const rand = [&r]
+        {
+            r = r * 1103515245 + 12345;
+            return r >> 16;
+        };
+        char b0[80];
+        char b1[80];
+        for(int k = 0; k < 20000; ++k)
+        {
+            auto const n0 = rand() % 72;
+            auto const n1 = rand() % 4 == 0 ?
+                rand() % 72 : n0;
+            auto const o0 = rand() % 8;
+            auto const o1 = rand() % 8;
+            for(std::size_t i = 0; i < n0; ++i)
+                b0[o0 + i] = cs[rand() % (sizeof(cs) - 1)];
+            // mostly equal ignoring case,
+            // with a few changes
+            for(std::size_t i = 0; i < n1; ++i)
+            {
+                char c = i < n0 ? b0[o0 + i] :
+                    cs[rand() % (sizeof(cs) - 1)];
+                if(rand() % 2)
+                    c = to_upper(c);
+                else
+                    c = to_lower(c);
+                if(rand() % 64 == 0)
+                    c = cs[rand() % (sizeof(cs) - 1)];
+                b1[o1 + i] = c;
+            }
+            string_view const s0(b0 + o0, n0);
+            string_view const s1(b1 + o1, n1);
+            auto const c = ref_compare(s0, s1);
+            BOOST_TEST_EQ(ci_compare(s0, s1), c);
+            BOOST_TEST_EQ(ci_compare(s1, s0), -c);
+            BOOST_TEST_EQ(ci_is_equal(s0, s1), c == 0);
+            BOOST_TEST_EQ(ci_is_equal(s1, s0), c == 0);
+            if(n0 == n1)
+            {
+                BOOST_TEST_EQ(ci_is_less(s0, s1), c < 0);
+                BOOST_TEST_EQ(ci_is_less(s1, s0), c > 0);
+            }
+            if(c == 0)
+                BOOST_TEST_EQ(
+                    ci_digest(s0), ci_digest(s1));
+
+            std::string lowered(s1);
+            for(auto& ch : lowered)
+                ch = to_lower(ch);
+            BOOST_TEST_EQ(
+                ci_is_equal_lowered(s0, lowered),
+                c == 0);
+            BOOST_TEST(
+                ci_is_equal_lowered(s1, lowered));
+        }
+    }
+
     void
     run()
     {
@@ -140,6 +245,7 @@ public:
             assert( to_upper( 'a' ) == 'A' );
             assert( ci_compare( "boost", "Boost" ) == 0 );
             assert( ci_is_equal( "Boost", "boost" ) );
+            assert( ci_is_equal_lowered( "Boost", "boost" ) );
             assert( ! ci_is_less( "Boost", "boost" ) );
             {
                 boost::unordered_map< std::string, std::string, ci_hash, ci_equal > m1;
@@ -164,6 +270,8 @@ public:
         testIsEqual();
         testIsLess();
         testCompare();
+        testIsEqualLowered();
+        testReference();
     }
 };
 
@@ -15,6 +15,8 @@
 
 #include "test_rule.hpp"
 
+#include <string>
+
 namespace boost {
 namespace urls {
 namespace grammar {
@@ -71,6 +73,84 @@ struct lut_chars_test
         }
     }
 
+    void
+    test_find()
+    {
+        // exercise the vectorized paths,
+        // including chars >= 0x80 and tails
+        auto const check = [](
+            lut_chars const& cs,
+            std::string const& s)
+        {
+            char const* const first = s.data();
+            char const* const last = first + s.size();
+            for(std::size_t i = 0; i <= s.size(); ++i)
+            {
+                char const* it0 = first + i;
+                while(it0 != last && ! cs(*it0))
+                    ++it0;
+                char const* it1 = first + i;
+                while(it1 != last && cs(*it1))
+                    ++it1;
+                BOOST_TEST(grammar::find_if(
+                    first + i, last, cs) == it0);
+                BOOST_TEST(grammar::find_if_not(
+                    first + i, last, cs) == it1);
+            }
+        };
+
+        std::string all;
+        for_each_char([&all](char c)
+        {
+            all.push_back(c);
+        });
+
+        struct is_high
+        {
+            constexpr bool
+            operator()(char c) const noexcept
+            {
+                return static_cast<
+                    unsigned char>(c) >= 0x80;
+            }
+        };
+
+        lut_chars const sets[] = {
+            lut_chars("0123456789"),
+            lut_chars("abcdefghijklmnopqrstuvwxyz") - "aeiou",
+            ~lut_chars("%/?#"),
+            lut_chars(is_high{}),
+            lut_chars('\0') + '\xff',
+            };
+        for(auto const& cs : sets)
+        {
+            // every char is tested in the
+            // set and at every lane position
+            for_each_char([&](char c)
+            {
+                BOOST_TEST(grammar::find_if(
+                    all.data(), all.data() + all.size(),
+                        lut_chars(c)) ==
+                    all.data() + static_cast<
+                        unsigned char>(c));
+            });
+            check(cs, all);
+            for(std::size_t n = 0; n < 80; ++n)
+            {
+                std::string s(n, 'a');
+                check(cs, s);
+                for(std::size_t i = 0; i < n; ++i)
+                {
+                    s[i] = '7';
+                    check(cs, s);
+                    s[i] = '\x80';
+                    check(cs, s);
+                    s[i] = 'a';
+                }
+            }
+        }
+    }
+
     void
     run()
     {
@@ -84,6 +164,7 @@ struct lut_chars_test
         }
 
         test_lut_chars();
+        test_find();
 
         // C++11
 #if 1
@@ -0,0 +1,270 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/grammar/typed_range_rule.hpp>
+
+#include <boost/url/grammar/alpha_chars.hpp>
+#include <boost/url/grammar/delim_rule.hpp>
+#include <boost/url/grammar/parse.hpp>
+#include <boost/url/grammar/range_rule.hpp>
+#include <boost/url/grammar/tuple_rule.hpp>
+#include <boost/url/grammar/token_rule.hpp>
+
+#include "test_suite.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+
+namespace boost {
+namespace urls {
+namespace grammar {
+
+struct typed_range_rule_test
+{
+    template<class R>
+    static
+    void
+    check(
+        string_view s,
+        std::initializer_list<
+            string_view> init,
+        R const& r)
+    {
+        auto rv = parse(s, r);
+        if(! BOOST_TEST(rv.has_value()))
+            return;
+        if(! BOOST_TEST_EQ(
+                rv->size(), init.size()))
+            return;
+        BOOST_TEST(
+            std::equal(
+                rv->begin(),
+                rv->end(),
+                init.begin()));
+    }
+
+    template<class R>
+    static
+    void
+    bad(
+        string_view s,
+        R const& r)
+    {
+        BOOST_TEST(parse(s, r).has_error());
+    }
+
+    // the typed and cached ranges match
+    // the same input as the erased one
+    template<class R0, class R1>
+    static
+    void
+    check_same(
+        string_view s,
+        R0 const& first,
+        R1 const& next)
+    {
+        auto const r0 = range_rule(first, next);
+        auto const r1 = typed_range_rule(first, next);
+        auto const r2 = cached_range_rule(first, next);
+        auto it0 = s.data();
+        auto it1 = s.data();
+        auto it2 = s.data();
+        auto const end = s.data() + s.size();
+        auto rv0 = parse(it0, end, r0);
+        auto rv1 = parse(it1, end, r1);
+        auto rv2 = parse(it2, end, r2);
+        if(! BOOST_TEST_EQ(rv0.has_value(), rv1.has_value()) ||
+            ! BOOST_TEST_EQ(rv0.has_value(), rv2.has_value()))
+            return;
+        BOOST_TEST(it0 == it1);
+        BOOST_TEST(it0 == it2);
+        if(! rv0)
+            return;
+        BOOST_TEST_EQ(rv0->string(), rv1->string());
+        BOOST_TEST_EQ(rv0->string(), rv2->string());
+        BOOST_TEST_EQ(rv0->size(), rv1->size());
+        BOOST_TEST_EQ(rv0->size(), rv2->size());
+        BOOST_TEST(std::equal(
+            rv0->begin(), rv0->end(), rv1->begin()));
+        BOOST_TEST(std::equal(
+            rv0->begin(), rv0->end(), rv2->begin()));
+    }
+
+    void
+    testTyped()
+    {
+        // constexpr
+        {
+            constexpr auto r = typed_range_rule(
+                token_rule(alpha_chars),
+                tuple_rule(
+                    squelch(
+                        delim_rule('+')),
+                    token_rule(alpha_chars)));
+
+            check("", {}, r);
+            check("x", {"x"}, r);
+            check("x+y", {"x", "y"}, r);
+            check("x+y+zz", {"x", "y", "zz"}, r);
+        }
+
+        // one rule
+        {
+            constexpr auto r = typed_range_rule(
+                tuple_rule(
+                    squelch(
+                        delim_rule(';')),
+                    token_rule(alpha_chars)));
+
+            check("", {}, r);
+            check(";a", {"a"}, r);
+            check(";a;bc", {"a", "bc"}, r);
+        }
+
+        // N, M
+        {
+            auto const r = typed_range_rule(
+                tuple_rule(
+                    squelch(
+                        delim_rule(';')),
+                    token_rule(alpha_chars)),
+                2, 3);
+
+            bad("", r);
+            bad(";a", r);
+            check(";a;b", {"a", "b"}, r);
+            check(";a;b;c", {"a", "b", "c"}, r);
+            bad(";a;b;c;d", r);
+        }
+
+        // the range is copyable, and
+        // iterators are forward
+        {
+            auto rv = parse("x+y",
+                typed_range_rule(
+                    token_rule(alpha_chars),
+                    tuple_rule(
+                        squelch(
+                            delim_rule('+')),
+                        token_rule(alpha_chars))));
+            if(BOOST_TEST(rv.has_value()))
+            {
+                auto const v = *rv;
+                auto it = v.begin();
+                auto it2 = it++;
+                BOOST_TEST_EQ(*it2, "x");
+                BOOST_TEST_EQ(*it, "y");
+                BOOST_TEST(++it == v.end());
+                BOOST_TEST(it2 != v.end());
+            }
+        }
+
+        // javadoc
+        {
+            auto rv = parse( ";alpha;xray;charlie",
+                typed_range_rule(
+                    tuple_rule(
+                        squelch( delim_rule( ';' ) ),
+                        token_rule( alpha_chars ) ),
+                    1 ) );
+            BOOST_TEST_EQ(rv->size(), 3u);
+        }
+    }
+
+    void
+    testCached()
+    {
+        {
+            constexpr auto r = cached_range_rule(
+                token_rule(alpha_chars),
+                tuple_rule(
+                    squelch(
+                        delim_rule('+')),
+                    token_rule(alpha_chars)));
+
+            check("", {}, r);
+            check("x", {"x"}, r);
+            check("x+y+zz", {"x", "y", "zz"}, r);
+
+            auto rv = parse("x+y+zz", r);
+            if(BOOST_TEST(rv.has_value()))
+            {
+                BOOST_TEST_EQ((*rv)[0], "x");
+                BOOST_TEST_EQ((*rv)[2], "zz");
+                BOOST_TEST_EQ(rv->end() - rv->begin(), 3);
+                BOOST_TEST_EQ(rv->string(), "x+y+zz");
+            }
+        }
+
+        // N, M
+        {
+            auto const r = cached_range_rule(
+                tuple_rule(
+                    squelch(
+                        delim_rule(';')),
+                    token_rule(alpha_chars)),
+                1, 2);
+
+            bad("", r);
+            check(";a", {"a"}, r);
+            check(";a;b", {"a", "b"}, r);
+            bad(";a;b;c", r);
+        }
+
+        // default construction
+        {
+            cached_range<string_view> v;
+            BOOST_TEST(v.empty());
+            BOOST_TEST(v.begin() == v.end());
+        }
+
+        // javadoc
+        {
+            result< cached_range< string_view > > rv = parse( ";alpha;xray;charlie",
+                cached_range_rule(
+                    tuple_rule(
+                        squelch( delim_rule( ';' ) ),
+                        token_rule( alpha_chars ) ),
+                    1 ) );
+            BOOST_TEST_EQ(rv->size(), 3u);
+        }
+    }
+
+    void
+    testSame()
+    {
+        auto const first =
+            token_rule(alpha_chars);
+        auto const next = tuple_rule(
+            squelch(delim_rule(',')),
+            token_rule(alpha_chars));
+        for(string_view s : {
+            "", ",", "a", "a,", "a,b",
+            "a,b,", "a,,b", "ab,cd,ef",
+            "a,b,1", "1", ",a" })
+            check_same(s, first, next);
+    }
+
+    void
+    run()
+    {
+        testTyped();
+        testCached();
+        testSame();
+    }
+};
+
+TEST_SUITE(
+    typed_range_rule_test,
+    "boost.url.grammar.typed_range_rule");
+
+} // grammar
+} // urls
+} // boost
@@ -12,6 +12,8 @@
 
 #include "test_suite.hpp"
 #include <sstream>
+#include <stdexcept>
+#include <string>
 
 namespace boost {
 namespace urls {
@@ -235,11 +237,56 @@ public:
         check("255.255.255.255", 0xffffffff);
     }
 
+    void
+    testPrint()
+    {
+        // every octet, in every position
+        for(unsigned v = 0; v < 256; ++v)
+        {
+            auto const d = std::to_string(v);
+            BOOST_TEST_EQ(ipv4_address(
+                (v << 24) | 0x00010203).to_string(),
+                d + ".1.2.3");
+            BOOST_TEST_EQ(ipv4_address(
+                0x01020300 | v).to_string(),
+                "1.2.3." + d);
+            BOOST_TEST_EQ(ipv4_address(
+                v * 0x01010101).to_string(),
+                d + "." + d + "." + d + "." + d);
+        }
+
+        // print_ipv4_addresses
+        {
+            ipv4_address const src[] = {
+                ipv4_address(0x7f000001),
+                ipv4_address(0xffffffff),
+                ipv4_address(0) };
+            char buf[3 * (
+                ipv4_address::max_str_len + 1)];
+            auto n = print_ipv4_addresses(
+                buf, sizeof(buf), src, 3);
+            BOOST_TEST_EQ(string_view(buf, n),
+                "127.0.0.1\n255.255.255.255\n0.0.0.0\n");
+            n = print_ipv4_addresses(
+                buf, sizeof(buf), src, 2, ',');
+            BOOST_TEST_EQ(string_view(buf, n),
+                "127.0.0.1,255.255.255.255,");
+            n = print_ipv4_addresses(
+                buf, 0, src, 0);
+            BOOST_TEST_EQ(n, 0u);
+            BOOST_TEST_THROWS(
+                print_ipv4_addresses(
+                    buf, sizeof(buf) - 1, src, 3),
+                std::length_error);
+        }
+    }
+
     void
     run()
     {
         testMembers();
         testParse();
+        testPrint();
     }
 };
 
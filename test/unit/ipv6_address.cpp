@@ -13,6 +13,7 @@
 #include <boost/url/ipv4_address.hpp>
 #include "test_suite.hpp"
 #include <sstream>
+#include <stdexcept>
 
 namespace boost {
 namespace urls {
@@ -402,12 +403,81 @@ public:
                 "::ffff:127.0.0.1");
     }
 
+    void
+    testPrint()
+    {
+        // zero runs: the first longest
+        // one is compressed, even if it
+        // is a single word
+        trip("0:0:0:0:0:0:0:0", "::");
+        trip("1:0:0:0:0:0:0:0", "1::");
+        trip("0:0:0:0:0:0:0:1", "::1");
+        trip("1:0:2:0:3:0:4:0", "1::2:0:3:0:4:0");
+        trip("1:0:0:2:0:0:3:4", "1::2:0:0:3:4");
+        trip("1:0:0:2:0:0:0:4", "1:0:0:2::4");
+        trip("1:2:3:4:5:6:7:0", "1:2:3:4:5:6:7::");
+        trip("0:2:3:4:5:6:7:8", "::2:3:4:5:6:7:8");
+        trip("1:2:3:4:5:6:7:8", "1:2:3:4:5:6:7:8");
+
+        // digits without leading zeros
+        trip("f:f0:f00:f000:1:10:100:1000",
+             "f:f0:f00:f000:1:10:100:1000");
+        trip("ABCD:EF01:2345:6789:0A:0B0:C:FFFF",
+             "abcd:ef01:2345:6789:a:b0:c:ffff");
+
+        // v4-mapped
+        trip("::ffff:0.0.0.0", "::ffff:0.0.0.0");
+        trip("::ffff:255.255.255.255",
+             "::ffff:255.255.255.255");
+        trip("0:0:0:0:0:ffff:102:304",
+             "::ffff:1.2.3.4");
+
+        // every word value, in each position
+        for(unsigned v = 0; v < 65536; v += 7)
+        {
+            ipv6_address::bytes_type b = {{
+                0x20, 0x01, 0, 0, 0, 1, 0, 2,
+                0, 3, 0, 4, 0, 5, 0, 6 }};
+            auto const i = 2 * (v % 8);
+            b[i] = static_cast<
+                unsigned char>(v >> 8);
+            b[i + 1] = static_cast<
+                unsigned char>(v);
+            ipv6_address const a(b);
+            auto const s = a.to_string();
+            BOOST_TEST_EQ(ipv6_address(s), a);
+        }
+
+        // print_ipv6_addresses
+        {
+            ipv6_address const src[] = {
+                ipv6_address("::1"),
+                ipv6_address("2001:db8::1"),
+                ipv6_address("::ffff:1.2.3.4") };
+            char buf[3 * (
+                ipv6_address::max_str_len + 1)];
+            auto n = print_ipv6_addresses(
+                buf, sizeof(buf), src, 3);
+            BOOST_TEST_EQ(string_view(buf, n),
+                "::1\n2001:db8::1\n::ffff:1.2.3.4\n");
+            n = print_ipv6_addresses(
+                buf, sizeof(buf), src, 2, ' ');
+            BOOST_TEST_EQ(string_view(buf, n),
+                "::1 2001:db8::1 ");
+            BOOST_TEST_THROWS(
+                print_ipv6_addresses(
+                    buf, sizeof(buf) - 1, src, 3),
+                std::length_error);
+        }
+    }
+
     void
     run()
     {
         testMembers();
         testIO();
         testIpv4();
+        testPrint();
     }
 };
 
@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/parallel_parse.hpp>
+
+#include "test_suite.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+class parallel_parse_test
+{
+public:
+    // a corpus large enough to
+    // be split into many chunks
+    static
+    std::string
+    make_corpus(
+        std::size_t n,
+        bool crlf)
+    {
+        static char const* const cases[] = {
+            "https://www.example.com/path/to/file.txt?id=",
+            "/index.htm?q=",
+            "http://a b",
+            "//cdn.example.net/",
+            "%zz",
+            "mailto:user@example.com?n=",
+            "" };
+        std::string s;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            s += cases[i % 7];
+            if(i % 7 != 6)
+                s += std::to_string(i);
+            s += crlf ? "\r\n" : "\n";
+        }
+        return s;
+    }
+
+    // the same results as parsing
+    // in one thread
+    static
+    void
+    check(
+        string_view s,
+        std::size_t threads)
+    {
+        std::vector<result<url_view>> v0;
+        {
+            string_view t = s;
+            result<url_view> r[16];
+            while(! t.empty())
+            {
+                auto const n =
+                    parse_uri_reference_lines(
+                        t, r, 16);
+                v0.insert(v0.end(), r, r + n);
+            }
+        }
+
+        auto const v1 =
+            parallel_parse_uri_reference_lines(
+                s, threads);
+        BOOST_TEST_EQ(v1.size(), v0.size());
+        if(v1.size() != v0.size())
+            return;
+        for(std::size_t i = 0; i < v0.size(); ++i)
+        {
+            BOOST_TEST_EQ(
+                v1[i].has_value(),
+                v0[i].has_value());
+            if(v0[i].has_value())
+                BOOST_TEST(
+                    v1[i]->string().data() ==
+                    v0[i]->string().data());
+            else if(v1[i].has_error())
+                BOOST_TEST_EQ(
+                    v1[i].error(),
+                    v0[i].error());
+        }
+
+        // every record is delivered
+        // once to the handler
+        std::vector<std::atomic<int>> seen(
+            v0.size());
+        std::atomic<bool> ok(true);
+        parallel_parse_uri_reference_lines(
+            s, threads,
+            [&](
+                std::size_t index,
+                result<url_view> const* r,
+                std::size_t n)
+            {
+                for(std::size_t i = 0; i < n; ++i)
+                {
+                    if( index + i >= v0.size() ||
+                        seen[index + i]++ != 0 ||
+                        r[i].has_value() !=
+                            v0[index + i].has_value())
+                        ok = false;
+                }
+            });
+        BOOST_TEST(ok.load());
+        for(auto const& c : seen)
+            BOOST_TEST_EQ(c.load(), 1);
+    }
+
+    void
+    testParse()
+    {
+        for(std::size_t threads : {
+            std::size_t(0),
+            std::size_t(1),
+            std::size_t(2),
+            std::size_t(7) })
+        {
+            check("", threads);
+            check("\n", threads);
+            check("\n\n", threads);
+            check("/a", threads);
+            check("/a\n/b", threads);
+            check("/a\r\n/b\r\n", threads);
+            check(make_corpus(
+                20000, false), threads);
+            check(make_corpus(
+                20000, true), threads);
+
+            // no line breaks
+            check(std::string(
+                200000, 'x'), threads);
+        }
+    }
+
+    void
+    testHandler()
+    {
+        // exceptions are propagated
+        auto const s = make_corpus(
+            20000, false);
+        std::atomic<std::size_t> calls(0);
+        BOOST_TEST_THROWS(
+            parallel_parse_uri_reference_lines(
+                s, 4,
+                [&](
+                    std::size_t,
+                    result<url_view> const*,
+                    std::size_t)
+                {
+                    if(++calls == 10)
+                        throw std::runtime_error("");
+                }),
+            std::runtime_error);
+
+        // const handler
+        auto const f = [](
+            std::size_t,
+            result<url_view> const*,
+            std::size_t)
+        {
+        };
+        parallel_parse_uri_reference_lines(
+            s, 2, f);
+    }
+
+    void
+    run()
+    {
+        testParse();
+        testHandler();
+    }
+};
+
+TEST_SUITE(
+    parallel_parse_test,
+    "boost.url.parallel_parse");
+
+} // urls
+} // boost
@@ -11,8 +11,10 @@
 // Test that header file is self-contained.
 #include <boost/url/params_encoded.hpp>
 
+#include <boost/url/static_url.hpp>
 #include <boost/url/url.hpp>
 #include <boost/url/url_view.hpp>
+#include <iterator>
 #include "test_suite.hpp"
 
 namespace boost {
@@ -561,6 +563,173 @@ public:
         }
     }
 
+    void
+    testIndexedEdits()
+    {
+        // url locates params through its
+        // param table, while static_url
+        // never builds one and scans instead.
+        auto const check = [](
+            url_base& u,
+            url_base& v)
+        {
+            BOOST_TEST_EQ(u.string(), v.string());
+            auto const pu = u.encoded_params();
+            auto const pv = v.encoded_params();
+            BOOST_TEST_EQ(pu.size(), pv.size());
+            if(pu.size() != pv.size())
+                return;
+            for(std::size_t i = 0;
+                i < pu.size(); ++i)
+            {
+                auto const a = pu[i];
+                auto const b = pv[i];
+                BOOST_TEST_EQ(a.key, b.key);
+                BOOST_TEST_EQ(a.value, b.value);
+                BOOST_TEST_EQ(
+                    a.has_value, b.has_value);
+            }
+        };
+
+        auto const edits = [&check](
+            url_base& u, url_base& v)
+        {
+            auto pu = u.encoded_params();
+            auto pv = v.encoded_params();
+
+            // replace each param in turn
+            for(auto iu = pu.begin(), iv = pv.begin();
+                iu != pu.end(); ++iu, ++iv)
+            {
+                iu = pu.replace(iu, {"k", "v", true});
+                iv = pv.replace(iv, {"k", "v", true});
+                BOOST_TEST_EQ((*iu).key, (*iv).key);
+                check(u, v);
+            }
+
+            // insert in the middle
+            auto it = pu.insert(std::next(
+                pu.begin(), pu.size() / 2),
+                    {"mid", "", false});
+            BOOST_TEST_EQ((*it).key, "mid");
+            pv.insert(std::next(
+                pv.begin(), pv.size() / 2),
+                    {"mid", "", false});
+            check(u, v);
+
+            // insert several at the front
+            it = pu.insert(pu.begin(), {
+                {"", "", false},
+                {"a", "b=c", true},
+                {"d", "", true}});
+            BOOST_TEST_EQ((*it).key, "");
+            pv.insert(pv.begin(), {
+                {"", "", false},
+                {"a", "b=c", true},
+                {"d", "", true}});
+            check(u, v);
+
+            pu.emplace_back("end", "1");
+            pv.emplace_back("end", "1");
+            check(u, v);
+
+            // values
+            it = pu.remove_value(
+                std::next(pu.begin(), 2));
+            BOOST_TEST(! (*it).has_value);
+            pv.remove_value(
+                std::next(pv.begin(), 2));
+            check(u, v);
+            it = pu.replace_value(
+                std::next(pu.begin(), 3), "xyz");
+            BOOST_TEST_EQ((*it).value, "xyz");
+            pv.replace_value(
+                std::next(pv.begin(), 3), "xyz");
+            check(u, v);
+
+            // erase a range in the middle
+            it = pu.erase(
+                std::next(pu.begin()),
+                std::next(pu.begin(), 3));
+            BOOST_TEST(it == std::next(pu.begin()));
+            pv.erase(
+                std::next(pv.begin()),
+                std::next(pv.begin(), 3));
+            check(u, v);
+
+            // erase from the back
+            pu.pop_back();
+            pv.pop_back();
+            check(u, v);
+
+            // modifications which bypass
+            // the param table
+            u.set_encoded_query("p=1&q=2&r=3&s");
+            v.set_encoded_query("p=1&q=2&r=3&s");
+            check(u, v);
+            pu.erase(std::next(pu.begin()));
+            pv.erase(std::next(pv.begin()));
+            check(u, v);
+            u.set_query("a&b=%&c");
+            v.set_query("a&b=%&c");
+            check(u, v);
+            pu.insert(std::next(pu.begin(), 2),
+                {"x", "y", true});
+            pv.insert(std::next(pv.begin(), 2),
+                {"x", "y", true});
+            check(u, v);
+            u.remove_query();
+            v.remove_query();
+            check(u, v);
+            pu.emplace_back("k", "v");
+            pv.emplace_back("k", "v");
+            pu.emplace_back("k2", "v2");
+            pv.emplace_back("k2", "v2");
+            check(u, v);
+        };
+
+        for(string_view s : {
+            "x://y/path?k0=0&k1=1&k2=&k3&k4=4444#f",
+            "x:?a&b&c&d&e&f&g&h&i&j&k",
+            "?k0=0&k1",
+            "/?k0=0#f",
+            "x://y/path",
+            "" })
+        {
+            url u = parse_uri_reference(s).value();
+            static_url<1024> v(s);
+            edits(u, v);
+
+            // copies do not share a table
+            url u2 = u;
+            static_url<1024> v2 = v;
+            edits(u2, v2);
+            u2 = u;
+            v2 = v;
+            edits(u2, v2);
+        }
+
+        // many edits on a long query
+        {
+            url u = parse_uri_reference("?a").value();
+            auto p = u.encoded_params();
+            for(int i = 0; i < 200; ++i)
+                p.insert(std::next(
+                    p.begin(), (p.size() + 1) / 2),
+                        {"k", "v", true});
+            BOOST_TEST_EQ(p.size(), 201u);
+            for(int i = 0; i < 100; ++i)
+                p.erase(std::next(
+                    p.begin(), p.size() / 2));
+            BOOST_TEST_EQ(p.size(), 101u);
+            url_view v(u.string());
+            BOOST_TEST_EQ(
+                v.encoded_params().size(), 101u);
+            BOOST_TEST_EQ(p[0].key, "a");
+            BOOST_TEST_EQ(p[50].key, "k");
+        }
+    }
+
     void
     run()
     {
@@ -572,6 +741,7 @@ public:
         testIterators();
         testRange();
         testEmpty();
+        testIndexedEdits();
     }
 };
 
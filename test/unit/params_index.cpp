@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2022 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/params_index.hpp>
+
+#include <boost/url/url_view.hpp>
+#include <string>
+#include <utility>
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+class params_index_test
+{
+public:
+    // the index must agree with
+    // the linear lookup of the view
+    static
+    void
+    check(
+        params_encoded_view const& v,
+        string_view key)
+    {
+        params_index const idx(v);
+        BOOST_TEST_EQ(
+            idx.count(key), v.count(key));
+        BOOST_TEST_EQ(
+            idx.contains(key), v.contains(key));
+        auto const it = idx.find(key);
+        BOOST_TEST(it == v.find(key));
+        if(it != v.end())
+        {
+            auto const r0 = *it;
+            auto const r1 = *v.find(key);
+            BOOST_TEST_EQ(r0.key, r1.key);
+            BOOST_TEST_EQ(r0.value, r1.value);
+            BOOST_TEST_EQ(
+                r0.has_value, r1.has_value);
+        }
+    }
+
+    void
+    testMembers()
+    {
+        // params_index()
+        {
+            params_index idx;
+            BOOST_TEST(idx.empty());
+            BOOST_TEST_EQ(idx.size(), 0u);
+            BOOST_TEST(idx.begin() == idx.end());
+            BOOST_TEST(! idx.contains(""));
+            BOOST_TEST(idx.find("k") == idx.end());
+            BOOST_TEST_EQ(idx.count("k"), 0u);
+        }
+
+        // params_index(url_view_base)
+        // params_index(params_encoded_view)
+        {
+            url_view u(
+                "/?a=1&b=2&a=3#f");
+            params_index idx(u);
+            BOOST_TEST_EQ(idx.size(), 3u);
+            BOOST_TEST_EQ(
+                idx.params().encoded_string(),
+                "a=1&b=2&a=3");
+            params_index idx2(
+                u.encoded_params());
+            BOOST_TEST_EQ(idx2.count("a"), 2u);
+        }
+
+        // params_index(params_index const&)
+        // params_index(params_index&&)
+        // operator=(params_index const&)
+        // operator=(params_index&&)
+        {
+            url_view u("?a=1&b=2&c=3");
+            params_index idx(u);
+            params_index idx2(idx);
+            BOOST_TEST_EQ(
+                (*idx2.find("b")).value, "2");
+            params_index idx3(std::move(idx2));
+            BOOST_TEST_EQ(
+                (*idx3.find("c")).value, "3");
+            BOOST_TEST(idx2.empty());
+            BOOST_TEST(! idx2.contains("c"));
+            idx2 = idx3;
+            BOOST_TEST(idx2.contains("c"));
+            params_index idx4;
+            idx4 = std::move(idx3);
+            BOOST_TEST(idx4.contains("a"));
+            BOOST_TEST(idx3.empty());
+            idx4 = idx4;
+            BOOST_TEST(idx4.contains("a"));
+        }
+    }
+
+    void
+    testLookup()
+    {
+        {
+            url_view u(
+                "/?a=1&bb=22&a=3&a&%61=5&&bb%3d=6&c=%3d#f");
+            auto const v = u.encoded_params();
+            for(string_view k : {
+                "a", "%61", "bb", "bb=",
+                "bb%3D", "c", "", "d", "=" })
+                check(v, k);
+
+            params_index idx(u);
+            BOOST_TEST_EQ(idx.count("a"), 4u);
+            BOOST_TEST_EQ(idx.count(""), 1u);
+            BOOST_TEST_EQ(
+                (*idx.find("bb=")).value, "6");
+            BOOST_TEST_EQ(
+                (*idx.find("c")).value, "%3d");
+
+            // all matches, in order
+            std::string s;
+            for(auto it = idx.find("a");
+                it != idx.end();
+                it = v.find(++it, "a"))
+                s += std::string((*it).value);
+            BOOST_TEST_EQ(s, "135");
+        }
+
+        // empty keys
+        for(string_view s : {
+            "x:?", "x:?&", "x:?&&=", "x:?=" })
+        {
+            url_view u(s);
+            check(u.encoded_params(), "");
+            check(u.encoded_params(), "a");
+        }
+
+        // many distinct and repeated keys
+        {
+            std::string s = "?";
+            for(int i = 0; i < 500; ++i)
+            {
+                if(i > 0)
+                    s.push_back('&');
+                s += "k";
+                s += std::to_string(i % 200);
+                s += "=";
+                s += std::to_string(i);
+            }
+            url_view u(s);
+            params_index idx(u);
+            for(int i = 0; i < 200; ++i)
+            {
+                auto const k =
+                    "k" + std::to_string(i);
+                BOOST_TEST_EQ(idx.count(k),
+                    i < 100 ? 3u : 2u);
+                BOOST_TEST_EQ(
+                    (*idx.find(k)).value,
+                    std::to_string(i));
+            }
+            BOOST_TEST(! idx.contains("k200"));
+            check(u.encoded_params(), "k7");
+            check(u.encoded_params(), "k%3199");
+        }
+    }
+
+    void
+    run()
+    {
+        testMembers();
+        testLookup();
+    }
+};
+
+TEST_SUITE(
+    params_index_test,
+    "boost.url.params_index");
+
+} // urls
+} // boost
@@ -10,9 +10,12 @@
 // Test that header file is self-contained.
 #include <boost/url/pct_encoding.hpp>
 
+#include <boost/url/pct_encoded_view.hpp>
 #include <boost/url/grammar/lut_chars.hpp>
 #include "test_suite.hpp"
+#include <cstdint>
 #include <memory>
+#include <string>
 
 namespace boost {
 namespace urls {
@@ -579,6 +582,222 @@ public:
         }
     }
 
+    // Compare the decoding and validation
+    // functions against straightforward
+    // reference loops, with inputs long
+    // enough to use the vectorized scans
+    void
+    testKernels()
+    {
+        auto const hexval = [](char c)
+        {
+            if(c >= '0' && c <= '9')
+                return c - '0';
+            if(c >= 'A' && c <= 'F')
+                return c - 'A' + 10;
+            return c - 'a' + 10;
+        };
+
+        auto const ref_decode = [&](
+            string_view s,
+            pct_decode_opts const& opt)
+        {
+            std::string r;
+            for(std::size_t i = 0;
+                i < s.size();)
+            {
+                if(s[i] == '%')
+                {
+                    if(s.size() - i < 3)
+                        break;
+                    r.push_back(static_cast<char>(
+                        hexval(s[i + 1]) * 16 +
+                        hexval(s[i + 2])));
+                    i += 3;
+                    continue;
+                }
+                if( opt.plus_to_space &&
+                    s[i] == '+')
+                    r.push_back(' ');
+                else
+                    r.push_back(s[i]);
+                ++i;
+            }
+            return r;
+        };
+
+        // returns the error, and the number
+        // of decoded chars before it
+        auto const ref_validate = [&](
+            string_view s,
+            grammar::lut_chars const& cs,
+            pct_decode_opts const& opt,
+            std::size_t& n)
+        {
+            n = 0;
+            for(std::size_t i = 0;
+                i < s.size(); ++n)
+            {
+                char const c = s[i];
+                if(c != '%')
+                {
+                    if( c == '\0' &&
+                        ! opt.allow_null)
+                        return error_code(
+                            error::illegal_null);
+                    if(! cs(c))
+                        return error_code(
+                            error::illegal_reserved_char);
+                    ++i;
+                    continue;
+                }
+                if(s.size() - i < 3)
+                    return error_code(
+                        error::missing_pct_hexdig);
+                if( ! grammar::hexdig_chars(s[i + 1]) ||
+                    ! grammar::hexdig_chars(s[i + 2]))
+                    return error_code(
+                        error::bad_pct_hexdig);
+                char const d = static_cast<char>(
+                    hexval(s[i + 1]) * 16 +
+                    hexval(s[i + 2]));
+                if( d == '\0' &&
+                    ! opt.allow_null)
+                    return error_code(
+                        error::illegal_null);
+                if( opt.non_normal_is_error &&
+                    cs(d))
+                    return error_code(
+                        error::non_canonical);
+                i += 3;
+            }
+            return error_code();
+        };
+
+        static char const alphabet[] = {
+            'a', 'Z', '0', '/', '+', ' ', '\0',
+            '%', '%', '%', '4', '1', 'f', 'G' };
+        static char const* const escapes[] = {
+            "%41", "%2f", "%2B", "%00", "%7e",
+            "%ff", "%4", "%G1", "%%" };
+
+        constexpr grammar::lut_chars CS1(
+            "abcdefghijklmnopqrstuvwxyz"
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+            "0123456789/+");
+        constexpr grammar::lut_chars CS2 =
+            CS1 + ' ' + '\0';
+
+        // deterministic generator
+        std::uint32_t seed = 1;
+        auto const rand = [&seed]
+        {
+            seed = seed * 1103515245 + 12345;
+            return (seed >> 16) & 0x7fff;
+        };
+
+        for(int iter = 0; iter < 4000; ++iter)
+        {
+            std::string s;
+            auto const len = rand() % 80;
+            // mostly clean runs, so the
+            // vector loops find long spans
+            auto const noise = rand() % 4;
+            while(s.size() < len)
+            {
+                auto const r = rand() % 16;
+                if(noise == 0 || r >= noise * 3)
+                    s.push_back(static_cast<char>(
+                        'a' + rand() % 26));
+                else if(r % 2)
+                    s.append(escapes[
+                        rand() % 9]);
+                else
+                    s.push_back(alphabet[
+                        rand() % sizeof(alphabet)]);
+            }
+            if(iter % 7 == 0)
+                s.append("%4");
+
+            for(int o = 0; o < 8; ++o)
+            {
+                pct_decode_opts opt;
+                opt.plus_to_space = (o & 1) != 0;
+                opt.allow_null = (o & 2) != 0;
+                opt.non_normal_is_error = (o & 4) != 0;
+                grammar::lut_chars const& cs =
+                    (o & 2) ? CS2 : CS1;
+
+                // validate_pct_encoding
+                std::size_t n0;
+                auto const ec0 = ref_validate(
+                    s, cs, opt, n0);
+                {
+                    error_code ec;
+                    auto const n =
+                        validate_pct_encoding(
+                            s, ec, cs, opt);
+                    BOOST_TEST(ec == ec0);
+                    BOOST_TEST_EQ(n, n0);
+                }
+                // charset-less overload only
+                // checks escapes and nulls
+                {
+                    pct_decode_opts opt1 = opt;
+                    opt1.non_normal_is_error = false;
+                    error_code ec;
+                    validate_pct_encoding(
+                        s, ec, opt1);
+                    std::size_t n1;
+                    auto const ec1 = ref_validate(
+                        s, grammar::lut_chars(
+                            [](char)
+                            {
+                                return true;
+                            }), opt1, n1);
+                    BOOST_TEST(ec == ec1);
+                }
+                if(ec0.failed())
+                    continue;
+
+                auto const d = ref_decode(s, opt);
+                BOOST_TEST_EQ(
+                    pct_decode_bytes_unchecked(s),
+                    d.size());
+
+                // every destination size
+                char buf[128];
+                for(std::size_t i = 0;
+                    i <= d.size(); ++i)
+                {
+                    auto const n =
+                        pct_decode_unchecked(
+                            buf, buf + i, s, opt);
+                    BOOST_TEST_EQ(n, i);
+                    BOOST_TEST_EQ(
+                        string_view(buf, n),
+                        string_view(d).substr(0, i));
+                }
+
+                // pct_encoded_view
+                {
+                    pct_encoded_view const pv(
+                        s, opt);
+                    BOOST_TEST_EQ(pv.to_string(), d);
+                    for(std::size_t pos = 0;
+                        pos <= d.size(); pos += 5)
+                    {
+                        auto const n = pv.copy(
+                            buf, sizeof(buf), pos);
+                        BOOST_TEST_EQ(
+                            string_view(buf, n),
+                            string_view(d).substr(pos));
+                    }
+                }
+            }
+        }
+    }
+
     //--------------------------------------------
 
     void
@@ -656,6 +875,118 @@ public:
         check("A B", "A+%42", true);
     }
 
+    // Compare the encoding functions against
+    // a straightforward reference loop, with
+    // inputs long enough to use the
+    // vectorized scans
+    template<class CharSet>
+    void
+    checkEncodeKernels(
+        CharSet const& cs)
+    {
+        auto const ref_encode = [&](
+            string_view s,
+            pct_encode_opts const& opt)
+        {
+            static constexpr char hex[] =
+                "0123456789abcdef";
+            std::string r;
+            for(char c : s)
+            {
+                if(cs(c))
+                {
+                    r.push_back(c);
+                    continue;
+                }
+                if( opt.space_to_plus &&
+                    c == ' ')
+                {
+                    r.push_back('+');
+                    continue;
+                }
+                auto const u = static_cast<
+                    unsigned char>(c);
+                r.push_back('%');
+                r.push_back(hex[u >> 4]);
+                r.push_back(hex[u & 0xf]);
+            }
+            return r;
+        };
+
+        // deterministic generator
+        std::uint32_t seed = 1;
+        auto const rand = [&seed]
+        {
+            seed = seed * 1103515245 + 12345;
+            return (seed >> 16) & 0x7fff;
+        };
+
+        for(int iter = 0; iter < 2000; ++iter)
+        {
+            std::string s;
+            auto const len = rand() % 80;
+            // mostly clean runs, so the
+            // vector loops find long spans
+            auto const noise = rand() % 4;
+            while(s.size() < len)
+            {
+                auto const r = rand() % 16;
+                if(noise == 0 || r >= noise * 3)
+                    s.push_back(static_cast<char>(
+                        'a' + rand() % 26));
+                else
+                    s.push_back(static_cast<char>(
+                        rand() % 256));
+            }
+            for(int o = 0; o < 2; ++o)
+            {
+                pct_encode_opts opt;
+                opt.space_to_plus = o != 0;
+                auto const m = ref_encode(s, opt);
+                BOOST_TEST_EQ(
+                    pct_encode_bytes(s, cs, opt),
+                    m.size());
+                BOOST_TEST_EQ(
+                    pct_encode_to_string(s, cs, opt),
+                    m);
+
+                // every destination size
+                std::string buf(m.size(), '\0');
+                for(std::size_t i = 0;
+                    i <= m.size(); ++i)
+                {
+                    auto const n = pct_encode(
+                        &buf[0], &buf[0] + i,
+                        s, cs, opt);
+                    BOOST_TEST_LE(n, i);
+                    BOOST_TEST_GT(n + 3, i);
+                    BOOST_TEST_EQ(
+                        string_view(buf.data(), n),
+                        string_view(m).substr(0, n));
+                }
+
+                // worst case bound
+                std::string buf3(
+                    3 * s.size(), '\0');
+                auto const n =
+                    pct_encode_unchecked(
+                        &buf3[0], s, cs, opt);
+                BOOST_TEST_EQ(
+                    string_view(buf3.data(), n), m);
+            }
+        }
+    }
+
+    void
+    testEncodeKernels()
+    {
+        constexpr grammar::lut_chars CS(
+            "abcdefghijklmnopqrstuvwxyz"
+            "0123456789-._~");
+        checkEncodeKernels(CS);
+        checkEncodeKernels(test_chars{});
+    }
+
     void
     testEncodeExtras()
     {
@@ -685,7 +1016,9 @@ public:
     run()
     {
         testDecoding();
+        testKernels();
         testEncode();
+        testEncodeKernels();
         testEncodeExtras();
     }
 };
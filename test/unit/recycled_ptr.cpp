@@ -11,7 +11,10 @@
 #include <boost/url/recycled_ptr.hpp>
 
 #include "test_suite.hpp"
+#include <atomic>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace boost {
 namespace urls {
@@ -32,9 +35,52 @@ struct recycled_ptr_test
         }
     }
 
+    void
+    testThreads()
+    {
+        // each object is owned by one
+        // pointer at a time, on any thread
+        struct flag
+        {
+            std::atomic<bool> busy{false};
+        };
+
+        std::atomic<bool> ok{true};
+        auto const work = [&ok]
+        {
+            for(int i = 0; i < 2000; ++i)
+            {
+                std::vector<
+                    recycled_ptr<flag>> v;
+                for(int j = 0; j < i % 40 + 1; ++j)
+                {
+                    v.emplace_back();
+                    if(v.back()->busy.exchange(true))
+                        ok = false;
+                }
+                for(auto& p : v)
+                    p->busy = false;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for(int i = 0; i < 8; ++i)
+            threads.emplace_back(work);
+        for(auto& t : threads)
+            t.join();
+        BOOST_TEST(ok.load());
+
+        // objects released by exited
+        // threads are recycled
+        work();
+        BOOST_TEST(ok.load());
+    }
+
     void
     run()
     {
+        testPtr();
+        testThreads();
     }
 };
 
@@ -0,0 +1,331 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/resolver.hpp>
+
+#include <boost/url/static_url.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+class resolver_test
+{
+public:
+    static
+    std::vector<url_view>
+    parse_all(
+        std::vector<string_view> const& v)
+    {
+        std::vector<url_view> r;
+        for(auto s : v)
+            r.push_back(
+                parse_uri_reference(s).value());
+        return r;
+    }
+
+    static
+    std::string
+    resolved(
+        url_view const& base,
+        url_view const& ref)
+    {
+        url u;
+        error_code ec;
+        urls::resolve(base, ref, u, ec);
+        BOOST_TEST(! ec.failed());
+        return u.string();
+    }
+
+    // every result must match resolve
+    // called with the same base
+    static
+    void
+    check(
+        string_view base,
+        std::vector<string_view> const& refs)
+    {
+        url_view const ub =
+            parse_uri(base).value();
+        auto const v = parse_all(refs);
+        resolver r(ub);
+        BOOST_TEST_EQ(
+            r.base().string(), base);
+
+        // resolve(url_view_base, url_base)
+        for(auto const& ref : v)
+        {
+            url u("z://y:x@p.q:69/x/f?q#f");
+            r.resolve(ref, u);
+            BOOST_TEST_EQ(
+                u.string(), resolved(ub, ref));
+        }
+
+        // resolve(url_view const*, url*, n)
+        std::vector<url> vu(v.size());
+        r.resolve(v.data(), vu.data(), v.size());
+        for(std::size_t i = 0; i < v.size(); ++i)
+            BOOST_TEST_EQ(vu[i].string(),
+                resolved(ub, v[i]));
+
+        // resolve(url_view const*, url_view*, n)
+        std::vector<url_view> vv(v.size());
+        r.resolve(v.data(), vv.data(), v.size());
+        for(std::size_t i = 0; i < v.size(); ++i)
+        {
+            auto const s = resolved(ub, v[i]);
+            BOOST_TEST_EQ(vv[i].string(), s);
+            url_view const u =
+                parse_uri(s).value();
+            BOOST_TEST_EQ(
+                vv[i].encoded_host(),
+                u.encoded_host());
+            BOOST_TEST_EQ(vv[i].port(), u.port());
+            BOOST_TEST_EQ(
+                vv[i].segments().size(),
+                u.segments().size());
+            BOOST_TEST_EQ(
+                vv[i].params().size(),
+                u.params().size());
+            BOOST_TEST_EQ(
+                vv[i].path(), u.path());
+            BOOST_TEST_EQ(
+                vv[i].query(), u.query());
+            BOOST_TEST_EQ(
+                vv[i].fragment(), u.fragment());
+        }
+    }
+
+    void
+    testMembers()
+    {
+        // resolver(url_view_base)
+        {
+            BOOST_TEST_THROWS(
+                resolver(url_view("/a/b")),
+                system_error);
+            BOOST_TEST_THROWS(
+                resolver(url_view("//h/a/b")),
+                system_error);
+        }
+
+        // resolver(resolver const&)
+        // resolver(resolver&&)
+        // operator=(resolver const&)
+        // operator=(resolver&&)
+        {
+            url_view const ref("../x");
+            url_view dest;
+            resolver r0(url_view("http://a/b/c"));
+            r0.resolve(&ref, &dest, 1);
+            BOOST_TEST_EQ(
+                dest.string(), "http://a/x");
+
+            resolver r1(r0);
+            BOOST_TEST_EQ(
+                r1.base().string(), "http://a/b/c");
+            BOOST_TEST(
+                r1.base().string().data() !=
+                r0.base().string().data());
+            url u;
+            r1.resolve(ref, u);
+            BOOST_TEST_EQ(u.string(), "http://a/x");
+
+            // views survive a move
+            resolver r2(std::move(r0));
+            BOOST_TEST_EQ(
+                dest.string(), "http://a/x");
+            r2.resolve(ref, u);
+            BOOST_TEST_EQ(u.string(), "http://a/x");
+
+            resolver r3(url_view("s:/p/q"));
+            r3 = r1;
+            r3.resolve(ref, u);
+            BOOST_TEST_EQ(u.string(), "http://a/x");
+
+            r3 = std::move(r2);
+            BOOST_TEST_EQ(
+                dest.string(), "http://a/x");
+            r3.resolve(ref, u);
+            BOOST_TEST_EQ(u.string(), "http://a/x");
+
+            resolver const& r4 = r3;
+            r3 = r4;
+            r3.resolve(ref, u);
+            BOOST_TEST_EQ(u.string(), "http://a/x");
+        }
+
+        // resolve(url_view_base, url_base)
+        {
+            // ref refers to dest
+            resolver r(url_view("http://a/b/c/d"));
+            url u("../../x/y?q#f");
+            r.resolve(u, u);
+            BOOST_TEST_EQ(
+                u.string(), "http://a/x/y?q#f");
+
+            // base survives the source
+            std::string s = "http://h/a/b";
+            resolver r2{url_view(s)};
+            s = "xxxxxxxxxxxx";
+            r2.resolve(url_view("c"), u);
+            BOOST_TEST_EQ(
+                u.string(), "http://h/a/c");
+
+            // fits in a static_url
+            static_url<64> su;
+            r2.resolve(url_view("?q"), su);
+            BOOST_TEST_EQ(
+                su.string(), "http://h/a/b?q");
+        }
+
+        // resolve(url_view const*, url*, n)
+        {
+            resolver r(url_view("http://a/b/c"));
+            r.resolve(
+                static_cast<url_view const*>(nullptr),
+                static_cast<url*>(nullptr), 0);
+
+            // storage is reused
+            url_view const refs[2] = {
+                url_view("/x/y/z/w/v/u/t"),
+                url_view("g") };
+            url dest[2];
+            r.resolve(refs, dest, 2);
+            auto const p = dest[1].string().data();
+            url_view const refs2[2] = {
+                url_view("h"),
+                url_view("i") };
+            r.resolve(refs2, dest, 2);
+            BOOST_TEST_EQ(
+                dest[0].string(), "http://a/b/h");
+            BOOST_TEST_EQ(
+                dest[1].string(), "http://a/b/i");
+            BOOST_TEST(
+                dest[1].string().data() == p);
+        }
+
+        // resolve(url_view const*, url_view*, n)
+        {
+            resolver r(url_view(
+                "https://user@[::1]:8080/a/b/c?q=1#f"));
+            r.resolve(
+                static_cast<url_view const*>(nullptr),
+                static_cast<url_view*>(nullptr), 0);
+
+            auto const v = parse_all({
+                "d", "../e?x=1&y=2", "#g",
+                "//h:9/i", "s:j" });
+            std::vector<url_view> dest(v.size());
+            r.resolve(v.data(), dest.data(), v.size());
+            BOOST_TEST_EQ(dest[0].string(),
+                "https://user@[::1]:8080/a/b/d");
+            BOOST_TEST_EQ(dest[1].string(),
+                "https://user@[::1]:8080/a/e?x=1&y=2");
+            BOOST_TEST_EQ(dest[2].string(),
+                "https://user@[::1]:8080/a/b/c?q=1#g");
+            BOOST_TEST_EQ(dest[3].string(),
+                "https://h:9/i");
+            BOOST_TEST_EQ(dest[4].string(), "s:j");
+            BOOST_TEST(dest[0].host_type() ==
+                host_type::ipv6);
+            BOOST_TEST_EQ(dest[0].port_number(), 8080);
+            BOOST_TEST_EQ(dest[0].encoded_user(), "user");
+            BOOST_TEST_EQ(dest[1].params().size(), 2u);
+            BOOST_TEST_EQ(dest[3].port_number(), 9);
+            BOOST_TEST(dest[4].scheme_id() ==
+                scheme::unknown);
+
+            // storage is reused
+            auto const p = dest[0].string().data();
+            r.resolve(v.data(), dest.data(), 2);
+            BOOST_TEST(dest[0].string().data() == p);
+            BOOST_TEST_EQ(dest[1].string(),
+                "https://user@[::1]:8080/a/e?x=1&y=2");
+
+            // the results of a previous call
+            // may be resolved again
+            url_view const refs[2] = {
+                url_view("x/y"), url_view("../z") };
+            r.resolve(refs, dest.data(), 2);
+            r.resolve(dest.data(), dest.data(), 2);
+            BOOST_TEST_EQ(dest[0].string(),
+                "https://user@[::1]:8080/a/b/x/y");
+            BOOST_TEST_EQ(dest[1].string(),
+                "https://user@[::1]:8080/a/z");
+
+            // storage grows
+            std::vector<std::string> vs;
+            for(int i = 0; i < 500; ++i)
+                vs.push_back(
+                    "../p" + std::to_string(i) + "/" +
+                    std::string(i % 37, 'x'));
+            std::vector<url_view> refs3;
+            for(auto const& s : vs)
+                refs3.push_back(url_view(s));
+            std::vector<url_view> dest3(refs3.size());
+            r.resolve(refs3.data(),
+                dest3.data(), refs3.size());
+            for(std::size_t i = 0; i < vs.size(); ++i)
+                BOOST_TEST_EQ(
+                    dest3[i].string(),
+                    "https://user@[::1]:8080/a/p" +
+                        std::to_string(i) + "/" +
+                        std::string(i % 37, 'x'));
+        }
+    }
+
+    void
+    testResolve()
+    {
+        // rfc3986 5.4
+        std::vector<string_view> const refs = {
+            "g:h", "g", "./g", "g/", "/g", "//g",
+            "?y", "g?y", "#s", "g#s", "g?y#s",
+            ";x", "g;x", "g;x?y#s", "", ".", "./",
+            "..", "../", "../g", "../..", "../../",
+            "../../g", "../../../g", "../../../../g",
+            "/./g", "/../g", "g.", ".g", "g..", "..g",
+            "./../g", "./g/.", "g/./h", "g/../h",
+            "g;x=1/./y", "g;x=1/../y", "g?y/./x",
+            "g?y/../x", "g#s/./x", "g#s/../x",
+            "http:g", "//h:80/./b?%41", "a%2Fb/../c",
+            "..//c", "//u:p@[v1.x]/" };
+        check("http://a/b/c/d;p?q", refs);
+        check("http://a", refs);
+        check("http://a?q#f", refs);
+        check("http://u:p@a:8080/", refs);
+        check("s:a/b", refs);
+        check("s:", refs);
+        check("s:/a/b", refs);
+        check("s:/a?q", refs);
+        check("s://h", refs);
+        check("file:///c:/x/%41.txt", refs);
+    }
+
+    void
+    run()
+    {
+        testMembers();
+        testResolve();
+    }
+};
+
+TEST_SUITE(
+    resolver_test,
+    "boost.url.resolver");
+
+} // urls
+} // boost
@@ -10,16 +10,114 @@
 // Test that header file is self-contained.
 #include <boost/url/rfc/ipv4_address_rule.hpp>
 
+#include <boost/url/grammar/dec_octet_rule.hpp>
+#include <boost/url/grammar/delim_rule.hpp>
+#include <boost/url/grammar/tuple_rule.hpp>
 #include "test_rule.hpp"
+#include <string>
 
 namespace boost {
 namespace urls {
 
 struct ipv4_address_rule_test
 {
+    // the rule, built from the grammar
+    static
+    result<ipv4_address>
+    reference(
+        char const*& it,
+        char const* end)
+    {
+        auto rv = grammar::parse(
+            it, end,
+            grammar::tuple_rule(
+                grammar::dec_octet_rule,
+                grammar::squelch(
+                    grammar::delim_rule('.')),
+                grammar::dec_octet_rule,
+                grammar::squelch(
+                    grammar::delim_rule('.')),
+                grammar::dec_octet_rule,
+                grammar::squelch(
+                    grammar::delim_rule('.')),
+                grammar::dec_octet_rule));
+        if(! rv)
+            return rv.error();
+        return ipv4_address(
+            ipv4_address::bytes_type{{
+                std::get<0>(*rv),
+                std::get<1>(*rv),
+                std::get<2>(*rv),
+                std::get<3>(*rv)}});
+    }
+
+    void
+    check(string_view s)
+    {
+        char const* it0 = s.data();
+        char const* it1 = s.data();
+        auto const end =
+            s.data() + s.size();
+        auto rv0 = reference(it0, end);
+        auto rv1 = grammar::parse(
+            it1, end, ipv4_address_rule);
+        if(! BOOST_TEST_EQ(
+                rv0.has_value(),
+                rv1.has_value()))
+            return;
+        if(rv0.has_value())
+        {
+            BOOST_TEST_EQ(*rv0, *rv1);
+            BOOST_TEST_EQ(it0, it1);
+        }
+        else
+        {
+            BOOST_TEST_EQ(
+                rv0.error(), rv1.error());
+        }
+    }
+
+    void
+    testReference()
+    {
+        check("");
+        check("0.0.0.0");
+        check("255.255.255.255");
+        check("256.255.255.255");
+        check("255.255.255.256");
+        check("01.2.3.4");
+        check("1.2.3.04");
+        check("1.2.3.4.5");
+        check("1.2.3.1234");
+        check("1.2.3");
+        check("1.2.3.");
+        check("1..2.3");
+        check("1.2.3.4x");
+        check("x.2.3.4");
+
+        // random strings of digits and dots
+        std::string s;
+        unsigned x = 1;
+        for(int i = 0; i < 20000; ++i)
+        {
+            s.clear();
+            x = x * 1103515245 + 12345;
+            auto n = (x >> 16) % 18;
+            while(n--)
+            {
+                x = x * 1103515245 + 12345;
+                s.push_back("0123456789.x"[
+                    (x >> 16) % 12]);
+            }
+            check(s);
+        }
+    }
+
     void
     run()
     {
+        testReference();
+
         // javadoc
         {
             result< ipv4_address > rv = grammar::parse( "192.168.0.1", ipv4_address_rule );
@@ -10,16 +10,182 @@
 // Test that header file is self-contained.
 #include <boost/url/rfc/origin_form_rule.hpp>
 
+#include <boost/url/rfc/detail/fused_rules.hpp>
+#include <boost/url/grammar/parse.hpp>
+
 #include "test_rule.hpp"
 
+#include <cstdint>
+#include <string>
+
 namespace boost {
 namespace urls {
 
 struct origin_form_rule_test
 {
+    // check that origin_form_rule
+    // matches the grammar rule
+    static
+    void
+    check_fused(string_view s)
+    {
+        auto it0 = s.data();
+        auto it1 = s.data();
+        auto const end = s.data() + s.size();
+        auto rv0 = origin_form_rule.parse(
+            it0, end);
+        auto rv1 = detail::origin_form_grammar_rule.parse(
+            it1, end);
+        BOOST_TEST_EQ(
+            rv0.has_value(), rv1.has_value());
+        if(rv0.has_error() || rv1.has_error())
+        {
+            if(rv0.has_error() && rv1.has_error())
+                BOOST_TEST_EQ(
+                    rv0.error(), rv1.error());
+            return;
+        }
+        BOOST_TEST(it0 == it1);
+        url_view const& u0 = *rv0;
+        url_view const& u1 = *rv1;
+        BOOST_TEST(u0.data() == u1.data());
+        BOOST_TEST_EQ(u0.size(), u1.size());
+        BOOST_TEST_EQ(u0.scheme_id(), u1.scheme_id());
+        BOOST_TEST_EQ(u0.has_authority(), u1.has_authority());
+        BOOST_TEST_EQ(u0.host_type(), u1.host_type());
+        BOOST_TEST_EQ(u0.encoded_path(), u1.encoded_path());
+        BOOST_TEST_EQ(u0.path().size(), u1.path().size());
+        BOOST_TEST_EQ(u0.segments().size(), u1.segments().size());
+        BOOST_TEST_EQ(u0.has_query(), u1.has_query());
+        BOOST_TEST_EQ(u0.encoded_query(), u1.encoded_query());
+        BOOST_TEST_EQ(u0.query().size(), u1.query().size());
+        BOOST_TEST_EQ(u0.params().size(), u1.params().size());
+        BOOST_TEST_EQ(u0.has_fragment(), u1.has_fragment());
+    }
+
+    void
+    testFused()
+    {
+        string_view const cases[] = {
+            "",
+            "x",
+            "/",
+            "//",
+            "/./",
+            "/.//a",
+            "/a/b/c/",
+            "/:@!$&'()*+,;=",
+            "/?",
+            "/??",
+            "/?a=1&b=2&&c#f",
+            "/?a=[]&b]#?",
+            "/?a[]=1&a[]=2&b[x]=[",
+            "/?a=b=c[&d[",
+            "/%41/%42?%43=%44",
+            "/a%2/",
+            "/a/%zz",
+            "/a?%",
+            "/a?b%4",
+            "/a#%4",
+            "/a b",
+            "/a\nb",
+            "/a/\xff",
+            "/index.htm?id=42 HTTP/1.1\r\n",
+            "/api/v1/users/12345/orders?page=2&per_page=50&sort=-created_at",
+            "/static/css/theme-dark.min.css?v=1.2.3",
+            "/search?q=boost%20url&lang=en&safe=off&tbm=isch&source=lnms",
+            };
+
+        // each case, then each case with
+        // each position replaced by, or
+        // preceded by, an interesting char
+        string_view const chars =
+            "%:/?#[]@!&=.-+1aF \n\xff\"<>^`{|}~";
+        for(auto s : cases)
+        {
+            check_fused(s);
+            for(std::size_t i = 0;
+                i < s.size(); ++i)
+            {
+                for(char c : chars)
+                {
+                    std::string t(s);
+                    t[i] = c;
+                    check_fused(t);
+                    t = std::string(s);
+                    t.insert(t.begin() + i, c);
+                    check_fused(t);
+                }
+            }
+        }
+
+        // pairs of cases joined
+        for(auto s0 : cases)
+        for(auto s1 : cases)
+        {
+            std::string t(s0);
+            t += std::string(s1);
+            check_fused(t);
+        }
+
+        // random targets, long enough
+        // for the vector loops to run
+        std::uint32_t seed = 1;
+        auto const rand = [&seed]
+        {
+            seed = seed * 1103515245 + 12345;
+            return (seed >> 16) & 0x7fff;
+        };
+        string_view const alphabet =
+            "/////?&&==[]%%#:@!$'()*+,;-._~"
+            " \"<>\\^`{|}\x7f\x80\xff";
+        for(int iter = 0; iter < 20000; ++iter)
+        {
+            std::string s("/");
+            auto const len = rand() % 80;
+            // mostly clean runs
+            auto const noise = rand() % 8;
+            while(s.size() < len)
+            {
+                auto const r = rand() % 64;
+                if(r >= noise)
+                    s.push_back(static_cast<char>(
+                        'a' + rand() % 26));
+                else if(r % 4 == 0)
+                    s.append("%4F");
+                else
+                    s.push_back(alphabet[
+                        rand() % alphabet.size()]);
+            }
+            check_fused(s);
+        }
+    }
+
+    void
+    testParse()
+    {
+        auto rv = parse_origin_form(
+            "/a/b/c/?x=1&y&z[]=2");
+        if(! BOOST_TEST(rv.has_value()))
+            return;
+        BOOST_TEST_EQ(rv->encoded_path(), "/a/b/c/");
+        BOOST_TEST_EQ(rv->segments().size(), 4u);
+        BOOST_TEST_EQ(rv->encoded_query(), "x=1&y&z[]=2");
+        BOOST_TEST_EQ(rv->params().size(), 3u);
+
+        BOOST_TEST(parse_origin_form("").has_error());
+        BOOST_TEST(parse_origin_form("a").has_error());
+        BOOST_TEST(parse_origin_form("/a%").has_error());
+        BOOST_TEST(parse_origin_form("/?a=[").has_error());
+        BOOST_TEST(parse_origin_form("/#").has_error());
+    }
+
     void
     run()
     {
+        testFused();
+        testParse();
+
         // javadoc
         {
             result< url_view > rv = grammar::parse( "/index.htm?layout=mobile", origin_form_rule );
@@ -0,0 +1,396 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/router.hpp>
+
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/normalize.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+class router_test
+{
+public:
+    // match the path and check the
+    // route and parameter values
+    static
+    void
+    check(
+        router const& r,
+        string_view path,
+        std::size_t id,
+        std::vector<string_view> params = {})
+    {
+        url_view const u(path);
+        route_match m;
+        if(! BOOST_TEST(r.match(u, m)))
+            return;
+        BOOST_TEST_EQ(m.id(), id);
+        if(! BOOST_TEST_EQ(
+                m.size(), params.size()))
+            return;
+        for(std::size_t i = 0; i < m.size(); ++i)
+            BOOST_TEST_EQ(m[i], params[i]);
+    }
+
+    static
+    void
+    bad(
+        router const& r,
+        string_view path)
+    {
+        url_view const u(path);
+        route_match m;
+        BOOST_TEST(! r.match(u, m));
+    }
+
+    void
+    testInsert()
+    {
+        router r;
+        BOOST_TEST_EQ(r.size(), 0u);
+        bad(r, "/");
+        BOOST_TEST_EQ(r.insert("/"), 0u);
+        BOOST_TEST_EQ(r.insert("/a/b"), 1u);
+        BOOST_TEST_EQ(r.insert("a/{x}"), 2u);
+        BOOST_TEST_EQ(r.insert("/a/*"), 3u);
+        BOOST_TEST_EQ(r.size(), 4u);
+
+        // duplicates
+        BOOST_TEST_THROWS(r.insert(""),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(r.insert("/a/{y}"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(r.insert("a/*"),
+            std::invalid_argument);
+
+        // '*' must be last
+        BOOST_TEST_THROWS(r.insert("/*/a"),
+            std::invalid_argument);
+
+        // literals must be valid segments
+        BOOST_TEST_THROWS(r.insert("/a%"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(r.insert("/a%2"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(r.insert("/%zz/{x}"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(r.insert("/a b"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(r.insert("/a?"),
+            std::invalid_argument);
+        bad(r, "/a%25");
+
+        // too many params
+        {
+            std::string s;
+            for(int i = 0; i < 17; ++i)
+                s += "/{p}";
+            BOOST_TEST_THROWS(r.insert(s),
+                std::length_error);
+            s.resize(s.size() - 4);
+            BOOST_TEST_NO_THROW(r.insert(s));
+        }
+
+        // failures leave the routes unchanged
+        BOOST_TEST_EQ(r.size(), 5u);
+        check(r, "/", 0);
+        check(r, "/a/b", 1);
+        check(r, "/a/c", 2, {"c"});
+        check(r, "/a/b/c", 3, {"b/c"});
+    }
+
+    void
+    testMatch()
+    {
+        router r;
+        r.insert("/users");
+        r.insert("/users/{id}");
+        r.insert("/users/me");
+        r.insert("/users/{id}/files/*");
+        r.insert("/users/{id}/{what}");
+        r.insert("/static/*");
+        r.insert("/a/b/c");
+        r.insert("/{x}/b/d");
+        r.insert("/trailing/");
+
+        check(r, "/users", 0);
+        check(r, "/users/42", 1, {"42"});
+        check(r, "/users/me", 2);
+        check(r, "/users/42/files/a/b.txt",
+            3, {"42", "a/b.txt"});
+        check(r, "/users/42/files/",
+            3, {"42", ""});
+        check(r, "/users/42/files",
+            3, {"42", ""});
+        check(r, "/users/42/filez",
+            4, {"42", "filez"});
+        check(r, "/users/me/files/x",
+            3, {"me", "x"});
+        check(r, "/static", 5, {""});
+        check(r, "/static/", 5, {""});
+        check(r, "/static/css/x.css",
+            5, {"css/x.css"});
+        check(r, "/trailing/", 8);
+
+        // literals are tried first,
+        // then parameters
+        check(r, "/a/b/c", 6);
+        check(r, "/a/b/d", 7, {"a"});
+        check(r, "/z/b/d", 7, {"z"});
+
+        // compared as if decoded, values
+        // are the encoded segments
+        check(r, "/%75sers/%34%32",
+            1, {"%34%32"});
+        check(r, "/users/m%65", 2);
+
+        bad(r, "");
+        bad(r, "/");
+        bad(r, "/user");
+        bad(r, "/usersx");
+        bad(r, "/users/42/x/y");
+        bad(r, "/a/b/e");
+        bad(r, "/trailing");
+
+        // queries and fragments are ignored
+        check(r, "/users/7?x=1#f", 1, {"7"});
+
+        // relative paths are matched
+        // the same way
+        check(r, "users/7", 1, {"7"});
+
+        // values refer to the url
+        {
+            url_view const u("/users/42");
+            route_match m;
+            BOOST_TEST(r.match(u, m));
+            BOOST_TEST(m[0].data() ==
+                u.encoded_path().data() + 7);
+        }
+    }
+
+    void
+    testNames()
+    {
+        router r;
+        r.insert("/{a}/x/{bc}/*");
+        route_match m;
+        BOOST_TEST(r.match(
+            url_view("/1/x/2/3/4"), m));
+        BOOST_TEST_EQ(m.size(), 3u);
+        BOOST_TEST_EQ(m.name(0), "a");
+        BOOST_TEST_EQ(m.name(1), "bc");
+        BOOST_TEST_EQ(m.name(2), "*");
+        BOOST_TEST_EQ(m.find("a"), 0u);
+        BOOST_TEST_EQ(m.find("bc"), 1u);
+        BOOST_TEST_EQ(m.find("*"), 2u);
+        BOOST_TEST_EQ(m.find("x"), 3u);
+        BOOST_TEST_EQ(m[m.find("bc")], "2");
+        BOOST_TEST_EQ(m[2], "3/4");
+    }
+
+    void
+    testSpecial()
+    {
+        router r0;
+        r0.insert("/a/{x}");
+        r0.insert("/b");
+
+        // router(router const&)
+        {
+            router r1(r0);
+            BOOST_TEST_EQ(r1.size(), 2u);
+            check(r1, "/a/1", 0, {"1"});
+            r1.insert("/c");
+            BOOST_TEST_EQ(r0.size(), 2u);
+            bad(r0, "/c");
+        }
+
+        // router(router&&)
+        {
+            router r1(r0);
+            router r2(std::move(r1));
+            BOOST_TEST_EQ(r1.size(), 0u);
+            bad(r1, "/b");
+            check(r2, "/b", 1);
+        }
+
+        // operator=(router const&)
+        {
+            router r1;
+            r1.insert("/x");
+            r1 = r0;
+            check(r1, "/b", 1);
+            bad(r1, "/x");
+        }
+
+        // operator=(router&&)
+        {
+            router r1;
+            router r2(r0);
+            r1 = std::move(r2);
+            check(r1, "/b", 1);
+            BOOST_TEST_EQ(r2.size(), 0u);
+        }
+    }
+
+    // many routes, against a linear search
+    // for the pattern whose segment kinds
+    // are least: literal, parameter, wildcard
+    void
+    testMany()
+    {
+        std::vector<std::string> pats;
+        for(int i = 0; i < 2000; ++i)
+        {
+            auto const a = std::to_string(i % 37);
+            auto const b = std::to_string(i);
+            switch(i % 4)
+            {
+            case 0: pats.push_back("/api/" + a + "/" + b); break;
+            case 1: pats.push_back("/api/" + a + "/{id}/" + b); break;
+            case 2: pats.push_back("/svc" + b + "/*"); break;
+            case 3: pats.push_back("/{t}/" + b + "/" + a); break;
+            }
+        }
+        router r;
+        for(auto const& p : pats)
+            r.insert(p);
+
+        auto const kinds = [](
+            string_view pat,
+            segments_encoded_view segs,
+            std::string& k)
+        {
+            // braces are not pchars, so
+            // split the pattern by hand
+            k.clear();
+            pat.remove_prefix(1);
+            auto it = segs.begin();
+            for(;;)
+            {
+                auto const p = pat.find('/');
+                auto const s = pat.substr(0, p);
+                if(s == "*")
+                {
+                    k.push_back('2');
+                    return true;
+                }
+                if(it == segs.end())
+                    return false;
+                if(! s.empty() && s.front() == '{')
+                    k.push_back('1');
+                else if(detail::compare_encoded(
+                        s, *it) == 0)
+                    k.push_back('0');
+                else
+                    return false;
+                ++it;
+                if(p == string_view::npos)
+                    break;
+                pat.remove_prefix(p + 1);
+            }
+            return it == segs.end();
+        };
+
+        std::string k;
+        std::string best;
+        for(int i = 0; i < 3000; ++i)
+        {
+            auto const a = std::to_string(i % 41);
+            auto const b = std::to_string(i);
+            for(auto const& s : {
+                "/api/" + a + "/" + b,
+                "/api/" + a + "/x/" + b,
+                "/svc" + b + "/q/r",
+                "/t/" + b + "/" + a,
+                "/svc" + b,
+                "/api/" + b })
+            {
+                url_view const u(s);
+                auto const segs =
+                    u.encoded_segments();
+                auto id = pats.size();
+                for(std::size_t j = 0;
+                    j < pats.size(); ++j)
+                {
+                    if( kinds(pats[j], segs, k) &&
+                        (id == pats.size() || k < best))
+                    {
+                        id = j;
+                        best = k;
+                    }
+                }
+                route_match m;
+                if(id == pats.size())
+                {
+                    BOOST_TEST(! r.match(u, m));
+                    continue;
+                }
+                if(BOOST_TEST(r.match(u, m)))
+                    BOOST_TEST_EQ(m.id(), id);
+            }
+        }
+    }
+
+    void
+    testJavadocs()
+    {
+        // router
+        {
+        router r;
+        r.insert( "/users/{id}" );
+        r.insert( "*" );
+
+        route_match m;
+
+        assert( r.match( url_view( "/users/42" ), m ) );
+        assert( m.id() == 0 );
+        assert( m[0] == "42" );
+
+        assert( r.match( url_view( "/about/team" ), m ) );
+        assert( m.id() == 1 );
+        assert( m[0] == "about/team" );
+        }
+
+        // insert
+        {
+        router r;
+        assert( r.insert( "/" ) == 0 );
+        assert( r.insert( "*" ) == 1 );
+        assert( r.insert( "/users/{id}/posts/{post}" ) == 2 );
+        }
+    }
+
+    void
+    run()
+    {
+        testInsert();
+        testMatch();
+        testNames();
+        testSpecial();
+        testMany();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    router_test,
+    "boost.url.router");
+
+} // urls
+} // boost
@@ -10,12 +10,44 @@
 // Test that header file is self-contained.
 #include <boost/url/scheme.hpp>
 
+#include <boost/url/detail/scheme_table.hpp>
 #include <boost/url/grammar/ci_string.hpp>
 #include "test_suite.hpp"
+#include <cctype>
 
 namespace boost {
 namespace urls {
 
+namespace {
+
+constexpr
+scheme
+user_scheme(int i) noexcept
+{
+    return static_cast<scheme>(100 + i);
+}
+
+// schemes an application might register
+struct test_schemes
+{
+    static constexpr std::size_t size = 9;
+    static constexpr detail::scheme_info value[size] = {
+        detail::make_scheme_info("http", scheme::http, 80),
+        detail::make_scheme_info("https", scheme::https, 443),
+        detail::make_scheme_info("s3", user_scheme(0), 443),
+        detail::make_scheme_info("gs", user_scheme(1), 443),
+        detail::make_scheme_info("hdfs", user_scheme(2), 8020),
+        detail::make_scheme_info("kafka", user_scheme(3), 9092),
+        detail::make_scheme_info("redis", user_scheme(4), 6379),
+        detail::make_scheme_info("svn+ssh", user_scheme(5), 22),
+        detail::make_scheme_info("chrome-extension", user_scheme(6), 0) };
+};
+
+constexpr std::size_t test_schemes::size;
+constexpr detail::scheme_info test_schemes::value[];
+
+} // (anon)
+
 class scheme_test
 {
 public:
@@ -124,6 +156,66 @@ public:
         check("gopher");
         check("magnet");
         check("mailto");
+        check("https-");
+        check(std::string("ws\0", 3));
+        check("HTTP\x14");
+        check("h\x14tp");
+
+        testDefaultPort();
+        testUserSchemes();
+    }
+
+    void
+    testDefaultPort()
+    {
+        BOOST_TEST_EQ(default_port(scheme::none), 0);
+        BOOST_TEST_EQ(default_port(scheme::unknown), 0);
+        BOOST_TEST_EQ(default_port(scheme::ftp), 21);
+        BOOST_TEST_EQ(default_port(scheme::file), 0);
+        BOOST_TEST_EQ(default_port(scheme::http), 80);
+        BOOST_TEST_EQ(default_port(scheme::https), 443);
+        BOOST_TEST_EQ(default_port(scheme::ws), 80);
+        BOOST_TEST_EQ(default_port(scheme::wss), 443);
+        BOOST_TEST_EQ(default_port(
+            static_cast<scheme>(1000)), 0);
+        BOOST_TEST_EQ(to_string(
+            static_cast<scheme>(1000)), "<unknown>");
+    }
+
+    void
+    testUserSchemes()
+    {
+        using table =
+            detail::scheme_table<test_schemes>;
+        auto const find = [](string_view s)
+        {
+            return table::find(s);
+        };
+
+        for(auto const& e : test_schemes::value)
+        {
+            std::string s(e.str, e.len);
+            BOOST_TEST(find(s) == e.id);
+            for(auto& c : s)
+                c = static_cast<char>(
+                    std::toupper(
+                        static_cast<unsigned char>(c)));
+            BOOST_TEST(find(s) == e.id);
+            BOOST_TEST(find(s.substr(1)) != e.id);
+            BOOST_TEST(find(s + "x") != e.id);
+        }
+        BOOST_TEST(find("") == scheme::none);
+        BOOST_TEST(find("Kafka") == user_scheme(3));
+        BOOST_TEST(find("S3") == user_scheme(0));
+        BOOST_TEST(find("Chrome-Extension") == user_scheme(6));
+        BOOST_TEST(find("chrome-extensiom") == scheme::unknown);
+        BOOST_TEST(find("chrome_extension") == scheme::unknown);
+        BOOST_TEST(find("chrome-extension-x") == scheme::unknown);
+        BOOST_TEST(find("svn+SSH") == user_scheme(5));
+        BOOST_TEST(find("svn\x0bssh") == scheme::unknown);
+        BOOST_TEST(find("s4") == scheme::unknown);
+        BOOST_TEST(find("ftp") == scheme::unknown);
+        BOOST_TEST(find("redis0") == scheme::unknown);
     }
 };
 
@@ -11,9 +11,11 @@
 // Test that header file is self-contained.
 #include <boost/url/segments_encoded.hpp>
 
+#include <boost/url/static_url.hpp>
 #include <boost/url/url.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/static_assert.hpp>
+#include <algorithm>
 #include <initializer_list>
 #include <iterator>
 #include "test_suite.hpp"
@@ -463,6 +465,139 @@ public:
         }
     }
 
+    void
+    testIndexedEdits()
+    {
+        // url locates segments through its
+        // segment table, while static_url
+        // never builds one and scans instead.
+        auto const check = [](
+            url_view_base const& u,
+            url_view_base const& v)
+        {
+            BOOST_TEST_EQ(u.string(), v.string());
+            auto const su = u.encoded_segments();
+            auto const sv = v.encoded_segments();
+            BOOST_TEST_EQ(su.size(), sv.size());
+            BOOST_TEST(std::equal(
+                su.begin(), su.end(), sv.begin()));
+        };
+
+        auto const edits = [&check](
+            url_base& u, url_base& v)
+        {
+            auto eu = u.encoded_segments();
+            auto ev = v.encoded_segments();
+
+            // replace each segment in turn
+            for(auto iu = eu.begin(), iv = ev.begin();
+                iu != eu.end(); ++iu, ++iv)
+            {
+                iu = eu.replace(iu, "seg");
+                iv = ev.replace(iv, "seg");
+                BOOST_TEST_EQ(*iu, *iv);
+                check(u, v);
+            }
+
+            // insert in the middle
+            auto it = eu.insert(std::next(
+                eu.begin(), eu.size() / 2), "mid");
+            BOOST_TEST_EQ(*it, "mid");
+            ev.insert(std::next(
+                ev.begin(), ev.size() / 2), "mid");
+            check(u, v);
+
+            // insert several at the front
+            it = eu.insert(eu.begin(), {"", "a:b", "c"});
+            BOOST_TEST_EQ(*it, "");
+            ev.insert(ev.begin(), {"", "a:b", "c"});
+            check(u, v);
+
+            eu.push_back("end");
+            ev.push_back("end");
+            check(u, v);
+
+            // erase from the front
+            it = eu.erase(eu.begin());
+            BOOST_TEST(it == eu.begin());
+            ev.erase(ev.begin());
+            check(u, v);
+
+            // erase a range in the middle
+            it = eu.erase(
+                std::next(eu.begin()),
+                std::next(eu.begin(), 3));
+            BOOST_TEST(it == std::next(eu.begin()));
+            ev.erase(
+                std::next(ev.begin()),
+                std::next(ev.begin(), 3));
+            check(u, v);
+
+            // modifications which bypass
+            // the segment table
+            u.set_path_absolute(
+                ! u.is_path_absolute());
+            v.set_path_absolute(
+                ! v.is_path_absolute());
+            check(u, v);
+            eu.insert(std::next(eu.begin()), ".");
+            ev.insert(std::next(ev.begin()), ".");
+            check(u, v);
+            u.normalize_path();
+            v.normalize_path();
+            check(u, v);
+            eu.insert(std::prev(eu.end()), "x");
+            ev.insert(std::prev(ev.end()), "x");
+            check(u, v);
+            u.set_encoded_path("/p/q/r");
+            v.set_encoded_path("/p/q/r");
+            check(u, v);
+            eu.erase(std::next(eu.begin()));
+            ev.erase(std::next(ev.begin()));
+            check(u, v);
+        };
+
+        for(string_view s : {
+            "x://y/path/to/the/file.txt?q#f",
+            "x:path/to/the/file.txt",
+            "x:/path/to/the/file.txt",
+            "path/to/the/file.txt",
+            "/path/to/the/file.txt",
+            "//y/a/b/c/d/e/f/g/h/i/j/k",
+            "x://y",
+            "" })
+        {
+            url u = parse_uri_reference(s).value();
+            static_url<1024> v(s);
+            edits(u, v);
+
+            // copies do not share a table
+            url u2 = u;
+            static_url<1024> v2 = v;
+            edits(u2, v2);
+            u2 = u;
+            v2 = v;
+            edits(u2, v2);
+        }
+
+        // many edits on a deep path
+        {
+            url u = parse_relative_ref("/a").value();
+            auto se = u.encoded_segments();
+            for(int i = 0; i < 200; ++i)
+                se.insert(std::next(
+                    se.begin(), se.size() / 2), "s");
+            for(auto it = se.begin();
+                    it != se.end(); ++it)
+                it = se.replace(it, "t");
+            BOOST_TEST_EQ(se.size(), 201u);
+            BOOST_TEST_EQ(se.back(), "t");
+            while(se.size() > 1)
+                se.erase(std::next(se.begin()));
+            BOOST_TEST_EQ(u.string(), "/t");
+        }
+    }
+
     void
     run()
     {
@@ -471,6 +606,7 @@ public:
         testIterators();
         testCapacity();
         testModifiers();
+        testIndexedEdits();
     }
 };
 
@@ -0,0 +1,465 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/CPPAlliance/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/url_builder.hpp>
+
+#include <boost/url/static_url.hpp>
+#include <boost/url/url_view.hpp>
+#include "test_suite.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+class url_builder_test
+{
+public:
+    // check the url against the
+    // result of parsing its string
+    static
+    void
+    check(url_view_base const& u0)
+    {
+        auto rv = parse_uri_reference(
+            u0.string());
+        if(! BOOST_TEST(rv.has_value()))
+            return;
+        url_view const& u1 = *rv;
+        BOOST_TEST_EQ(u0.scheme(), u1.scheme());
+        BOOST_TEST_EQ(u0.scheme_id(), u1.scheme_id());
+        BOOST_TEST_EQ(u0.has_authority(), u1.has_authority());
+        BOOST_TEST_EQ(u0.has_userinfo(), u1.has_userinfo());
+        BOOST_TEST_EQ(u0.encoded_user(), u1.encoded_user());
+        BOOST_TEST_EQ(u0.user().size(), u1.user().size());
+        BOOST_TEST_EQ(u0.has_password(), u1.has_password());
+        BOOST_TEST_EQ(u0.encoded_password(), u1.encoded_password());
+        BOOST_TEST_EQ(u0.password().size(), u1.password().size());
+        BOOST_TEST_EQ(u0.host_type(), u1.host_type());
+        BOOST_TEST_EQ(u0.encoded_host(), u1.encoded_host());
+        BOOST_TEST_EQ(u0.host().size(), u1.host().size());
+        BOOST_TEST(u0.ipv4_address() == u1.ipv4_address());
+        BOOST_TEST(u0.ipv6_address() == u1.ipv6_address());
+        BOOST_TEST_EQ(u0.has_port(), u1.has_port());
+        BOOST_TEST_EQ(u0.port(), u1.port());
+        BOOST_TEST_EQ(u0.port_number(), u1.port_number());
+        BOOST_TEST_EQ(u0.encoded_path(), u1.encoded_path());
+        BOOST_TEST_EQ(u0.path().size(), u1.path().size());
+        BOOST_TEST_EQ(u0.segments().size(), u1.segments().size());
+        BOOST_TEST_EQ(u0.has_query(), u1.has_query());
+        BOOST_TEST_EQ(u0.encoded_query(), u1.encoded_query());
+        BOOST_TEST_EQ(u0.query().size(), u1.query().size());
+        BOOST_TEST_EQ(u0.params().size(), u1.params().size());
+        BOOST_TEST_EQ(u0.has_fragment(), u1.has_fragment());
+        BOOST_TEST_EQ(u0.encoded_fragment(), u1.encoded_fragment());
+        BOOST_TEST_EQ(u0.fragment().size(), u1.fragment().size());
+
+        // segments and params are
+        // found from the counts
+        auto it = u1.encoded_segments().begin();
+        for(auto s : u0.encoded_segments())
+            BOOST_TEST_EQ(s, *it++);
+        auto jt = u1.encoded_params().begin();
+        for(auto p : u0.encoded_params())
+        {
+            BOOST_TEST_EQ(p.key, (*jt).key);
+            ++jt;
+        }
+    }
+
+    static
+    void
+    check(
+        url_builder const& b,
+        string_view s)
+    {
+        BOOST_TEST_EQ(b.size(), s.size());
+        url u = b.build();
+        BOOST_TEST_EQ(u.string(), s);
+        check(u);
+    }
+
+    void
+    testBuild()
+    {
+        check(url_builder(), "");
+        check(url_builder()
+            .set_scheme("http"), "http:");
+        check(url_builder()
+            .set_scheme(scheme::https)
+            .set_host("example.com")
+            .set_port(8080)
+            .set_path("/a b/c")
+            .set_query("x=1&y=2")
+            .set_fragment("f"),
+            "https://example.com:8080/a%20b/c?x=1&y=2#f");
+        check(url_builder()
+            .set_user("u s")
+            .set_password("p:w")
+            .set_host("h"),
+            "//u%20s:p:w@h");
+        check(url_builder()
+            .set_encoded_user("u%20s")
+            .set_encoded_password("")
+            .set_encoded_host("[::1]")
+            .set_port("80"),
+            "//u%20s:@[::1]:80");
+        check(url_builder()
+            .set_password("p"),
+            "//:p@");
+        check(url_builder()
+            .set_user(""),
+            "//@");
+        check(url_builder()
+            .set_port(""),
+            "//:");
+        check(url_builder()
+            .set_host("1.2.3.4"),
+            "//1.2.3.4");
+        check(url_builder()
+            .set_host("01.2.3.4"),
+            "//01.2.3.4");
+        check(url_builder()
+            .set_host("a b:1"),
+            "//a%20b%3a1");
+        check(url_builder()
+            .set_encoded_host("%41"),
+            "//%41");
+        check(url_builder()
+            .set_scheme("file")
+            .set_host("")
+            .set_path("/etc/hosts"),
+            "file:///etc/hosts");
+        check(url_builder()
+            .set_scheme("mailto")
+            .set_path("a@b"),
+            "mailto:a@b");
+        check(url_builder()
+            .set_query(""),
+            "?");
+        check(url_builder()
+            .set_encoded_query("a=%20&&b"),
+            "?a=%20&&b");
+        check(url_builder()
+            .set_query("a[]=1#"),
+            "?a%5b%5d=1%23");
+        check(url_builder()
+            .set_fragment(""),
+            "#");
+        check(url_builder()
+            .set_encoded_fragment("a?/%41"),
+            "#a?/%41");
+
+        // prefixes which keep the path
+        // from being taken for some
+        // other part of the url
+        check(url_builder()
+            .set_host("h")
+            .set_path("a/b"),
+            "//h/a/b");
+        check(url_builder()
+            .set_path("//a"),
+            "/.//a");
+        check(url_builder()
+            .set_scheme("x")
+            .set_path("//a"),
+            "x:/.//a");
+        check(url_builder()
+            .set_path("a:b/c"),
+            "./a:b/c");
+        check(url_builder()
+            .set_scheme("x")
+            .set_path("a:b/c"),
+            "x:a:b/c");
+        check(url_builder()
+            .set_path("a/b:c"),
+            "a/b:c");
+        check(url_builder()
+            .set_host("h")
+            .set_path("//a"),
+            "//h//a");
+    }
+
+    // each combination of parts, checked
+    // against parsing the result, and
+    // against setting the parts of a url
+    // one at a time
+    void
+    testParts()
+    {
+        string_view const schemes[] = {
+            "", "http", "x+y" };
+        string_view const users[] = {
+            "<none>", "", "u", "u s@:" };
+        string_view const passes[] = {
+            "<none>", "", "p:w", "%" };
+        string_view const hosts[] = {
+            "<none>", "", "example.com",
+            "1.2.3.4", "a b" };
+        string_view const ports[] = {
+            "<none>", "", "80", "65536" };
+        string_view const paths[] = {
+            "", "/", "a", "/a/b/", "a:b",
+            "//x", "a b/%/c", "./a" };
+        string_view const queries[] = {
+            "<none>", "x", "a=1&b&&c=%" };
+        string_view const frags[] = {
+            "<none>", "", "f#g" };
+        auto const none = [](string_view s)
+        {
+            return s == "<none>";
+        };
+
+        for(auto scheme : schemes)
+        for(auto user : users)
+        for(auto pass : passes)
+        for(auto host : hosts)
+        for(auto port : ports)
+        for(auto path : paths)
+        for(auto query : queries)
+        for(auto frag : frags)
+        {
+            url_builder b;
+            url v;
+            if(! scheme.empty())
+            {
+                b.set_scheme(scheme);
+                v.set_scheme(scheme);
+            }
+            if(! none(user))
+            {
+                b.set_user(user);
+                v.set_user(user);
+            }
+            if(! none(pass))
+            {
+                b.set_password(pass);
+                v.set_password(pass);
+            }
+            if(! none(host))
+            {
+                b.set_host(host);
+                v.set_host(host);
+            }
+            if(! none(port))
+            {
+                b.set_port(port);
+                v.set_port(port);
+            }
+            b.set_path(path);
+            if(! path.empty())
+                v.set_path(path);
+            if(! none(query))
+            {
+                b.set_query(query);
+                v.set_query(query);
+            }
+            if(! none(frag))
+            {
+                b.set_fragment(frag);
+                v.set_fragment(frag);
+            }
+            url u;
+            b.build(u);
+            BOOST_TEST_EQ(b.size(), u.size());
+            check(u);
+
+            // the same parts as setting
+            // them one at a time, which
+            // may prefix the path differently
+            BOOST_TEST_EQ(u.scheme(), v.scheme());
+            BOOST_TEST_EQ(u.encoded_user(), v.encoded_user());
+            BOOST_TEST_EQ(u.encoded_password(), v.encoded_password());
+            BOOST_TEST_EQ(u.encoded_host(), v.encoded_host());
+            BOOST_TEST_EQ(u.port(), v.port());
+            BOOST_TEST_EQ(u.encoded_query(), v.encoded_query());
+            BOOST_TEST_EQ(u.encoded_fragment(), v.encoded_fragment());
+        }
+    }
+
+    void
+    testEdit()
+    {
+        // a batch of changes
+        // applied to a url
+        {
+            url u("http://user@example.com:80/a/b?q#f");
+            url_builder(u)
+                .set_scheme("https")
+                .remove_port()
+                .set_path("/c")
+                .remove_fragment()
+                .build(u);
+            BOOST_TEST_EQ(u.string(),
+                "https://user@example.com/c?q");
+            check(u);
+        }
+
+        // unchanged
+        for(string_view s : {
+            "",
+            "x:",
+            "//",
+            "//@",
+            "//:@:",
+            "http://u:p@[::1]:8080/a//b/?a=1&b#f",
+            "http://1.2.3.4",
+            "/.//x",
+            "./a:b",
+            "x:a:b",
+            "?#",
+            "mailto:a@b",
+            "//h%41/%42?%43#%44",
+            })
+        {
+            url u(s);
+            url_builder(u).build(u);
+            BOOST_TEST_EQ(u.string(), s);
+            check(u);
+
+            url_view const v(s);
+            BOOST_TEST_EQ(
+                url_builder(v).build().string(), s);
+        }
+
+        // parts moved by the edit
+        {
+            url u("http://example.com/path?query#frag");
+            url_builder(u)
+                .set_user("someone")
+                .set_encoded_path(u.encoded_query())
+                .set_encoded_query(u.encoded_path())
+                .build(u);
+            BOOST_TEST_EQ(u.string(),
+                "http://someone@example.com/query?/path#frag");
+            check(u);
+        }
+        {
+            url u("//h/p");
+            url_builder(u)
+                .remove_authority()
+                .build(u);
+            BOOST_TEST_EQ(u.string(), "/p");
+            check(u);
+        }
+        {
+            url u("//u:p@h");
+            url_builder(u)
+                .remove_password()
+                .build(u);
+            BOOST_TEST_EQ(u.string(), "//u@h");
+            url_builder(u)
+                .remove_userinfo()
+                .build(u);
+            BOOST_TEST_EQ(u.string(), "//h");
+            check(u);
+        }
+        {
+            url u("x:/a");
+            url_builder(u)
+                .set_scheme(scheme::none)
+                .build(u);
+            BOOST_TEST_EQ(u.string(), "/a");
+            url_builder(u)
+                .remove_scheme()
+                .build(u);
+            BOOST_TEST_EQ(u.string(), "/a");
+            check(u);
+        }
+
+        // to empty
+        {
+            url u("http://example.com");
+            url_builder().build(u);
+            BOOST_TEST(u.empty());
+            BOOST_TEST_EQ(u.c_str()[0], '\0');
+            check(u);
+        }
+    }
+
+    void
+    testErrors()
+    {
+        url_builder b;
+        BOOST_TEST_THROWS(b.set_scheme(""), std::exception);
+        BOOST_TEST_THROWS(b.set_scheme("1a"), std::exception);
+        BOOST_TEST_THROWS(b.set_scheme(scheme::unknown),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(b.set_encoded_user("@"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(b.set_encoded_password("%2"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(b.set_encoded_host("[::1"),
+            std::exception);
+        BOOST_TEST_THROWS(b.set_encoded_host("a/b"),
+            std::exception);
+        BOOST_TEST_THROWS(b.set_port("x"), std::exception);
+        BOOST_TEST_THROWS(b.set_encoded_path("?"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(b.set_encoded_path("%zz"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(b.set_encoded_query("#"),
+            std::invalid_argument);
+        BOOST_TEST_THROWS(b.set_encoded_fragment("#"),
+            std::invalid_argument);
+
+        // nothing was set
+        BOOST_TEST_EQ(b.size(), 0u);
+
+        // too big for the container,
+        // which is unchanged
+        static_url<24> u("http://a/b");
+        b.set_scheme("http")
+         .set_host("example.com")
+         .set_path("/docs/index.htm");
+        BOOST_TEST_THROWS(b.build(u),
+            std::exception);
+        BOOST_TEST_EQ(u.string(), "http://a/b");
+        check(u);
+        b.set_path("/");
+        b.build(u);
+        BOOST_TEST_EQ(u.string(), "http://example.com/");
+        check(u);
+    }
+
+    void
+    testJavadocs()
+    {
+        // url_builder
+        {
+        url u = url_builder()
+            .set_scheme( "https" )
+            .set_host( "example.com" )
+            .set_port( 8080 )
+            .set_path( "/docs/index.htm" )
+            .set_query( "page=2" )
+            .build();
+
+        assert( u.string() == "https://example.com:8080/docs/index.htm?page=2" );
+        }
+    }
+
+    void
+    run()
+    {
+        testBuild();
+        testParts();
+        testEdit();
+        testErrors();
+        testJavadocs();
+    }
+};
+
+TEST_SUITE(
+    url_builder_test,
+    "boost.url.url_builder");
+
+} // urls
+} // boost